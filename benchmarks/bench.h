@@ -0,0 +1,193 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BENCH_RESULT_PASS 0
+#define BENCH_RESULT_FAIL 1
+
+// Largest table size benchmarked by default
+#define BENCH_MAX_SIZE 10000000
+
+#define BENCH_PRINT(...)                                                       \
+  do {                                                                         \
+    (void) fprintf(stdout, __VA_ARGS__);                                       \
+    (void) fflush(stdout);                                                     \
+  } while(0)
+
+#define BENCH_REPORT(name, size, operations, elapsed)                          \
+  BENCH_PRINT(                                                                 \
+    "%-36s size=%-10zu %10.2f ns/op\n",                                        \
+    (name),                                                                    \
+    (size_t) (size),                                                           \
+    (elapsed) / (double) (operations)                                          \
+  )
+
+#define BENCH_FAIL(...)                                                        \
+  do {                                                                         \
+    (void) fprintf(stderr, __VA_ARGS__);                                       \
+    return BENCH_RESULT_FAIL;                                                  \
+  } while(0)
+
+// Returns the largest table size to benchmark (first argument, if any)
+#define BENCH_MAX_SIZE_ARG(argc, argv)                                         \
+  ((argc) > 1 ? (size_t) strtoull((argv)[1], NULL, 10) : BENCH_MAX_SIZE)
+
+// Returns a monotonic timestamp in nanoseconds
+static inline double bench_now(void) {
+  struct timespec now;
+  (void) clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double) now.tv_sec * 1e9 + (double) now.tv_nsec;
+}
+
+// Returns the next pseudo-random number (xorshift64*)
+static inline uint64_t bench_random(uint64_t *state) {
+  *state ^= *state >> 12;
+  *state ^= *state << 25;
+  *state ^= *state >> 27;
+  return *state * UINT64_C(0x2545f4914f6cdd1d);
+}
+
+// Zipfian distribution over ranks [0, size)
+struct bench_zipf {
+  size_t size;
+  double *cumulative;
+};
+
+// Prepares a Zipfian distribution with the supplied exponent
+static inline bool bench_zipf_init(struct bench_zipf *zipf, size_t size,
+                                   double exponent) {
+  zipf->size = size;
+  zipf->cumulative = malloc(size * sizeof(double));
+  if (zipf->cumulative == NULL) {
+    return false;
+  }
+  double total = 0;
+  for (size_t rank = 0; rank < size; rank++) {
+    total += 1.0 / pow((double) (rank + 1), exponent);
+    zipf->cumulative[rank] = total;
+  }
+  for (size_t rank = 0; rank < size; rank++) {
+    zipf->cumulative[rank] /= total;
+  }
+  return true;
+}
+
+// Returns the next Zipfian rank (zero is the most frequent one)
+static inline size_t bench_zipf_next(const struct bench_zipf *zipf,
+                                     uint64_t *state) {
+  // Uniform double in [0, 1)
+  const double target = (double) (bench_random(state) >> 11) * 0x1p-53;
+  size_t low = 0;
+  size_t high = zipf->size - 1;
+  while (low < high) {
+    const size_t middle = low + (high - low) / 2;
+    if (zipf->cumulative[middle] < target) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+static inline void bench_zipf_free(struct bench_zipf *zipf) {
+  free(zipf->cumulative);
+  zipf->cumulative = NULL;
+}
+
+// HDR-style latency histogram: values below 2^(BITS + 1) get a bucket each,
+// and every power of two above that is split into 2^BITS buckets, so the
+// relative error of a recorded value is below 2^-BITS
+#define BENCH_HISTOGRAM_BITS 7
+#define BENCH_HISTOGRAM_MAGNITUDES 40
+#define BENCH_HISTOGRAM_BUCKETS                                                \
+  ((2 + BENCH_HISTOGRAM_MAGNITUDES) << BENCH_HISTOGRAM_BITS)
+
+struct bench_histogram {
+  uint64_t count;
+  uint64_t max;
+  uint64_t buckets[BENCH_HISTOGRAM_BUCKETS];
+};
+
+// Returns the bucket of a value
+static inline size_t bench_histogram_bucket(uint64_t value) {
+  const int magnitude = 63 - __builtin_clzll(value | 1) - BENCH_HISTOGRAM_BITS;
+  if (magnitude <= 0) {
+    return (size_t) value;
+  }
+  if (magnitude > BENCH_HISTOGRAM_MAGNITUDES) {
+    return BENCH_HISTOGRAM_BUCKETS - 1;
+  }
+  return ((size_t) (magnitude + 1) << BENCH_HISTOGRAM_BITS)
+       + (size_t) (value >> magnitude) - ((size_t) 1 << BENCH_HISTOGRAM_BITS);
+}
+
+// Returns the highest value that falls in a bucket
+static inline uint64_t bench_histogram_highest(size_t bucket) {
+  const size_t sub_buckets = (size_t) 1 << BENCH_HISTOGRAM_BITS;
+  if (bucket < 2 * sub_buckets) {
+    return bucket;
+  }
+  const int magnitude = (int) (bucket / sub_buckets) - 1;
+  const uint64_t first = (uint64_t) (bucket % sub_buckets + sub_buckets);
+  return ((first + 1) << magnitude) - 1;
+}
+
+static inline void bench_histogram_record(struct bench_histogram *histogram,
+                                          uint64_t value) {
+  histogram->buckets[bench_histogram_bucket(value)]++;
+  histogram->count++;
+  histogram->max = value > histogram->max ? value : histogram->max;
+}
+
+// Adds the values of a histogram to another one
+static inline void bench_histogram_add(struct bench_histogram *histogram,
+                                       const struct bench_histogram *other) {
+  for (size_t bucket = 0; bucket < BENCH_HISTOGRAM_BUCKETS; bucket++) {
+    histogram->buckets[bucket] += other->buckets[bucket];
+  }
+  histogram->count += other->count;
+  histogram->max = other->max > histogram->max ? other->max : histogram->max;
+}
+
+// Returns the value below which the supplied fraction of the values fall
+static inline uint64_t bench_histogram_percentile(
+    const struct bench_histogram *histogram, double fraction) {
+  const double target = ceil(fraction * (double) histogram->count);
+  uint64_t seen = 0;
+  for (size_t bucket = 0; bucket < BENCH_HISTOGRAM_BUCKETS; bucket++) {
+    seen += histogram->buckets[bucket];
+    if (seen > 0 && (double) seen >= target) {
+      const uint64_t highest = bench_histogram_highest(bucket);
+      return highest < histogram->max ? highest : histogram->max;
+    }
+  }
+  return histogram->max;
+}
+
+// Keeps the compiler from optimizing away a benchmarked result
+static volatile uintptr_t bench_sink;
+
+#define BENCH_CONSUME(value)                                                   \
+  (bench_sink += (uintptr_t) (value))
@@ -0,0 +1,128 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <pthread.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <optional.h>
+#include <pet-store.h>
+#include "bench.h"
+
+#define THREADS 16
+
+// Number of pets sold in each run
+#define SALES 4096
+
+// Group commit settings: batch size and latency budget
+struct setting {
+  const char *name;
+  size_t max_batch;
+  long max_latency_ns;
+};
+
+static const struct setting settings[] = {
+  {"buy_pet no group commit", 1, 0},
+  {"buy_pet group commit", 64, 0},
+  {"buy_pet group commit 200us", THREADS, 200000}
+};
+
+struct buyer {
+  pthread_t thread;
+  struct pet *pets;
+  double *latencies;
+  size_t count;
+  size_t sold;
+};
+
+// Buys every pet of the buyer, timing each purchase
+static void *buy_pets(void *argument) {
+  struct buyer *buyer = argument;
+  for (size_t index = 0; index < buyer->count; index++) {
+    const double start = bench_now();
+    buyer->sold += RESULT_IS_SUCCESS(buy_pet(&buyer->pets[index]));
+    buyer->latencies[index] = bench_now() - start;
+  }
+  return NULL;
+}
+
+static int compare_latencies(const void *a, const void *b) {
+  const double x = *(const double *) a;
+  const double y = *(const double *) b;
+  return (x > y) - (x < y);
+}
+
+/**
+ * Benchmarks durable buy_pet with and without group commit (16 threads).
+ */
+int main(int argc, char *argv[]) {
+  const size_t max_size = BENCH_MAX_SIZE_ARG(argc, argv);
+  const size_t size = max_size < SALES ? max_size : SALES;
+  struct pet *pets = malloc(size * sizeof(struct pet));
+  double *latencies = malloc(size * sizeof(double));
+  struct buyer buyers[THREADS];
+  if (pets == NULL || latencies == NULL) {
+    BENCH_FAIL("Out of memory\n");
+  }
+  // The log goes to the current directory, which is expected to be on disk
+  char path[] = "buy-pet-log-XXXXXX";
+  const int descriptor = mkstemp(path);
+  if (descriptor < 0) {
+    BENCH_FAIL("Could not create the log\n");
+  }
+  (void) close(descriptor);
+  for (size_t run = 0; run < sizeof(settings) / sizeof(settings[0]); run++) {
+    for (size_t index = 0; index < size; index++) {
+      pets[index] = (struct pet) {.id = (int) index, .name = "Pet"};
+    }
+    if (truncate(path, 0) != 0
+        || !open_pet_log(path, settings[run].max_batch,
+                         settings[run].max_latency_ns)) {
+      BENCH_FAIL("Could not open the log\n");
+    }
+    const double start = bench_now();
+    for (size_t index = 0; index < THREADS; index++) {
+      const size_t first = index * size / THREADS;
+      buyers[index] = (struct buyer) {
+        .pets = &pets[first],
+        .latencies = &latencies[first],
+        .count = (index + 1) * size / THREADS - first
+      };
+      if (pthread_create(&buyers[index].thread, NULL, buy_pets,
+                         &buyers[index]) != 0) {
+        BENCH_FAIL("Could not start a buyer\n");
+      }
+    }
+    size_t sold = 0;
+    for (size_t index = 0; index < THREADS; index++) {
+      (void) pthread_join(buyers[index].thread, NULL);
+      sold += buyers[index].sold;
+    }
+    const double elapsed = bench_now() - start;
+    close_pet_log();
+    if (sold != size) {
+      BENCH_FAIL("%s did not sell every pet\n", settings[run].name);
+    }
+    qsort(latencies, size, sizeof(double), compare_latencies);
+    BENCH_REPORT(settings[run].name, size, size, elapsed);
+    BENCH_PRINT("  latency p50=%.0f ns p99=%.0f ns\n", latencies[size / 2],
+                latencies[size * 99 / 100]);
+  }
+  (void) remove(path);
+  free(pets);
+  free(latencies);
+  return BENCH_RESULT_PASS;
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <pthread.h>
+#include <optional.h>
+#include <pet-store.h>
+#include "bench.h"
+
+#define MAX_THREADS 64
+
+// Number of purchases attempted by each thread (most of them on pets that
+// have already been sold, so that buyers keep contending)
+#define ATTEMPTS 1000000
+
+// Serializes purchases (the alternative to compare-and-swap)
+static pthread_mutex_t store_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static RESULT(Pet, pet_error) buy_pet_locked(Pet pet) {
+  (void) pthread_mutex_lock(&store_lock);
+  RESULT(Pet, pet_error) bought = RESULT_FAILURE(PET_ALREADY_SOLD);
+  if (PET_STATUS(pet) == AVAILABLE) {
+    PET_STATUS(pet) = SOLD;
+    bought = (RESULT(Pet, pet_error)) RESULT_SUCCESS(pet);
+  }
+  (void) pthread_mutex_unlock(&store_lock);
+  return bought;
+}
+
+struct buyer {
+  pthread_t thread;
+  RESULT(Pet, pet_error) (*buy)(Pet pet);
+  struct pet *pets;
+  size_t size;
+  size_t first;
+  size_t sold;
+};
+
+// Tries to buy pets round-robin, starting at a different one for each buyer
+static void *buy_pets(void *argument) {
+  struct buyer *buyer = argument;
+  for (size_t attempt = 0; attempt < ATTEMPTS; attempt++) {
+    Pet pet = &buyer->pets[(buyer->first + attempt) % buyer->size];
+    if (RESULT_IS_SUCCESS(buyer->buy(pet))) {
+      buyer->sold++;
+    }
+  }
+  return NULL;
+}
+
+// Runs the supplied number of buyers concurrently; returns the elapsed time
+static double run_buyers(struct buyer *buyers, size_t threads,
+                         RESULT(Pet, pet_error) (*buy)(Pet pet),
+                         struct pet *pets,
+                         size_t size) {
+  for (size_t index = 0; index < size; index++) {
+    PET_STATUS(&pets[index]) = AVAILABLE;
+  }
+  const double start = bench_now();
+  for (size_t index = 0; index < threads; index++) {
+    buyers[index] = (struct buyer) {
+      .buy = buy,
+      .pets = pets,
+      .size = size,
+      .first = index * size / threads
+    };
+    if (pthread_create(&buyers[index].thread, NULL, buy_pets,
+                       &buyers[index]) != 0) {
+      return -1;
+    }
+  }
+  size_t sold = 0;
+  for (size_t index = 0; index < threads; index++) {
+    (void) pthread_join(buyers[index].thread, NULL);
+    sold += buyers[index].sold;
+  }
+  const double elapsed = bench_now() - start;
+  // Every pet must be sold exactly once
+  return sold == size ? elapsed : -1;
+}
+
+/**
+ * Benchmarks buy_pet (compare-and-swap) vs. a global lock at 1-64 threads.
+ */
+int main(int argc, char *argv[]) {
+  const size_t max_size = BENCH_MAX_SIZE_ARG(argc, argv);
+  const size_t size = max_size < 1000 ? max_size : 1000;
+  struct pet *pets = malloc(size * sizeof(struct pet));
+  struct buyer *buyers = malloc(MAX_THREADS * sizeof(struct buyer));
+  if (pets == NULL || buyers == NULL) {
+    BENCH_FAIL("Out of memory\n");
+  }
+  for (size_t index = 0; index < size; index++) {
+    pets[index] = (struct pet) {.id = (int) index, .name = "Pet"};
+  }
+  for (size_t threads = 1; threads <= MAX_THREADS; threads *= 2) {
+    char name[64];
+    double elapsed = run_buyers(buyers, threads, buy_pet, pets, size);
+    if (elapsed < 0) {
+      BENCH_FAIL("buy_pet did not sell every pet exactly once\n");
+    }
+    (void) snprintf(name, sizeof(name), "buy_pet threads=%zu", threads);
+    BENCH_REPORT(name, size, threads * ATTEMPTS, elapsed);
+    elapsed = run_buyers(buyers, threads, buy_pet_locked, pets, size);
+    if (elapsed < 0) {
+      BENCH_FAIL("buy_pet_locked did not sell every pet exactly once\n");
+    }
+    (void) snprintf(name, sizeof(name), "buy_pet_locked threads=%zu", threads);
+    BENCH_REPORT(name, size, threads * ATTEMPTS, elapsed);
+  }
+  free(pets);
+  free(buyers);
+  return BENCH_RESULT_PASS;
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <string.h>
+#include <optional.h>
+#include <name-index.h>
+#include "bench.h"
+
+#define PETS 1000000
+#define LOOKUPS 1000000
+
+// Number of lookups done by scanning (each of them reads every name)
+#define SCANS 100
+
+// Longest generated name (some of them are longer than the indexed prefix)
+#define NAME_SIZE 24
+
+// Writes a random name of 5 to NAME_SIZE - 1 letters
+static void random_name(char *name, uint64_t *seed) {
+  const size_t length = 5 + bench_random(seed) % (NAME_SIZE - 5);
+  for (size_t index = 0; index < length; index++) {
+    name[index] = (char) ('a' + bench_random(seed) % 26);
+  }
+  name[length] = '\0';
+}
+
+// Returns a pet by name, comparing every name with strcmp
+static OPTIONAL(Pet) scan_by_name(const struct pet *pets, size_t count,
+                                  const char *name) {
+  for (size_t index = 0; index < count; index++) {
+    if (strcmp(pets[index].name, name) == 0) {
+      return (OPTIONAL(Pet)) OPTIONAL_PRESENT((Pet) &pets[index]);
+    }
+  }
+  return (OPTIONAL(Pet)) OPTIONAL_EMPTY;
+}
+
+/**
+ * Benchmarks find_pet_by_name (name index) vs. a strcmp scan on 1M names.
+ */
+int main(int argc, char *argv[]) {
+  const size_t max_size = BENCH_MAX_SIZE_ARG(argc, argv);
+  const size_t size = max_size < PETS ? max_size : PETS;
+  struct pet *pets = malloc(size * sizeof(struct pet));
+  char (*names)[NAME_SIZE] = malloc(size * NAME_SIZE);
+  char (*queries)[NAME_SIZE] = malloc(LOOKUPS * NAME_SIZE);
+  if (pets == NULL || names == NULL || queries == NULL) {
+    BENCH_FAIL("Out of memory\n");
+  }
+  uint64_t seed = 0x9e3779b97f4a7c15;
+  for (size_t index = 0; index < size; index++) {
+    random_name(names[index], &seed);
+    pets[index] = (struct pet) {.id = 1000 + (int) index, .name = names[index]};
+    if (OPTIONAL_IS_EMPTY(add_pet(&pets[index]))) {
+      BENCH_FAIL("Could not add pet %zu\n", index);
+    }
+  }
+  // Half of the lookups are misses
+  for (size_t index = 0; index < LOOKUPS; index++) {
+    if (index & 1) {
+      random_name(queries[index], &seed);
+    } else {
+      strcpy(queries[index], names[bench_random(&seed) % size]);
+    }
+  }
+  // Build the index before timing
+  BENCH_CONSUME(OPTIONAL_IS_PRESENT(find_pet_by_name(names[0])));
+  size_t indexed = 0;
+  double start = bench_now();
+  for (size_t index = 0; index < LOOKUPS; index++) {
+    indexed += OPTIONAL_IS_PRESENT(find_pet_by_name(queries[index]));
+  }
+  BENCH_REPORT("find_pet_by_name", size, LOOKUPS, bench_now() - start);
+  size_t scanned = 0;
+  start = bench_now();
+  for (size_t index = 0; index < SCANS; index++) {
+    scanned += OPTIONAL_IS_PRESENT(scan_by_name(pets, size, queries[index]));
+  }
+  BENCH_REPORT("strcmp scan", size, SCANS, bench_now() - start);
+  for (size_t index = 0; index < SCANS; index++) {
+    scanned -= OPTIONAL_IS_PRESENT(find_pet_by_name(queries[index]));
+  }
+  if (scanned != 0) {
+    BENCH_FAIL("The scan and the index found different pets\n");
+  }
+  BENCH_CONSUME(indexed);
+  free(pets);
+  free(names);
+  free(queries);
+  return BENCH_RESULT_PASS;
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <optional.h>
+#include <pet-store.h>
+#include "bench.h"
+
+#define LOOKUPS 1000000
+
+// Number of ids resolved per request
+#define REQUEST_SIZE 256
+
+// Ids of added pets are even and don't clash with the static catalogue
+#define PET_ID_AT(index) (1000 + (int) (index) * 2)
+
+/**
+ * Benchmarks batched lookups (find_pets) vs. one find_pet call per id.
+ */
+int main(int argc, char *argv[]) {
+  const size_t max_size = BENCH_MAX_SIZE_ARG(argc, argv);
+  struct pet *pets = malloc(max_size * sizeof(struct pet));
+  int *ids = malloc(LOOKUPS * sizeof(int));
+  OPTIONAL(Pet) *found = malloc(LOOKUPS * sizeof(OPTIONAL(Pet)));
+  if (pets == NULL || ids == NULL || found == NULL) {
+    BENCH_FAIL("Out of memory\n");
+  }
+  size_t added = 0;
+  for (size_t size = 10; size <= max_size; size *= 10) {
+    uint64_t seed = 0x9e3779b97f4a7c15;
+    for (; added < size; added++) {
+      pets[added] = (struct pet) {.id = PET_ID_AT(added), .name = "Pet"};
+      if (OPTIONAL_IS_EMPTY(add_pet(&pets[added]))) {
+        BENCH_FAIL("Could not add pet %zu\n", added);
+      }
+    }
+    // Half of the lookups are misses
+    for (size_t index = 0; index < LOOKUPS; index++) {
+      ids[index] = PET_ID_AT(bench_random(&seed) % size) + (int) (index & 1);
+    }
+    double start = bench_now();
+    for (size_t index = 0; index < LOOKUPS; index++) {
+      const RESULT(Pet, pet_error) pet = find_pet(ids[index]);
+      found[index] = RESULT_TO_OPTIONAL(pet, OPTIONAL(Pet));
+    }
+    BENCH_REPORT("find_pet", size, LOOKUPS, bench_now() - start);
+    start = bench_now();
+    for (size_t index = 0; index < LOOKUPS; index += REQUEST_SIZE) {
+      const size_t count = LOOKUPS - index < REQUEST_SIZE
+                         ? LOOKUPS - index : REQUEST_SIZE;
+      find_pets(&ids[index], count, &found[index]);
+    }
+    BENCH_REPORT("find_pets", size, LOOKUPS, bench_now() - start);
+    for (size_t index = 0; index < LOOKUPS; index++) {
+      BENCH_CONSUME(OPTIONAL_IS_PRESENT(found[index]));
+    }
+  }
+  free(pets);
+  free(ids);
+  free(found);
+  return BENCH_RESULT_PASS;
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <limits.h>
+#include <optional.h>
+#include <pet-index.h>
+#include <status-bitmap.h>
+#include "bench.h"
+
+// Smallest number of pets benchmarked
+#define MIN_SIZE 1000000
+
+struct query {
+  const char *name;
+  const char *scan_name;
+  unsigned any_of;
+};
+
+/**
+ * Benchmarks find_pets_by_status vs. scanning every pet and checking its
+ * status, on a selective query (1% of the pets) and a non-selective one (99%).
+ */
+int main(int argc, char *argv[]) {
+  const size_t max_size = BENCH_MAX_SIZE_ARG(argc, argv);
+  const struct query queries[] = {
+    {"find_pets_by_status 1%", "scan by status 1%",
+     PET_STATUS_MASK(AVAILABLE)},
+    {"find_pets_by_status 99%", "scan by status 99%",
+     PET_STATUS_MASK(PENDING) | PET_STATUS_MASK(SOLD)}
+  };
+  struct pet *pets = malloc(max_size * sizeof(struct pet));
+  if (pets == NULL) {
+    BENCH_FAIL("Out of memory\n");
+  }
+  uint64_t seed = 0x9e3779b97f4a7c15;
+  size_t added = 0;
+  for (size_t size = MIN_SIZE; size <= max_size; size *= 4) {
+    for (; added < size; added++) {
+      // 1% available, 9% pending, 90% sold
+      const uint64_t percent = bench_random(&seed) % 100;
+      pets[added] = (struct pet) {
+        .id = 1000 + (int) added,
+        .name = "Pet",
+        .status = percent < 1 ? AVAILABLE : percent < 10 ? PENDING : SOLD
+      };
+      if (OPTIONAL_IS_EMPTY(add_pet(&pets[added]))) {
+        BENCH_FAIL("Could not add pet %zu\n", added);
+      }
+    }
+    // Build both indexes before timing
+    struct pet_range range = find_pets_in_range(INT_MIN, INT_MAX);
+    struct status_bitmap_iterator iterator = find_pets_by_status(0, 0);
+    BENCH_CONSUME(OPTIONAL_IS_PRESENT(pet_range_next(&range)));
+    BENCH_CONSUME(OPTIONAL_IS_PRESENT(status_bitmap_next(&iterator)));
+    for (size_t index = 0; index < sizeof(queries) / sizeof(queries[0]);
+         index++) {
+      const unsigned any_of = queries[index].any_of;
+      size_t found = 0;
+      double start = bench_now();
+      iterator = find_pets_by_status(any_of, 0);
+      for (OPTIONAL(Pet) pet = status_bitmap_next(&iterator);
+           OPTIONAL_IS_PRESENT(pet); pet = status_bitmap_next(&iterator)) {
+        found++;
+      }
+      BENCH_REPORT(queries[index].name, size, size, bench_now() - start);
+      size_t scanned = 0;
+      start = bench_now();
+      range = find_pets_in_range(INT_MIN, INT_MAX);
+      for (OPTIONAL(Pet) pet = pet_range_next(&range);
+           OPTIONAL_IS_PRESENT(pet); pet = pet_range_next(&range)) {
+        scanned += (any_of & PET_STATUS_MASK(
+          PET_STATUS(OPTIONAL_USE_VALUE(pet)))) != 0;
+      }
+      BENCH_REPORT(queries[index].scan_name, size, size, bench_now() - start);
+      if (found != scanned) {
+        BENCH_FAIL("Found %zu pets instead of %zu\n", found, scanned);
+      }
+    }
+  }
+  free(pets);
+  return BENCH_RESULT_PASS;
+}
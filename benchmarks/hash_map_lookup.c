@@ -0,0 +1,101 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <optional.h>
+#include <pet-store.h>
+#include <hash-map.h>
+#include "bench.h"
+
+#define LOOKUPS 1000000
+
+// Linear scans are only measured up to this size
+#define MAX_SCAN_SIZE 100000
+
+HASH_MAP(pet_map, int, Pet, hash_map_hash_int, hash_map_equals_int)
+
+// Pet ids are even, so odd ids are guaranteed misses
+#define PET_ID_AT(index) ((int) (index) * 2)
+
+// Returns a pet by id, the way find_pet used to
+static OPTIONAL(Pet) scan_pets(struct pet *pets, size_t size, int pet_id) {
+  for (size_t index = 0; index < size; index++) {
+    if (PET_ID(&pets[index]) == pet_id) {
+      return (OPTIONAL(Pet)) OPTIONAL_PRESENT(&pets[index]);
+    }
+  }
+  return (OPTIONAL(Pet)) OPTIONAL_EMPTY;
+}
+
+// Generates lookup ids; `hit_percent` of them belong to existing pets
+static void generate_ids(int *ids, size_t count, size_t size, int hit_percent) {
+  uint64_t seed = 0x9e3779b97f4a7c15;
+  for (size_t index = 0; index < count; index++) {
+    int id = PET_ID_AT(bench_random(&seed) % size);
+    ids[index] = (int) (bench_random(&seed) % 100) < hit_percent ? id : id + 1;
+  }
+}
+
+/**
+ * Benchmarks pet lookups by id: hash map vs. linear scan.
+ */
+int main(int argc, char *argv[]) {
+  const size_t max_size = BENCH_MAX_SIZE_ARG(argc, argv);
+  const struct {const char *name; int hit_percent;} mixes[] = {
+    {"hit-heavy", 90},
+    {"miss-heavy", 10}
+  };
+  struct pet *pets = malloc(max_size * sizeof(struct pet));
+  int *ids = malloc(LOOKUPS * sizeof(int));
+  if (pets == NULL || ids == NULL) {
+    BENCH_FAIL("Out of memory\n");
+  }
+  for (size_t size = 10; size <= max_size; size *= 10) {
+    struct pet_map map;
+    if (!pet_map_init(&map, size)) {
+      BENCH_FAIL("Out of memory\n");
+    }
+    for (size_t index = 0; index < size; index++) {
+      pets[index] = (struct pet) {.id = PET_ID_AT(index), .name = "Pet"};
+      (void) pet_map_put(&map, PET_ID(&pets[index]), &pets[index]);
+    }
+    for (size_t mix = 0; mix < sizeof(mixes) / sizeof(mixes[0]); mix++) {
+      char name[64];
+      generate_ids(ids, LOOKUPS, size, mixes[mix].hit_percent);
+      double start = bench_now();
+      for (size_t index = 0; index < LOOKUPS; index++) {
+        OPTIONAL(Pet) pet = pet_map_get(&map, ids[index]);
+        BENCH_CONSUME(OPTIONAL_IS_PRESENT(pet));
+      }
+      (void) snprintf(name, sizeof(name), "hash_map/%s", mixes[mix].name);
+      BENCH_REPORT(name, size, LOOKUPS, bench_now() - start);
+      if (size <= MAX_SCAN_SIZE) {
+        const size_t lookups = LOOKUPS / size * 10;
+        start = bench_now();
+        for (size_t index = 0; index < lookups; index++) {
+          OPTIONAL(Pet) pet = scan_pets(pets, size, ids[index]);
+          BENCH_CONSUME(OPTIONAL_IS_PRESENT(pet));
+        }
+        (void) snprintf(name, sizeof(name), "linear_scan/%s", mixes[mix].name);
+        BENCH_REPORT(name, size, lookups, bench_now() - start);
+      }
+    }
+    pet_map_free(&map);
+  }
+  free(pets);
+  free(ids);
+  return BENCH_RESULT_PASS;
+}
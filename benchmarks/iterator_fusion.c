@@ -0,0 +1,96 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <optional.h>
+#include <iterator.h>
+#include "bench.h"
+
+// Number of values that survive the filter and get summed
+#define TAKEN(size) ((size) / 4)
+
+OPTIONAL_STRUCT(int);
+OPTIONAL_STRUCT(uint64_t);
+
+#define scramble(value) ((uint64_t) (unsigned int) (value) * 0x9e3779b1U)
+#define is_odd(value) (((value) & 1) != 0)
+#define low_bits(value) ((value) & 0xffff)
+
+ITERATOR_OPTIONAL_ARRAY(column, int)
+ITERATOR_MAP(scrambled, column, int, uint64_t, scramble)
+ITERATOR_FILTER(odd, scrambled, uint64_t, is_odd)
+ITERATOR_MAP(truncated, odd, uint64_t, uint64_t, low_bits)
+ITERATOR_TAKE(taken, truncated, uint64_t)
+
+/**
+ * Benchmarks a fused iterator chain vs. materializing every stage.
+ */
+int main(int argc, char *argv[]) {
+  const size_t size = BENCH_MAX_SIZE_ARG(argc, argv);
+  OPTIONAL(int) *values = malloc(size * sizeof(OPTIONAL(int)));
+  uint64_t *stage1 = malloc(size * sizeof(uint64_t));
+  uint64_t *stage2 = malloc(size * sizeof(uint64_t));
+  if (values == NULL || stage1 == NULL || stage2 == NULL) {
+    BENCH_FAIL("Out of memory\n");
+  }
+  uint64_t seed = 0x9e3779b97f4a7c15;
+  for (size_t index = 0; index < size; index++) {
+    const uint64_t random = bench_random(&seed);
+    values[index] = random % 8 == 0
+                  ? (OPTIONAL(int)) OPTIONAL_EMPTY
+                  : (OPTIONAL(int)) OPTIONAL_PRESENT((int) (random >> 32));
+  }
+  uint64_t fused = 0;
+  double start = bench_now();
+  struct taken iterator = taken_of(
+    truncated_of(odd_of(scrambled_of(column_of(values, size)))), TAKEN(size));
+  for (OPTIONAL(uint64_t) value = taken_next(&iterator);
+       OPTIONAL_IS_PRESENT(value); value = taken_next(&iterator)) {
+    fused += OPTIONAL_USE_VALUE(value);
+  }
+  BENCH_REPORT("fused iterator chain", size, size, bench_now() - start);
+  uint64_t staged = 0;
+  start = bench_now();
+  size_t count = 0;
+  for (size_t index = 0; index < size; index++) {
+    if (OPTIONAL_IS_PRESENT(values[index])) {
+      stage1[count++] = scramble(OPTIONAL_USE_VALUE(values[index]));
+    }
+  }
+  size_t kept = 0;
+  for (size_t index = 0; index < count; index++) {
+    if (is_odd(stage1[index])) {
+      stage2[kept++] = stage1[index];
+    }
+  }
+  for (size_t index = 0; index < kept; index++) {
+    stage2[index] = low_bits(stage2[index]);
+  }
+  for (size_t index = 0; index < kept && index < TAKEN(size); index++) {
+    staged += stage2[index];
+  }
+  BENCH_REPORT("materialized stages", size, size, bench_now() - start);
+  if (fused != staged) {
+    BENCH_FAIL("The pipelines disagree\n");
+  }
+  free(values);
+  free(stage1);
+  free(stage2);
+  return BENCH_RESULT_PASS;
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <optional.h>
+#include <optional-arrow.h>
+#include "bench.h"
+
+// Elements converted per measurement (small columns are converted repeatedly)
+#define ELEMENTS 4000000
+
+OPTIONAL_STRUCT(int32_t);
+OPTIONAL_STRUCT(double);
+
+OPTIONAL_ARROW_COLUMN(int_column, int32_t, "i")
+OPTIONAL_ARROW_COLUMN(double_column, double, "g")
+
+// Builds the validity bitmap and the value buffer one element at a time
+#define COPY_ONE_BY_ONE(optionals, count, validity, values)                   \
+  do {                                                                        \
+    memset((validity), 0, ((count) + 7) / 8);                                 \
+    for (size_t index = 0; index < (count); index++) {                        \
+      if (OPTIONAL_IS_PRESENT((optionals)[index])) {                          \
+        (values)[index] = OPTIONAL_USE_VALUE((optionals)[index]);             \
+        (validity)[index / 8] |= (uint8_t) (1U << (index % 8));               \
+      } else {                                                                \
+        (values)[index] = 0;                                                  \
+      }                                                                       \
+    }                                                                         \
+  } while(false)
+
+/**
+ * Benchmarks turning interleaved optionals into Arrow buffers one element at
+ * a time vs. with SIMD, and the (zero-copy) export and import of a column.
+ */
+int main(int argc, char *argv[]) {
+  const size_t max_size = BENCH_MAX_SIZE_ARG(argc, argv);
+  const size_t elements = max_size < ELEMENTS ? max_size : ELEMENTS;
+  OPTIONAL(int32_t) *ints = malloc(elements * sizeof(*ints));
+  OPTIONAL(double) *doubles = malloc(elements * sizeof(*doubles));
+  uint8_t *validity = malloc(elements / 8 + 1);
+  int32_t *int_values = malloc(elements * sizeof(*int_values));
+  double *double_values = malloc(elements * sizeof(*double_values));
+  if (ints == NULL || doubles == NULL || validity == NULL
+      || int_values == NULL || double_values == NULL) {
+    BENCH_FAIL("Out of memory\n");
+  }
+  // One in ten elements is empty
+  uint64_t seed = 0x9e3779b97f4a7c15;
+  for (size_t index = 0; index < elements; index++) {
+    const uint64_t random = bench_random(&seed);
+    const bool empty = random % 10 == 0;
+    ints[index] = empty ? (OPTIONAL(int32_t)) OPTIONAL_EMPTY
+                        : (OPTIONAL(int32_t)) OPTIONAL_PRESENT(
+                            (int32_t) (random >> 32));
+    doubles[index] = empty ? (OPTIONAL(double)) OPTIONAL_EMPTY
+                           : (OPTIONAL(double)) OPTIONAL_PRESENT(
+                               (double) (random >> 11));
+  }
+  // Touch every page before measuring
+  memset(validity, 0, elements / 8 + 1);
+  memset(int_values, 0, elements * sizeof(*int_values));
+  memset(double_values, 0, elements * sizeof(*double_values));
+  for (size_t size = 1000; size <= elements; size *= 10) {
+    const size_t rounds = elements / size;
+    double start = bench_now();
+    for (size_t round = 0; round < rounds; round++) {
+      COPY_ONE_BY_ONE(ints, size, validity, int_values);
+      BENCH_CONSUME(int_values[round % size]);
+    }
+    BENCH_REPORT("int32 one by one", size, rounds * size, bench_now() - start);
+    struct int_column int_column = {.values = NULL};
+    double elapsed = 0;
+    for (size_t round = 0; round < rounds; round++) {
+      int_column_free(&int_column);
+      start = bench_now();
+      if (!int_column_from_optionals(&int_column, ints, size)) {
+        BENCH_FAIL("Out of memory\n");
+      }
+      elapsed += bench_now() - start;
+    }
+    BENCH_REPORT("int32 from_optionals", size, rounds * size, elapsed);
+    if (memcmp(int_column.values, int_values, size * sizeof(int32_t)) != 0
+        || memcmp(int_column.validity, validity, (size + 7) / 8) != 0) {
+      BENCH_FAIL("The int32 buffers disagree\n");
+    }
+    start = bench_now();
+    for (size_t round = 0; round < rounds; round++) {
+      COPY_ONE_BY_ONE(doubles, size, validity, double_values);
+      BENCH_CONSUME(double_values[round % size]);
+    }
+    BENCH_REPORT("double one by one", size, rounds * size, bench_now() - start);
+    struct double_column double_column = {.values = NULL};
+    elapsed = 0;
+    for (size_t round = 0; round < rounds; round++) {
+      double_column_free(&double_column);
+      start = bench_now();
+      if (!double_column_from_optionals(&double_column, doubles, size)) {
+        BENCH_FAIL("Out of memory\n");
+      }
+      elapsed += bench_now() - start;
+    }
+    BENCH_REPORT("double from_optionals", size, rounds * size, elapsed);
+    if (memcmp(double_column.values, double_values, size * sizeof(double)) != 0
+        || memcmp(double_column.validity, validity, (size + 7) / 8) != 0) {
+      BENCH_FAIL("The double buffers disagree\n");
+    }
+    struct ArrowArray array;
+    struct ArrowSchema schema;
+    start = bench_now();
+    if (!double_column_export(&double_column, &array, &schema)
+        || !double_column_import(&double_column, &array, &schema)) {
+      BENCH_FAIL("Could not export and import the double column\n");
+    }
+    BENCH_REPORT("double export + import", size, 1, bench_now() - start);
+    schema.release(&schema);
+    int_column_free(&int_column);
+    double_column_free(&double_column);
+  }
+  free(ints);
+  free(doubles);
+  free(validity);
+  free(int_values);
+  free(double_values);
+  return BENCH_RESULT_PASS;
+}
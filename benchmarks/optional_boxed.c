@@ -0,0 +1,177 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <optional.h>
+#include <optional-boxed.h>
+#include "bench.h"
+
+// Slots in the sparse table
+#define SLOTS 100000
+
+// One out of this many slots is present
+#define SPARSENESS 10
+
+// Allocations and releases per run
+#define OPERATIONS 1000000
+
+typedef struct record {
+  int id;
+  char payload[4092];
+} record;
+
+OPTIONAL_STRUCT(record);
+OPTIONAL_BOXED_STRUCT(record);
+
+typedef struct small {
+  long fields[8];
+} small;
+
+OPTIONAL_STRUCT(small);
+OPTIONAL_BOXED_STRUCT(small);
+
+// Fills or empties random slots of a table of the supplied kind, where:
+// inline: OPTIONAL(type), boxed: OPTIONAL_BOXED(type) from a pool, malloc:
+// OPTIONAL_BOXED(type) from malloc
+#define CHURN(kind, type, slots, table, pool, operations, elapsed)            \
+  do {                                                                        \
+    uint64_t seed = 0x9e3779b97f4a7c15;                                       \
+    type value;                                                               \
+    memset(&value, 0, sizeof(value));                                         \
+    const double start = bench_now();                                         \
+    for (size_t operation = 0; operation < (operations); operation++) {       \
+      const size_t slot = bench_random(&seed) % (slots);                      \
+      CHURN_##kind(type, (table)[slot], pool, value);                         \
+    }                                                                         \
+    (elapsed) = bench_now() - start;                                          \
+  } while (0)
+
+#define CHURN_inline(type, optional, pool, value)                             \
+  (optional) = OPTIONAL_IS_PRESENT(optional)                                  \
+             ? (OPTIONAL(type)) OPTIONAL_EMPTY                                \
+             : (OPTIONAL(type)) OPTIONAL_PRESENT(value)
+
+#define CHURN_boxed(type, optional, pool, value)                              \
+  if (OPTIONAL_IS_PRESENT(optional)) {                                        \
+    OPTIONAL_BOXED_RELEASE(pool, optional);                                   \
+  } else {                                                                    \
+    type *box = box_pool_copy(pool, &value, sizeof(value));                   \
+    (optional) = (OPTIONAL_BOXED(type)) OPTIONAL_OF_NULLABLE(box);            \
+  }
+
+#define CHURN_malloc(type, optional, pool, value)                             \
+  if (OPTIONAL_IS_PRESENT(optional)) {                                        \
+    free(OPTIONAL_USE_VALUE(optional));                                       \
+    (optional) = (OPTIONAL_BOXED(type)) OPTIONAL_EMPTY;                       \
+  } else {                                                                    \
+    type *box = malloc(sizeof(value));                                        \
+    if (box != NULL) {                                                        \
+      memcpy(box, &value, sizeof(value));                                     \
+    }                                                                         \
+    (optional) = (OPTIONAL_BOXED(type)) OPTIONAL_OF_NULLABLE(box);            \
+  }
+
+/**
+ * Benchmarks the memory footprint of a sparse table of 4 KB optionals, and
+ * the allocation throughput of boxed optionals vs. inline optionals and
+ * malloc, for 4 KB and 64-byte values.
+ */
+int main(int argc, char *argv[]) {
+  const size_t max_size = BENCH_MAX_SIZE_ARG(argc, argv);
+  const size_t slots = max_size < SLOTS ? max_size : SLOTS;
+  const size_t operations = max_size < OPERATIONS ? max_size : OPERATIONS;
+  OPTIONAL_BOXED(record) *boxed = malloc(slots * sizeof(*boxed));
+  OPTIONAL_BOXED(record) *mallocked = malloc(slots * sizeof(*mallocked));
+  OPTIONAL(record) *inlined = malloc(slots * sizeof(*inlined));
+  struct box_pool pool;
+  if (boxed == NULL || mallocked == NULL || inlined == NULL
+      || !box_pool_init(&pool)) {
+    BENCH_FAIL("Out of memory\n");
+  }
+  // Footprint of a table where one out of SPARSENESS slots is present
+  const record value = {.id = 1};
+  size_t present = 0;
+  for (size_t slot = 0; slot < slots; slot++) {
+    boxed[slot] = (OPTIONAL_BOXED(record)) OPTIONAL_EMPTY;
+    if (slot % SPARSENESS == 0) {
+      record *box = box_pool_copy(&pool, &value, sizeof(value));
+      boxed[slot] = (OPTIONAL_BOXED(record)) OPTIONAL_OF_NULLABLE(box);
+      present += OPTIONAL_IS_PRESENT(boxed[slot]);
+    }
+  }
+  BENCH_PRINT("%-36s size=%-10zu %10.2f MB\n", "footprint inline", slots,
+              (double) (slots * sizeof(OPTIONAL(record))) / 1e6);
+  BENCH_PRINT("%-36s size=%-10zu %10.2f MB\n", "footprint boxed", slots,
+              (double) (slots * sizeof(OPTIONAL_BOXED(record))
+                        + pool.reserved) / 1e6);
+  BENCH_PRINT("%-36s size=%-10zu %10.2f MB (+ malloc overhead)\n",
+              "footprint malloc", slots,
+              (double) (slots * sizeof(OPTIONAL_BOXED(record))
+                        + present * sizeof(record)) / 1e6);
+  box_pool_free(&pool);
+  // Throughput of filling and emptying random slots
+  double elapsed;
+  for (size_t slot = 0; slot < slots; slot++) {
+    boxed[slot] = (OPTIONAL_BOXED(record)) OPTIONAL_EMPTY;
+    mallocked[slot] = (OPTIONAL_BOXED(record)) OPTIONAL_EMPTY;
+    inlined[slot] = (OPTIONAL(record)) OPTIONAL_EMPTY;
+  }
+  if (!box_pool_init(&pool)) {
+    BENCH_FAIL("Out of memory\n");
+  }
+  CHURN(inline, record, slots, inlined, &pool, operations, elapsed);
+  BENCH_REPORT("churn 4 KB inline", slots, operations, elapsed);
+  CHURN(boxed, record, slots, boxed, &pool, operations, elapsed);
+  BENCH_REPORT("churn 4 KB box_pool", slots, operations, elapsed);
+  CHURN(malloc, record, slots, mallocked, &pool, operations, elapsed);
+  BENCH_REPORT("churn 4 KB malloc", slots, operations, elapsed);
+  for (size_t slot = 0; slot < slots; slot++) {
+    OPTIONAL_IF_PRESENT(mallocked[slot], free);
+  }
+  box_pool_free(&pool);
+  OPTIONAL_BOXED(small) *small_boxed = malloc(slots * sizeof(*small_boxed));
+  OPTIONAL_BOXED(small) *small_mallocked = malloc(slots
+                                                  * sizeof(*small_mallocked));
+  OPTIONAL(small) *small_inlined = malloc(slots * sizeof(*small_inlined));
+  if (small_boxed == NULL || small_mallocked == NULL || small_inlined == NULL
+      || !box_pool_init(&pool)) {
+    BENCH_FAIL("Out of memory\n");
+  }
+  for (size_t slot = 0; slot < slots; slot++) {
+    small_boxed[slot] = (OPTIONAL_BOXED(small)) OPTIONAL_EMPTY;
+    small_mallocked[slot] = (OPTIONAL_BOXED(small)) OPTIONAL_EMPTY;
+    small_inlined[slot] = (OPTIONAL(small)) OPTIONAL_EMPTY;
+  }
+  CHURN(inline, small, slots, small_inlined, &pool, operations, elapsed);
+  BENCH_REPORT("churn 64 B inline", slots, operations, elapsed);
+  CHURN(boxed, small, slots, small_boxed, &pool, operations, elapsed);
+  BENCH_REPORT("churn 64 B box_pool", slots, operations, elapsed);
+  CHURN(malloc, small, slots, small_mallocked, &pool, operations, elapsed);
+  BENCH_REPORT("churn 64 B malloc", slots, operations, elapsed);
+  for (size_t slot = 0; slot < slots; slot++) {
+    OPTIONAL_IF_PRESENT(small_mallocked[slot], free);
+  }
+  box_pool_free(&pool);
+  free(boxed);
+  free(mallocked);
+  free(inlined);
+  free(small_boxed);
+  free(small_mallocked);
+  free(small_inlined);
+  return BENCH_RESULT_PASS;
+}
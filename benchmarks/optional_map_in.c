@@ -0,0 +1,202 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <optional.h>
+#include <arena.h>
+#include <optional-parse.h>
+#include <strview.h>
+#include "bench.h"
+
+#define REQUESTS 1000000
+
+// Orders above this total are rejected
+#define LIMIT_CENTS 50000
+
+struct order {
+  int id;
+  char *name;
+  int cents;
+};
+
+struct quote {
+  const struct order *order;
+  int total_cents;
+  char *label;
+};
+
+struct receipt {
+  const struct quote *quote;
+  char *text;
+};
+
+typedef struct order *order_pointer;
+typedef struct quote *quote_pointer;
+typedef struct receipt *receipt_pointer;
+
+OPTIONAL_STRUCT(order_pointer);
+OPTIONAL_STRUCT(quote_pointer);
+OPTIONAL_STRUCT(receipt_pointer);
+
+// Allocates from the arena or, if there is none, from malloc
+static void *allocate(struct arena *arena, size_t size) {
+  return arena != NULL ? arena_alloc(arena, size) : malloc(size);
+}
+
+static char *copy_view(struct arena *arena, strview view) {
+  char *copy = allocate(arena, view.length + 1);
+  if (copy != NULL) {
+    memcpy(copy, view.data, view.length);
+    copy[view.length] = '\0';
+  }
+  return copy;
+}
+
+// Parses "id,name,cents" into a new order
+static OPTIONAL(order_pointer) parse_order_in(struct arena *arena,
+                                              strview line) {
+  struct strview_splitter splitter = strview_split(line, ',');
+  OPTIONAL(strview) id = strview_split_next(&splitter);
+  OPTIONAL(strview) name = strview_split_next(&splitter);
+  OPTIONAL(strview) cents = strview_split_next(&splitter);
+  if (OPTIONAL_IS_EMPTY(id) || OPTIONAL_IS_EMPTY(name)
+      || OPTIONAL_IS_EMPTY(cents)) {
+    return (OPTIONAL(order_pointer)) OPTIONAL_EMPTY;
+  }
+  const OPTIONAL(int) parsed_id = optional_parse_int(
+    OPTIONAL_USE_VALUE(id).data, OPTIONAL_USE_VALUE(id).length);
+  const OPTIONAL(int) parsed_cents = optional_parse_int(
+    OPTIONAL_USE_VALUE(cents).data, OPTIONAL_USE_VALUE(cents).length);
+  struct order *order = allocate(arena, sizeof(struct order));
+  if (order == NULL || OPTIONAL_IS_EMPTY(parsed_id)
+      || OPTIONAL_IS_EMPTY(parsed_cents)) {
+    if (arena == NULL) {
+      free(order);
+    }
+    return (OPTIONAL(order_pointer)) OPTIONAL_EMPTY;
+  }
+  *order = (struct order) {
+    .id = OPTIONAL_USE_VALUE(parsed_id),
+    .name = copy_view(arena, OPTIONAL_USE_VALUE(name)),
+    .cents = OPTIONAL_USE_VALUE(parsed_cents)
+  };
+  return (OPTIONAL(order_pointer)) OPTIONAL_PRESENT(order);
+}
+
+// Adds taxes and a label to an order
+static quote_pointer quote_order_in(struct arena *arena, order_pointer order) {
+  struct quote *quote = allocate(arena, sizeof(struct quote));
+  char *label = allocate(arena, 64);
+  if (quote != NULL && label != NULL) {
+    const int total = order->cents + order->cents / 5;
+    (void) snprintf(label, 64, "#%d %s: $%d.%02d", order->id, order->name,
+                    total / 100, total % 100);
+    *quote = (struct quote) {
+      .order = order,
+      .total_cents = total,
+      .label = label
+    };
+  }
+  return quote;
+}
+
+// Issues a receipt for a quote, unless it is over the limit
+static OPTIONAL(receipt_pointer) approve_quote_in(struct arena *arena,
+                                                  quote_pointer quote) {
+  if (quote->total_cents > LIMIT_CENTS) {
+    return (OPTIONAL(receipt_pointer)) OPTIONAL_EMPTY;
+  }
+  struct receipt *receipt = allocate(arena, sizeof(struct receipt));
+  char *text = allocate(arena, 96);
+  if (receipt == NULL || text == NULL) {
+    return (OPTIONAL(receipt_pointer)) OPTIONAL_EMPTY;
+  }
+  (void) snprintf(text, 96, "APPROVED %s", quote->label);
+  *receipt = (struct receipt) {.quote = quote, .text = text};
+  return (OPTIONAL(receipt_pointer)) OPTIONAL_PRESENT(receipt);
+}
+
+// Runs the pipeline on every line; returns the total length of the receipts
+static size_t run(struct arena *arena, const char (*lines)[32], size_t size) {
+  size_t length = 0;
+  for (size_t index = 0; index < size; index++) {
+    const OPTIONAL(strview) line = OPTIONAL_PRESENT(strview_of(lines[index]));
+    const OPTIONAL(order_pointer) order = OPTIONAL_FLAT_MAP_IN(
+      line, arena, parse_order_in);
+    const OPTIONAL(quote_pointer) quote = OPTIONAL_MAP_IN(
+      order, arena, quote_order_in, OPTIONAL(quote_pointer));
+    const OPTIONAL(receipt_pointer) receipt = OPTIONAL_FLAT_MAP_IN(
+      quote, arena, approve_quote_in);
+    if (OPTIONAL_IS_PRESENT(receipt)) {
+      length += strlen(OPTIONAL_USE_VALUE(receipt)->text);
+    }
+    if (arena != NULL) {
+      // The whole request is freed at once
+      arena_reset(arena);
+      continue;
+    }
+    if (OPTIONAL_IS_PRESENT(receipt)) {
+      free(OPTIONAL_USE_VALUE(receipt)->text);
+      free(OPTIONAL_USE_VALUE(receipt));
+    }
+    if (OPTIONAL_IS_PRESENT(quote)) {
+      free(OPTIONAL_USE_VALUE(quote)->label);
+      free(OPTIONAL_USE_VALUE(quote));
+    }
+    if (OPTIONAL_IS_PRESENT(order)) {
+      free(OPTIONAL_USE_VALUE(order)->name);
+      free(OPTIONAL_USE_VALUE(order));
+    }
+  }
+  return length;
+}
+
+/**
+ * Benchmarks a parse -> quote -> approve chain of allocating mappers, with
+ * every step calling malloc vs. allocating from an arena reset per request.
+ */
+int main(int argc, char *argv[]) {
+  const size_t max_size = BENCH_MAX_SIZE_ARG(argc, argv);
+  const size_t size = max_size < REQUESTS ? max_size : REQUESTS;
+  static const char *names[] = {"Snoopy", "Garfield", "Nemo", "Lassie"};
+  char (*lines)[32] = malloc(size * sizeof(*lines));
+  if (lines == NULL) {
+    BENCH_FAIL("Out of memory\n");
+  }
+  uint64_t seed = 0x9e3779b97f4a7c15;
+  for (size_t index = 0; index < size; index++) {
+    const uint64_t random = bench_random(&seed);
+    (void) snprintf(lines[index], sizeof(lines[index]), "%zu,%s,%d", index,
+                    names[random % 4], (int) (random >> 32) % 60000);
+  }
+  double start = bench_now();
+  const size_t mallocked = run(NULL, (const char (*)[32]) lines, size);
+  BENCH_REPORT("malloc per step", size, size, bench_now() - start);
+  struct arena arena;
+  arena_init(&arena, ARENA_CHUNK_SIZE);
+  start = bench_now();
+  const size_t arenaed = run(&arena, (const char (*)[32]) lines, size);
+  BENCH_REPORT("arena per request", size, size, bench_now() - start);
+  arena_free(&arena);
+  free(lines);
+  if (mallocked != arenaed) {
+    BENCH_FAIL("The pipelines disagree\n");
+  }
+  return BENCH_RESULT_PASS;
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <optional.h>
+#include <optional-parallel.h>
+#include "bench.h"
+
+OPTIONAL_STRUCT(uint64_t);
+
+// A few rounds of a 64-bit mixer, so that every element costs some work
+static inline uint64_t mix(uint64_t value) {
+  for (int round = 0; round < 4; round++) {
+    value = (value ^ (value >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+    value = (value ^ (value >> 27)) * UINT64_C(0x94d049bb133111eb);
+  }
+  return value ^ (value >> 31);
+}
+
+#define is_odd(value) (((value) & 1) != 0)
+#define add(x, y) ((x) + (y))
+
+OPTIONAL_PARALLEL_MAP(parallel_mix, uint64_t, uint64_t, mix)
+OPTIONAL_PARALLEL_FILTER(parallel_odd, uint64_t, is_odd)
+OPTIONAL_PARALLEL_REDUCE(parallel_sum, uint64_t, add)
+
+/**
+ * Benchmarks map + filter + reduce over an array of optionals with the
+ * sequential macros, then on work-stealing pools of 1 to all cores.
+ */
+int main(int argc, char *argv[]) {
+  const size_t size = BENCH_MAX_SIZE_ARG(argc, argv);
+  const size_t bytes = (size * sizeof(OPTIONAL(uint64_t)) + 63) / 64 * 64;
+  OPTIONAL(uint64_t) *input = aligned_alloc(64, bytes);
+  OPTIONAL(uint64_t) *mapped = aligned_alloc(64, bytes);
+  OPTIONAL(uint64_t) *filtered = aligned_alloc(64, bytes);
+  if (input == NULL || mapped == NULL || filtered == NULL) {
+    BENCH_FAIL("Out of memory\n");
+  }
+  // Fault the outputs in, so that the first run doesn't pay for it
+  memset(mapped, 0, bytes);
+  memset(filtered, 0, bytes);
+  uint64_t seed = 0x9e3779b97f4a7c15;
+  for (size_t index = 0; index < size; index++) {
+    const uint64_t random = bench_random(&seed);
+    input[index] = random % 8 == 0
+                 ? (OPTIONAL(uint64_t)) OPTIONAL_EMPTY
+                 : (OPTIONAL(uint64_t)) OPTIONAL_PRESENT(random);
+  }
+  uint64_t expected = 0;
+  double start = bench_now();
+  for (size_t index = 0; index < size; index++) {
+    mapped[index] = OPTIONAL_MAP(input[index], mix, OPTIONAL(uint64_t));
+    filtered[index] = OPTIONAL_FILTER(mapped[index], is_odd);
+    expected += OPTIONAL_OR_ELSE(filtered[index], 0);
+  }
+  BENCH_REPORT("sequential macros", size, size, bench_now() - start);
+  const long cores = sysconf(_SC_NPROCESSORS_ONLN);
+  const size_t max_threads = cores > 0 ? (size_t) cores : 1;
+  for (size_t threads = 1;;
+       threads = threads * 2 < max_threads ? threads * 2 : max_threads) {
+    struct work_pool pool;
+    if (!work_pool_init(&pool, threads)) {
+      BENCH_FAIL("Could not start %zu threads\n", threads);
+    }
+    start = bench_now();
+    parallel_mix(&pool, input, mapped, size);
+    parallel_odd(&pool, mapped, filtered, size);
+    const OPTIONAL(uint64_t) sum = parallel_sum(&pool, filtered, size);
+    const double elapsed = bench_now() - start;
+    work_pool_free(&pool);
+    if (OPTIONAL_OR_ELSE(sum, 0) != expected) {
+      BENCH_FAIL("The parallel pipeline disagrees at %zu threads\n", threads);
+    }
+    char name[64];
+    (void) snprintf(name, sizeof(name), "work_pool threads=%zu", threads);
+    BENCH_REPORT(name, size, size, elapsed);
+    if (threads == max_threads) {
+      break;
+    }
+  }
+  free(input);
+  free(mapped);
+  free(filtered);
+  return BENCH_RESULT_PASS;
+}
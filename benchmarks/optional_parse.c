@@ -0,0 +1,146 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <optional.h>
+#include <optional-parse.h>
+#include "bench.h"
+
+#define NUMBERS 1000000
+
+// Longest formatted number (plus its terminator)
+#define FIELD_SIZE 32
+
+// Numbers formatted into fixed-size, null-terminated fields
+struct fields {
+  char (*text)[FIELD_SIZE];
+  size_t *lengths;
+};
+
+static bool format_fields(struct fields *fields, size_t size, int kind) {
+  fields->text = malloc(size * FIELD_SIZE);
+  fields->lengths = malloc(size * sizeof(size_t));
+  if (fields->text == NULL || fields->lengths == NULL) {
+    return false;
+  }
+  uint64_t seed = 0x9e3779b97f4a7c15;
+  for (size_t index = 0; index < size; index++) {
+    const uint64_t random = bench_random(&seed);
+    // Numbers of 1 to 10 (int) or 1 to 19 (long) digits, half of them
+    // negative, and doubles with up to 17 significant digits
+    int length;
+    if (kind == 0) {
+      long limit = 10;
+      for (uint64_t digits = random % 10; digits > 0; digits--) {
+        limit *= 10;
+      }
+      const long value = (long) ((random >> 8)
+                                 % (uint64_t) (limit < INT_MAX ? limit
+                                                               : INT_MAX));
+      length = snprintf(fields->text[index], FIELD_SIZE, "%ld",
+                        random & 1 ? -value : value);
+    } else if (kind == 1) {
+      const long value = (long) ((random >> 1) >> (random % 60));
+      length = snprintf(fields->text[index], FIELD_SIZE, "%ld",
+                        random & 1 ? -value : value);
+    } else {
+      const double value = (double) (random >> 11) * 0x1p-53 * 1e6;
+      length = snprintf(fields->text[index], FIELD_SIZE, "%.*g",
+                        1 + (int) (random % 17), value);
+    }
+    fields->lengths[index] = (size_t) length;
+  }
+  return true;
+}
+
+static void free_fields(struct fields *fields) {
+  free(fields->text);
+  free(fields->lengths);
+}
+
+/**
+ * Benchmarks optional_parse_int/long/double vs. sscanf, strtol and strtod.
+ */
+int main(int argc, char *argv[]) {
+  const size_t max_size = BENCH_MAX_SIZE_ARG(argc, argv);
+  const size_t size = max_size < NUMBERS ? max_size : NUMBERS;
+  struct fields ints, longs, doubles;
+  if (!format_fields(&ints, size, 0) || !format_fields(&longs, size, 1)
+      || !format_fields(&doubles, size, 2)) {
+    BENCH_FAIL("Out of memory\n");
+  }
+  long total = 0;
+  long expected = 0;
+  double start = bench_now();
+  for (size_t index = 0; index < size; index++) {
+    const OPTIONAL(int) value = optional_parse_int(ints.text[index],
+                                                   ints.lengths[index]);
+    total += OPTIONAL_OR_ELSE(value, 0);
+  }
+  BENCH_REPORT("optional_parse_int", size, size, bench_now() - start);
+  start = bench_now();
+  for (size_t index = 0; index < size; index++) {
+    char *end;
+    expected += strtol(ints.text[index], &end, 10);
+  }
+  BENCH_REPORT("strtol (int)", size, size, bench_now() - start);
+  start = bench_now();
+  for (size_t index = 0; index < size; index++) {
+    int value = 0;
+    (void) sscanf(ints.text[index], "%d", &value);
+    BENCH_CONSUME(value);
+  }
+  BENCH_REPORT("sscanf (int)", size, size, bench_now() - start);
+  start = bench_now();
+  for (size_t index = 0; index < size; index++) {
+    const OPTIONAL(long) value = optional_parse_long(longs.text[index],
+                                                     longs.lengths[index]);
+    total += OPTIONAL_OR_ELSE(value, 0);
+  }
+  BENCH_REPORT("optional_parse_long", size, size, bench_now() - start);
+  start = bench_now();
+  for (size_t index = 0; index < size; index++) {
+    char *end;
+    expected += strtol(longs.text[index], &end, 10);
+  }
+  BENCH_REPORT("strtol (long)", size, size, bench_now() - start);
+  double sum = 0;
+  double expected_sum = 0;
+  start = bench_now();
+  for (size_t index = 0; index < size; index++) {
+    const OPTIONAL(double) value = optional_parse_double(
+      doubles.text[index], doubles.lengths[index]);
+    sum += OPTIONAL_OR_ELSE(value, 0);
+  }
+  BENCH_REPORT("optional_parse_double", size, size, bench_now() - start);
+  start = bench_now();
+  for (size_t index = 0; index < size; index++) {
+    char *end;
+    expected_sum += strtod(doubles.text[index], &end);
+  }
+  BENCH_REPORT("strtod", size, size, bench_now() - start);
+  if (total != expected || sum != expected_sum) {
+    BENCH_FAIL("The parsers disagree\n");
+  }
+  free_fields(&ints);
+  free_fields(&longs);
+  free_fields(&doubles);
+  return BENCH_RESULT_PASS;
+}
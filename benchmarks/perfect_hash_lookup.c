@@ -0,0 +1,109 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <optional.h>
+#include <pet-store.h>
+#include <hash-map.h>
+#include <perfect-hash.h>
+#include "bench.h"
+
+#define LOOKUPS 1000000
+
+// Linear scans are only measured up to this size
+#define MAX_SCAN_SIZE 100000
+
+HASH_MAP(pet_map, int, Pet, hash_map_hash_int, hash_map_equals_int)
+
+// Pet ids are even, so odd ids are guaranteed misses
+#define PET_ID_AT(index) ((int) (index) * 2)
+
+// Returns a pet by id: one hashed probe plus one id comparison
+static OPTIONAL(Pet) probe_pets(const struct perfect_hash *table,
+                                struct pet *pets, int pet_id) {
+  Pet pet = &pets[perfect_hash_lookup(table, pet_id)];
+  if (PET_ID(pet) == pet_id) {
+    return (OPTIONAL(Pet)) OPTIONAL_PRESENT(pet);
+  }
+  return (OPTIONAL(Pet)) OPTIONAL_EMPTY;
+}
+
+// Returns a pet by id, scanning the whole table
+static OPTIONAL(Pet) scan_pets(struct pet *pets, size_t size, int pet_id) {
+  for (size_t index = 0; index < size; index++) {
+    if (PET_ID(&pets[index]) == pet_id) {
+      return (OPTIONAL(Pet)) OPTIONAL_PRESENT(&pets[index]);
+    }
+  }
+  return (OPTIONAL(Pet)) OPTIONAL_EMPTY;
+}
+
+/**
+ * Benchmarks pet lookups by id: perfect hash vs. hash map vs. linear scan.
+ */
+int main(int argc, char *argv[]) {
+  const size_t max_size = BENCH_MAX_SIZE_ARG(argc, argv);
+  struct pet *pets = malloc(max_size * sizeof(struct pet));
+  int *pet_ids = malloc(max_size * sizeof(int));
+  int *ids = malloc(LOOKUPS * sizeof(int));
+  if (pets == NULL || pet_ids == NULL || ids == NULL) {
+    BENCH_FAIL("Out of memory\n");
+  }
+  for (size_t size = 10; size <= max_size; size *= 10) {
+    struct perfect_hash table;
+    struct pet_map map;
+    uint64_t seed = 0x9e3779b97f4a7c15;
+    for (size_t index = 0; index < size; index++) {
+      pets[index] = (struct pet) {.id = PET_ID_AT(index), .name = "Pet"};
+      pet_ids[index] = PET_ID(&pets[index]);
+    }
+    if (!perfect_hash_build(&table, pet_ids, size)
+        || !pet_map_init(&map, size)) {
+      BENCH_FAIL("Could not build the indexes\n");
+    }
+    for (size_t index = 0; index < size; index++) {
+      (void) pet_map_put(&map, PET_ID(&pets[index]), &pets[index]);
+    }
+    // Half of the lookups are misses
+    for (size_t index = 0; index < LOOKUPS; index++) {
+      ids[index] = PET_ID_AT(bench_random(&seed) % size) + (int) (index & 1);
+    }
+    double start = bench_now();
+    for (size_t index = 0; index < LOOKUPS; index++) {
+      BENCH_CONSUME(OPTIONAL_IS_PRESENT(probe_pets(&table, pets, ids[index])));
+    }
+    BENCH_REPORT("perfect_hash", size, LOOKUPS, bench_now() - start);
+    start = bench_now();
+    for (size_t index = 0; index < LOOKUPS; index++) {
+      BENCH_CONSUME(OPTIONAL_IS_PRESENT(pet_map_get(&map, ids[index])));
+    }
+    BENCH_REPORT("hash_map", size, LOOKUPS, bench_now() - start);
+    if (size <= MAX_SCAN_SIZE) {
+      const size_t lookups = LOOKUPS / size * 10;
+      start = bench_now();
+      for (size_t index = 0; index < lookups; index++) {
+        BENCH_CONSUME(OPTIONAL_IS_PRESENT(scan_pets(pets, size, ids[index])));
+      }
+      BENCH_REPORT("linear_scan", size, lookups, bench_now() - start);
+    }
+    perfect_hash_free(&table);
+    pet_map_free(&map);
+  }
+  free(pets);
+  free(pet_ids);
+  free(ids);
+  return BENCH_RESULT_PASS;
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <optional.h>
+#include <pet-store.h>
+#include "bench.h"
+
+#define LOOKUPS 2000000
+
+// Ids of added pets are even and don't clash with the static catalogue
+#define PET_ID_AT(index) (1000 + (int) (index) * 2)
+
+// Fraction of the lookups that miss, in percent
+#define MISS_PERCENT 40
+
+/**
+ * Benchmarks find_pet under a Zipfian id distribution (built with and
+ * without the lookup cache).
+ */
+int main(int argc, char *argv[]) {
+  const size_t size = argc > 1 ? BENCH_MAX_SIZE_ARG(argc, argv) : 1000000;
+  const double exponents[] = {0.8, 0.99, 1.2};
+  struct pet *pets = malloc(size * sizeof(struct pet));
+  size_t *ranks = malloc(size * sizeof(size_t));
+  int *ids = malloc(LOOKUPS * sizeof(int));
+  uint64_t seed = 0x9e3779b97f4a7c15;
+  if (pets == NULL || ranks == NULL || ids == NULL) {
+    BENCH_FAIL("Out of memory\n");
+  }
+  for (size_t index = 0; index < size; index++) {
+    pets[index] = (struct pet) {.id = PET_ID_AT(index), .name = "Pet"};
+    if (OPTIONAL_IS_EMPTY(add_pet(&pets[index]))) {
+      BENCH_FAIL("Could not add pet %zu\n", index);
+    }
+    ranks[index] = index;
+  }
+  // Scatter the popular pets over the whole table
+  for (size_t index = size - 1; index > 0; index--) {
+    const size_t other = bench_random(&seed) % (index + 1);
+    const size_t rank = ranks[index];
+    ranks[index] = ranks[other];
+    ranks[other] = rank;
+  }
+  for (size_t exponent = 0; exponent < 3; exponent++) {
+    struct bench_zipf zipf;
+    char name[64];
+    if (!bench_zipf_init(&zipf, size, exponents[exponent])) {
+      BENCH_FAIL("Out of memory\n");
+    }
+    for (size_t index = 0; index < LOOKUPS; index++) {
+      const int miss = (int) (bench_random(&seed) % 100) < MISS_PERCENT;
+      ids[index] = PET_ID_AT(ranks[bench_zipf_next(&zipf, &seed)]) + miss;
+    }
+    const pet_cache_stats before = get_pet_cache_stats();
+    const double start = bench_now();
+    for (size_t index = 0; index < LOOKUPS; index++) {
+      BENCH_CONSUME(RESULT_IS_SUCCESS(find_pet(ids[index])));
+    }
+    const double elapsed = bench_now() - start;
+    const pet_cache_stats after = get_pet_cache_stats();
+    (void) snprintf(name, sizeof(name), "zipf(%.2f)/hit_rate=%.1f%%",
+                    exponents[exponent],
+                    100.0 * (double) (after.hits - before.hits) / LOOKUPS);
+    BENCH_REPORT(name, size, LOOKUPS, elapsed);
+    bench_zipf_free(&zipf);
+  }
+  free(pets);
+  free(ranks);
+  free(ids);
+  return BENCH_RESULT_PASS;
+}
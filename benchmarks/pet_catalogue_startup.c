@@ -0,0 +1,146 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <string.h>
+#include <unistd.h>
+#include <optional.h>
+#include <hash-map.h>
+#include <pet-catalogue-file.h>
+#include <pet-store.h>
+#include "bench.h"
+
+#define PETS 1000000
+#define LOOKUPS 1000
+
+// Longest line of the text dump
+#define LINE_SIZE 64
+
+OPTIONAL_STRUCT(size_t);
+HASH_MAP(parsed_pets, int, size_t, hash_map_hash_int, hash_map_equals_int)
+
+// Pets parsed from a text dump, the way a store would load them at startup
+struct parsed_catalogue {
+  struct parsed_pets index;
+  char **names;
+  uint8_t *statuses;
+  size_t count;
+};
+
+// Parses a text dump of `id\tname\tstatus` lines
+static bool parse_dump(struct parsed_catalogue *catalogue, const char *path,
+                       size_t size) {
+  FILE *file = fopen(path, "r");
+  catalogue->count = 0;
+  catalogue->names = malloc(size * sizeof(char *));
+  catalogue->statuses = malloc(size);
+  if (file == NULL || catalogue->names == NULL || catalogue->statuses == NULL
+      || !parsed_pets_init(&catalogue->index, size)) {
+    return false;
+  }
+  char line[LINE_SIZE];
+  while (catalogue->count < size && fgets(line, sizeof(line), file) != NULL) {
+    char *name = strchr(line, '\t');
+    char *status = name != NULL ? strchr(name + 1, '\t') : NULL;
+    if (status == NULL) {
+      break;
+    }
+    *name++ = *status++ = '\0';
+    const size_t row = catalogue->count++;
+    catalogue->names[row] = strdup(name);
+    catalogue->statuses[row] = (uint8_t) atoi(status);
+    if (catalogue->names[row] == NULL
+        || !parsed_pets_put(&catalogue->index, atoi(line), row)) {
+      break;
+    }
+  }
+  fclose(file);
+  return catalogue->count == size;
+}
+
+static void free_parsed(struct parsed_catalogue *catalogue) {
+  for (size_t row = 0; row < catalogue->count; row++) {
+    free(catalogue->names[row]);
+  }
+  free(catalogue->names);
+  free(catalogue->statuses);
+  parsed_pets_free(&catalogue->index);
+}
+
+/**
+ * Benchmarks startup: mapping a 1M-pet catalogue file vs. parsing a dump.
+ */
+int main(int argc, char *argv[]) {
+  const size_t max_size = BENCH_MAX_SIZE_ARG(argc, argv);
+  const size_t size = max_size < PETS ? max_size : PETS;
+  int *ids = malloc(size * sizeof(int));
+  uint8_t *statuses = malloc(size);
+  const char **names = malloc(size * sizeof(char *));
+  char (*buffer)[16] = malloc(size * 16);
+  char catalogue_path[] = "/tmp/pet-catalogue-XXXXXX";
+  char dump_path[] = "/tmp/pet-dump-XXXXXX";
+  const int catalogue_descriptor = mkstemp(catalogue_path);
+  const int dump_descriptor = mkstemp(dump_path);
+  if (ids == NULL || statuses == NULL || names == NULL || buffer == NULL
+      || catalogue_descriptor < 0 || dump_descriptor < 0) {
+    BENCH_FAIL("Could not set up the catalogue\n");
+  }
+  close(catalogue_descriptor);
+  FILE *dump = fdopen(dump_descriptor, "w");
+  uint64_t seed = 0x9e3779b97f4a7c15;
+  for (size_t index = 0; index < size; index++) {
+    ids[index] = 1000 + (int) index;
+    statuses[index] = (uint8_t) (bench_random(&seed) % 3);
+    snprintf(buffer[index], 16, "pet-%zu", index);
+    names[index] = buffer[index];
+    fprintf(dump, "%d\t%s\t%d\n", ids[index], names[index], statuses[index]);
+  }
+  if (fclose(dump) != 0
+      || !pet_catalogue_file_write(catalogue_path, ids, statuses, names,
+                                   size)) {
+    BENCH_FAIL("Could not write the catalogue\n");
+  }
+  size_t found = 0;
+  double start = bench_now();
+  if (!open_pet_catalogue(catalogue_path)) {
+    BENCH_FAIL("Could not open the catalogue\n");
+  }
+  for (size_t index = 0; index < LOOKUPS; index++) {
+    found += RESULT_IS_SUCCESS(find_pet(ids[bench_random(&seed) % size]));
+  }
+  BENCH_REPORT("open_pet_catalogue", size, 1, bench_now() - start);
+  struct parsed_catalogue parsed;
+  start = bench_now();
+  if (!parse_dump(&parsed, dump_path, size)) {
+    BENCH_FAIL("Could not parse the dump\n");
+  }
+  for (size_t index = 0; index < LOOKUPS; index++) {
+    const int id = ids[bench_random(&seed) % size];
+    found += OPTIONAL_IS_PRESENT(parsed_pets_get(&parsed.index, id));
+  }
+  BENCH_REPORT("parse text dump", size, 1, bench_now() - start);
+  if (found != 2 * LOOKUPS) {
+    BENCH_FAIL("Some pets were not found\n");
+  }
+  free_parsed(&parsed);
+  remove(catalogue_path);
+  remove(dump_path);
+  free(ids);
+  free(statuses);
+  free(names);
+  free(buffer);
+  return BENCH_RESULT_PASS;
+}
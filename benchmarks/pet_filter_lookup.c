@@ -0,0 +1,78 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <optional.h>
+#include <pet-store.h>
+#include <bloom-filter.h>
+#include "bench.h"
+
+#define LOOKUPS 1000000
+
+// Ids of added pets are even and don't clash with the static catalogue
+#define PET_ID_AT(index) (1000 + (int) (index) * 2)
+
+/**
+ * Benchmarks find_pet with and without the negative-lookup filter.
+ */
+int main(int argc, char *argv[]) {
+  const size_t size = argc > 1 ? BENCH_MAX_SIZE_ARG(argc, argv) : 1000000;
+  const int miss_percents[] = {0, 10, 40, 90, 100};
+  const double rates[] = {0.1, 0.01, 0.001};
+  struct pet *pets = malloc(size * sizeof(struct pet));
+  int *ids = malloc(LOOKUPS * sizeof(int));
+  if (pets == NULL || ids == NULL) {
+    BENCH_FAIL("Out of memory\n");
+  }
+  for (size_t index = 0; index < size; index++) {
+    pets[index] = (struct pet) {.id = PET_ID_AT(index), .name = "Pet"};
+    if (OPTIONAL_IS_EMPTY(add_pet(&pets[index]))) {
+      BENCH_FAIL("Could not add pet %zu\n", index);
+    }
+  }
+  for (size_t mix = 0; mix < sizeof(miss_percents) / sizeof(int); mix++) {
+    uint64_t seed = 0x9e3779b97f4a7c15;
+    for (size_t index = 0; index < LOOKUPS; index++) {
+      const int miss = (int) (bench_random(&seed) % 100) < miss_percents[mix];
+      ids[index] = PET_ID_AT(bench_random(&seed) % size) + miss;
+    }
+    for (size_t rate = 0; rate <= sizeof(rates) / sizeof(rates[0]); rate++) {
+      char name[64];
+      // The last round disables the filter
+      const bool filtered = rate < sizeof(rates) / sizeof(rates[0]);
+      if (!set_pet_filter(filtered ? rates[rate] : 0, filtered ? SIZE_MAX : 0)) {
+        BENCH_FAIL("Could not build the filter\n");
+      }
+      const double start = bench_now();
+      for (size_t index = 0; index < LOOKUPS; index++) {
+        BENCH_CONSUME(RESULT_IS_SUCCESS(find_pet(ids[index])));
+      }
+      const double elapsed = bench_now() - start;
+      if (filtered) {
+        (void) snprintf(name, sizeof(name), "misses=%d%%/filter(%g,%zuKB)",
+                        miss_percents[mix], rates[rate],
+                        bloom_filter_bytes(2 * size + 1024, rates[rate]) / 1024);
+      } else {
+        (void) snprintf(name, sizeof(name), "misses=%d%%/no_filter",
+                        miss_percents[mix]);
+      }
+      BENCH_REPORT(name, size, LOOKUPS, elapsed);
+    }
+  }
+  free(pets);
+  free(ids);
+  return BENCH_RESULT_PASS;
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <optional.h>
+#include <pet-index.h>
+#include "bench.h"
+
+#define LOOKUPS 1000000
+
+// Pet ids are even, so odd ids are guaranteed misses
+#define PET_ID_AT(index) ((int) (index) * 2)
+
+// Returns a pet by id, using binary search on a sorted array
+static OPTIONAL(Pet) search_pets(const int *ids, Pet *pets, size_t size,
+                                 int pet_id) {
+  size_t low = 0;
+  size_t high = size;
+  while (low < high) {
+    const size_t middle = low + (high - low) / 2;
+    if (ids[middle] < pet_id) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  if (low == size || ids[low] != pet_id) {
+    return (OPTIONAL(Pet)) OPTIONAL_EMPTY;
+  }
+  return (OPTIONAL(Pet)) OPTIONAL_PRESENT(pets[low]);
+}
+
+/**
+ * Benchmarks pet lookups by id: Eytzinger layout vs. sorted array.
+ */
+int main(int argc, char *argv[]) {
+  const size_t max_size = BENCH_MAX_SIZE_ARG(argc, argv);
+  struct pet *pets = malloc(max_size * sizeof(struct pet));
+  Pet *sorted = malloc(max_size * sizeof(Pet));
+  int *sorted_ids = malloc(max_size * sizeof(int));
+  int *ids = malloc(LOOKUPS * sizeof(int));
+  if (pets == NULL || sorted == NULL || sorted_ids == NULL || ids == NULL) {
+    BENCH_FAIL("Out of memory\n");
+  }
+  for (size_t size = 1000; size <= max_size; size *= 10) {
+    struct pet_index index;
+    uint64_t seed = 0x9e3779b97f4a7c15;
+    for (size_t position = 0; position < size; position++) {
+      pets[position] = (struct pet) {.id = PET_ID_AT(position), .name = "Pet"};
+      sorted[position] = &pets[position];
+      sorted_ids[position] = PET_ID(&pets[position]);
+    }
+    if (!pet_index_build(&index, sorted, size)) {
+      BENCH_FAIL("Out of memory\n");
+    }
+    // Half of the lookups are misses
+    for (size_t position = 0; position < LOOKUPS; position++) {
+      ids[position] = PET_ID_AT(bench_random(&seed) % size)
+                    + (int) (position & 1);
+    }
+    double start = bench_now();
+    for (size_t position = 0; position < LOOKUPS; position++) {
+      OPTIONAL(Pet) pet = pet_index_find(&index, ids[position]);
+      BENCH_CONSUME(OPTIONAL_IS_PRESENT(pet));
+    }
+    BENCH_REPORT("eytzinger/find", size, LOOKUPS, bench_now() - start);
+    start = bench_now();
+    for (size_t position = 0; position < LOOKUPS; position++) {
+      OPTIONAL(Pet) pet = search_pets(sorted_ids, sorted, size, ids[position]);
+      BENCH_CONSUME(OPTIONAL_IS_PRESENT(pet));
+    }
+    BENCH_REPORT("binary_search/find", size, LOOKUPS, bench_now() - start);
+    // Ranges of 32 pets
+    start = bench_now();
+    for (size_t position = 0; position < LOOKUPS / 32; position++) {
+      struct pet_range range = pet_index_range(&index, ids[position],
+                                               ids[position] + 64);
+      OPTIONAL(Pet) pet;
+      while (pet = pet_range_next(&range), OPTIONAL_IS_PRESENT(pet)) {
+        BENCH_CONSUME(OPTIONAL_USE_VALUE(pet));
+      }
+    }
+    BENCH_REPORT("eytzinger/range(32)", size, LOOKUPS / 32,
+                 bench_now() - start);
+    pet_index_free(&index);
+  }
+  free(pets);
+  free(sorted);
+  free(sorted_ids);
+  free(ids);
+  return BENCH_RESULT_PASS;
+}
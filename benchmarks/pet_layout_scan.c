@@ -0,0 +1,139 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <optional.h>
+#include <pet-columns.h>
+#include <pet-store.h>
+#include "bench.h"
+
+// Smallest number of pets benchmarked
+#define MIN_SIZE 1000000
+
+// Number of times each scan is repeated
+#define SCANS 16
+
+// Returns the position of a pet by id (array of structs)
+static size_t find_id_in_structs(const struct pet *pets, size_t size, int id) {
+  for (size_t index = 0; index < size; index++) {
+    if (pets[index].id == id) {
+      return index;
+    }
+  }
+  return SIZE_MAX;
+}
+
+// Returns the position of a pet by id (struct of arrays)
+static size_t find_id_in_columns(const struct pet_columns *columns, int id) {
+  for (size_t row = 0; row < columns->count; row++) {
+    if (columns->ids[row] == id) {
+      return row;
+    }
+  }
+  return SIZE_MAX;
+}
+
+// Counts the pets with the supplied status (array of structs)
+static size_t count_status_in_structs(const struct pet *pets, size_t size,
+                                      pet_status status) {
+  size_t count = 0;
+  for (size_t index = 0; index < size; index++) {
+    count += atomic_load_explicit(&pets[index].status,
+                                  memory_order_relaxed) == status;
+  }
+  return count;
+}
+
+// Counts the pets with the supplied status (struct of arrays)
+static size_t count_status_in_columns(const struct pet_columns *columns,
+                                      pet_status status) {
+  size_t count = 0;
+  for (size_t row = 0; row < columns->count; row++) {
+    count += atomic_load_explicit(&columns->statuses[row],
+                                  memory_order_relaxed) == status;
+  }
+  return count;
+}
+
+/**
+ * Benchmarks scans over ids and over statuses on pets stored as an array of
+ * structs vs. as a struct of arrays.
+ */
+int main(int argc, char *argv[]) {
+  const size_t max_size = BENCH_MAX_SIZE_ARG(argc, argv);
+  struct pet *pets = malloc(max_size * sizeof(struct pet));
+  struct pet_columns columns = {.count = 0};
+  if (pets == NULL) {
+    BENCH_FAIL("Out of memory\n");
+  }
+  static const char *names[] = {"Rocky", "Garfield", "Rantanplan", "Snoopy"};
+  uint64_t seed = 0x9e3779b97f4a7c15;
+  size_t added = 0;
+  for (size_t size = MIN_SIZE; size <= max_size; size *= 10) {
+    for (; added < size; added++) {
+      const uint64_t random = bench_random(&seed);
+      const pet_status status = (pet_status) (random % 3);
+      const char *name = names[(random >> 8) % 4];
+      pets[added] = (struct pet) {
+        .id = (int) added,
+        .name = name,
+        .status = status
+      };
+      if (pet_columns_append(&columns, (int) added, name, status)
+          == SIZE_MAX) {
+        BENCH_FAIL("Could not add pet %zu\n", added);
+      }
+    }
+    int ids[SCANS];
+    size_t scanned = 0;
+    for (size_t scan = 0; scan < SCANS; scan++) {
+      ids[scan] = (int) (bench_random(&seed) % size);
+      scanned += (size_t) ids[scan] + 1;
+    }
+    size_t found = 0;
+    double start = bench_now();
+    for (size_t scan = 0; scan < SCANS; scan++) {
+      found += find_id_in_structs(pets, size, ids[scan]);
+    }
+    BENCH_REPORT("id scan (array of structs)", size, scanned,
+                 bench_now() - start);
+    start = bench_now();
+    for (size_t scan = 0; scan < SCANS; scan++) {
+      found -= find_id_in_columns(&columns, ids[scan]);
+    }
+    BENCH_REPORT("id scan (struct of arrays)", size, scanned,
+                 bench_now() - start);
+    size_t count = 0;
+    start = bench_now();
+    for (size_t scan = 0; scan < SCANS; scan++) {
+      count += count_status_in_structs(pets, size, (pet_status) (scan % 3));
+    }
+    BENCH_REPORT("status scan (array of structs)", size, SCANS * size,
+                 bench_now() - start);
+    start = bench_now();
+    for (size_t scan = 0; scan < SCANS; scan++) {
+      count -= count_status_in_columns(&columns, (pet_status) (scan % 3));
+    }
+    BENCH_REPORT("status scan (struct of arrays)", size, SCANS * size,
+                 bench_now() - start);
+    if (found != 0 || count != 0) {
+      BENCH_FAIL("Both layouts should find the same pets\n");
+    }
+  }
+  free(pets);
+  pet_columns_free(&columns);
+  return BENCH_RESULT_PASS;
+}
@@ -0,0 +1,252 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// Needed to pin threads to cores
+#define _GNU_SOURCE
+
+#include <getopt.h>
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <unistd.h>
+#include <optional.h>
+#include <pet-store.h>
+#include "bench.h"
+
+// Workload replayed by every thread
+struct workload {
+  size_t threads;
+  size_t operations;
+  size_t pets;
+  bool zipfian;
+  double exponent;
+  double hit_ratio;
+  double buy_ratio;
+  bool pinned;
+};
+
+// Operation to replay (the id of a pet that may not exist)
+struct operation {
+  int pet_id;
+  bool buy;
+};
+
+struct worker {
+  pthread_t thread;
+  size_t index;
+  const struct workload *workload;
+  struct operation *operations;
+  size_t found;
+  size_t bought;
+  struct bench_histogram find;
+  struct bench_histogram buy;
+};
+
+// Prepares the operations of a worker, so that choosing ids is not timed
+static void plan_operations(struct worker *worker,
+                            const struct bench_zipf *zipf) {
+  const struct workload *workload = worker->workload;
+  uint64_t seed = 0x9e3779b97f4a7c15 * (worker->index + 1);
+  for (size_t index = 0; index < workload->operations; index++) {
+    const double hit = (double) (bench_random(&seed) >> 11) * 0x1p-53;
+    const double buy = (double) (bench_random(&seed) >> 11) * 0x1p-53;
+    const size_t rank = workload->zipfian ? bench_zipf_next(zipf, &seed)
+                      : bench_random(&seed) % workload->pets;
+    // Pets have ids from 1000 up; misses ask for negative ids
+    worker->operations[index] = (struct operation) {
+      .pet_id = hit < workload->hit_ratio ? 1000 + (int) rank
+                                          : -1 - (int) rank,
+      .buy = buy < workload->buy_ratio
+    };
+  }
+}
+
+// Replays the operations of a worker, timing each of them
+static void *replay_operations(void *argument) {
+  struct worker *worker = argument;
+  if (worker->workload->pinned) {
+    const long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(worker->index % (size_t) (cores > 0 ? cores : 1), &cpus);
+    (void) pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+  }
+  for (size_t index = 0; index < worker->workload->operations; index++) {
+    const struct operation operation = worker->operations[index];
+    const double start = bench_now();
+    RESULT(Pet, pet_error) pet = find_pet(operation.pet_id);
+    if (operation.buy) {
+      pet = RESULT_FLAT_MAP(pet, buy_pet);
+    }
+    const uint64_t elapsed = (uint64_t) (bench_now() - start);
+    bench_histogram_record(operation.buy ? &worker->buy : &worker->find,
+                           elapsed);
+    if (RESULT_IS_SUCCESS(pet)) {
+      *(operation.buy ? &worker->bought : &worker->found) += 1;
+    }
+  }
+  return NULL;
+}
+
+// Prints a histogram as a JSON object
+static void print_latency(const char *name,
+                          const struct bench_histogram *histogram,
+                          const char *separator) {
+  printf("    \"%s\": {\"count\": %llu, \"p50\": %llu, \"p99\": %llu, "
+         "\"p999\": %llu, \"max\": %llu}%s\n", name,
+         (unsigned long long) histogram->count,
+         (unsigned long long) bench_histogram_percentile(histogram, 0.5),
+         (unsigned long long) bench_histogram_percentile(histogram, 0.99),
+         (unsigned long long) bench_histogram_percentile(histogram, 0.999),
+         (unsigned long long) histogram->max, separator);
+}
+
+static const struct option options[] = {
+  {"threads", required_argument, NULL, 't'},
+  {"operations", required_argument, NULL, 'o'},
+  {"pets", required_argument, NULL, 'p'},
+  {"zipf", required_argument, NULL, 'z'},
+  {"hit-ratio", required_argument, NULL, 'h'},
+  {"buy-ratio", required_argument, NULL, 'b'},
+  {"no-pinning", no_argument, NULL, 'n'},
+  {NULL, 0, NULL, 0}
+};
+
+/**
+ * Replays a configurable workload of find_pet and buy_pet calls on N threads
+ * pinned to cores, and reports throughput and latency percentiles as JSON.
+ *
+ * --threads N       Number of threads (one per core by default)
+ * --operations N    Operations per thread (1000000 by default)
+ * --pets N          Pets in the store (100000 by default)
+ * --zipf S          Zipfian ids with exponent S (uniform by default)
+ * --hit-ratio R     Fraction of operations on existing pets (0.9)
+ * --buy-ratio R     Fraction of operations that buy the pet (0.1)
+ * --no-pinning      Let the scheduler move threads between cores
+ */
+int main(int argc, char *argv[]) {
+  const long cores = sysconf(_SC_NPROCESSORS_ONLN);
+  struct workload workload = {
+    .threads = cores > 0 ? (size_t) cores : 1,
+    .operations = 1000000,
+    .pets = 100000,
+    .hit_ratio = 0.9,
+    .buy_ratio = 0.1,
+    .pinned = true
+  };
+  int option;
+  while ((option = getopt_long(argc, argv, "", options, NULL)) != -1) {
+    switch (option) {
+      case 't': workload.threads = strtoul(optarg, NULL, 10); break;
+      case 'o': workload.operations = strtoul(optarg, NULL, 10); break;
+      case 'p': workload.pets = strtoul(optarg, NULL, 10); break;
+      case 'z':
+        workload.zipfian = true;
+        workload.exponent = strtod(optarg, NULL);
+        break;
+      case 'h': workload.hit_ratio = strtod(optarg, NULL); break;
+      case 'b': workload.buy_ratio = strtod(optarg, NULL); break;
+      case 'n': workload.pinned = false; break;
+      default: BENCH_FAIL("Usage: %s [OPTION]...\n", argv[0]);
+    }
+  }
+  if (workload.threads == 0 || workload.pets == 0) {
+    BENCH_FAIL("There must be at least one thread and one pet\n");
+  }
+  struct pet *pets = malloc(workload.pets * sizeof(struct pet));
+  struct worker *workers = calloc(workload.threads, sizeof(struct worker));
+  struct bench_zipf zipf = {.cumulative = NULL};
+  if (pets == NULL || workers == NULL
+      || (workload.zipfian
+          && !bench_zipf_init(&zipf, workload.pets, workload.exponent))) {
+    BENCH_FAIL("Out of memory\n");
+  }
+  for (size_t index = 0; index < workload.pets; index++) {
+    pets[index] = (struct pet) {.id = 1000 + (int) index, .name = "Pet"};
+    if (OPTIONAL_IS_EMPTY(add_pet(&pets[index]))) {
+      BENCH_FAIL("Could not add pet %zu\n", index);
+    }
+  }
+  for (size_t index = 0; index < workload.threads; index++) {
+    workers[index].index = index;
+    workers[index].workload = &workload;
+    workers[index].operations = malloc(workload.operations
+                                       * sizeof(struct operation));
+    if (workers[index].operations == NULL) {
+      BENCH_FAIL("Out of memory\n");
+    }
+    plan_operations(&workers[index], &zipf);
+  }
+  const double start = bench_now();
+  for (size_t index = 0; index < workload.threads; index++) {
+    if (pthread_create(&workers[index].thread, NULL, replay_operations,
+                       &workers[index]) != 0) {
+      BENCH_FAIL("Could not start thread %zu\n", index);
+    }
+  }
+  for (size_t index = 0; index < workload.threads; index++) {
+    (void) pthread_join(workers[index].thread, NULL);
+  }
+  const double elapsed = bench_now() - start;
+  struct bench_histogram *find = calloc(1, sizeof(struct bench_histogram));
+  struct bench_histogram *buy = calloc(1, sizeof(struct bench_histogram));
+  struct bench_histogram *all = calloc(1, sizeof(struct bench_histogram));
+  if (find == NULL || buy == NULL || all == NULL) {
+    BENCH_FAIL("Out of memory\n");
+  }
+  size_t found = 0;
+  size_t bought = 0;
+  for (size_t index = 0; index < workload.threads; index++) {
+    bench_histogram_add(find, &workers[index].find);
+    bench_histogram_add(buy, &workers[index].buy);
+    found += workers[index].found;
+    bought += workers[index].bought;
+    free(workers[index].operations);
+  }
+  bench_histogram_add(all, find);
+  bench_histogram_add(all, buy);
+  const size_t total = workload.threads * workload.operations;
+  printf("{\n");
+  printf("  \"threads\": %zu,\n", workload.threads);
+  printf("  \"pinned\": %s,\n", workload.pinned ? "true" : "false");
+  printf("  \"pets\": %zu,\n", workload.pets);
+  printf("  \"distribution\": \"%s\",\n",
+         workload.zipfian ? "zipfian" : "uniform");
+  if (workload.zipfian) {
+    printf("  \"zipf_exponent\": %g,\n", workload.exponent);
+  }
+  printf("  \"hit_ratio\": %g,\n", workload.hit_ratio);
+  printf("  \"buy_ratio\": %g,\n", workload.buy_ratio);
+  printf("  \"operations\": %zu,\n", total);
+  printf("  \"found\": %zu,\n", found);
+  printf("  \"bought\": %zu,\n", bought);
+  printf("  \"elapsed_seconds\": %.6f,\n", elapsed / 1e9);
+  printf("  \"throughput_ops_per_second\": %.0f,\n",
+         (double) total / elapsed * 1e9);
+  printf("  \"latency_ns\": {\n");
+  print_latency("find", find, ",");
+  print_latency("buy", buy, ",");
+  print_latency("all", all, "");
+  printf("  }\n}\n");
+  bench_zipf_free(&zipf);
+  free(find);
+  free(buy);
+  free(all);
+  free(workers);
+  free(pets);
+  return BENCH_RESULT_PASS;
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <pthread.h>
+#include <optional.h>
+#include <sharded-pet-store.h>
+#include "bench.h"
+
+#define MAX_THREADS 64
+
+// Number of operations performed by each thread
+#define OPERATIONS 200000
+
+// One out of this many operations adds a new pet; the rest are lookups
+#define READS_PER_WRITE 1000
+
+#define WRITES_PER_THREAD (OPERATIONS / READS_PER_WRITE)
+
+HASH_MAP(locked_map, int, Pet, hash_map_hash_int, hash_map_equals_int)
+
+// Single-lock design: one map guarded by one mutex
+static struct locked_map locked_pets;
+static pthread_mutex_t locked_pets_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static struct sharded_pet_store sharded_pets;
+
+struct worker {
+  pthread_t thread;
+  bool sharded;
+  size_t size;
+  struct pet *new_pets;
+  uint64_t seed;
+  size_t found;
+};
+
+static OPTIONAL(Pet) find_locked(int pet_id) {
+  (void) pthread_mutex_lock(&locked_pets_lock);
+  const OPTIONAL(Pet) found = locked_map_get(&locked_pets, pet_id);
+  (void) pthread_mutex_unlock(&locked_pets_lock);
+  return found;
+}
+
+static void add_locked(Pet pet) {
+  (void) pthread_mutex_lock(&locked_pets_lock);
+  (void) locked_map_put(&locked_pets, PET_ID(pet), pet);
+  (void) pthread_mutex_unlock(&locked_pets_lock);
+}
+
+static void *work(void *argument) {
+  struct worker *worker = argument;
+  struct epoch_reader *reader = NULL;
+  if (worker->sharded
+      && (reader = sharded_pet_store_register(&sharded_pets)) == NULL) {
+    return NULL;
+  }
+  size_t writes = 0;
+  for (size_t operation = 1; operation <= OPERATIONS; operation++) {
+    if (operation % READS_PER_WRITE == 0) {
+      Pet pet = &worker->new_pets[writes++];
+      if (worker->sharded) {
+        (void) sharded_pet_store_add(&sharded_pets, pet);
+      } else {
+        add_locked(pet);
+      }
+      continue;
+    }
+    const int pet_id = (int) (bench_random(&worker->seed) % worker->size);
+    const OPTIONAL(Pet) found = worker->sharded
+      ? sharded_pet_store_find(&sharded_pets, reader, pet_id)
+      : find_locked(pet_id);
+    worker->found += OPTIONAL_IS_PRESENT(found);
+  }
+  if (reader != NULL) {
+    epoch_unregister(reader);
+  }
+  return NULL;
+}
+
+// Runs the supplied number of workers concurrently; returns the elapsed time
+static double run_workers(struct worker *workers, size_t threads,
+                          bool sharded, struct pet *pets, size_t size) {
+  const double start = bench_now();
+  for (size_t index = 0; index < threads; index++) {
+    workers[index] = (struct worker) {
+      .sharded = sharded,
+      .size = size,
+      .new_pets = &pets[size + index * WRITES_PER_THREAD],
+      .seed = 0x9e3779b97f4a7c15 + index
+    };
+    if (pthread_create(&workers[index].thread, NULL, work,
+                       &workers[index]) != 0) {
+      return -1;
+    }
+  }
+  size_t found = 0;
+  for (size_t index = 0; index < threads; index++) {
+    (void) pthread_join(workers[index].thread, NULL);
+    found += workers[index].found;
+  }
+  const double elapsed = bench_now() - start;
+  // Every lookup is for a pet that was there from the start
+  return found == threads * (OPERATIONS - WRITES_PER_THREAD) ? elapsed : -1;
+}
+
+/**
+ * Benchmarks a read-mostly workload (1000 reads per write) on the sharded
+ * pet store vs. a hash map guarded by a single mutex, at 1-64 threads.
+ */
+int main(int argc, char *argv[]) {
+  const size_t max_size = BENCH_MAX_SIZE_ARG(argc, argv);
+  const size_t size = max_size < 100000 ? max_size : 100000;
+  const size_t total = size + MAX_THREADS * WRITES_PER_THREAD;
+  struct pet *pets = malloc(total * sizeof(struct pet));
+  struct worker *workers = malloc(MAX_THREADS * sizeof(struct worker));
+  if (pets == NULL || workers == NULL) {
+    BENCH_FAIL("Out of memory\n");
+  }
+  for (size_t index = 0; index < total; index++) {
+    pets[index] = (struct pet) {.id = (int) index, .name = "Pet"};
+  }
+  for (size_t threads = 1; threads <= MAX_THREADS; threads *= 2) {
+    char name[64];
+    if (!locked_map_init(&locked_pets, size)
+        || !sharded_pet_store_init(&sharded_pets)) {
+      BENCH_FAIL("Out of memory\n");
+    }
+    for (size_t index = 0; index < size; index++) {
+      add_locked(&pets[index]);
+      if (OPTIONAL_IS_EMPTY(sharded_pet_store_add(&sharded_pets,
+                                                  &pets[index]))) {
+        BENCH_FAIL("Could not add pet %zu\n", index);
+      }
+    }
+    double elapsed = run_workers(workers, threads, true, pets, size);
+    if (elapsed < 0) {
+      BENCH_FAIL("sharded_pet_store lost a pet\n");
+    }
+    (void) snprintf(name, sizeof(name), "sharded_pet_store threads=%zu",
+                    threads);
+    BENCH_REPORT(name, size, threads * OPERATIONS, elapsed);
+    elapsed = run_workers(workers, threads, false, pets, size);
+    if (elapsed < 0) {
+      BENCH_FAIL("locked_map lost a pet\n");
+    }
+    (void) snprintf(name, sizeof(name), "locked_map threads=%zu", threads);
+    BENCH_REPORT(name, size, threads * OPERATIONS, elapsed);
+    sharded_pet_store_free(&sharded_pets);
+    locked_map_free(&locked_pets);
+  }
+  free(pets);
+  free(workers);
+  return BENCH_RESULT_PASS;
+}
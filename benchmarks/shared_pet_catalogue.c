@@ -0,0 +1,118 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <optional.h>
+#include <pet-catalogue-file.h>
+#include <pet-store.h>
+#include "bench.h"
+
+#define PETS 100000
+#define MAX_PROCESSES 8
+
+// Number of lookups (each followed by a purchase) done by each process
+#define ATTEMPTS 1000000
+
+// Looks up random pets and buys them; returns the number of pets bought
+static size_t buy_random_pets(const int *ids, size_t size, uint64_t seed) {
+  size_t sold = 0;
+  for (size_t attempt = 0; attempt < ATTEMPTS; attempt++) {
+    const RESULT(Pet, pet_error) found = find_pet(ids[bench_random(&seed) % size]);
+    const RESULT(Pet, pet_error) bought = RESULT_FLAT_MAP(found, buy_pet);
+    sold += RESULT_IS_SUCCESS(bought);
+  }
+  return sold;
+}
+
+// Makes every pet available again
+static void restock(const int *ids, size_t size) {
+  for (size_t index = 0; index < size; index++) {
+    const RESULT(Pet, pet_error) pet = find_pet(ids[index]);
+    PET_STATUS(RESULT_USE_VALUE(pet)) = AVAILABLE;
+  }
+}
+
+/**
+ * Benchmarks find_pet + buy_pet on a catalogue shared by 1-8 processes.
+ */
+int main(int argc, char *argv[]) {
+  const size_t max_size = BENCH_MAX_SIZE_ARG(argc, argv);
+  const size_t size = max_size < PETS ? max_size : PETS;
+  int *ids = malloc(size * sizeof(int));
+  uint8_t *statuses = calloc(size, 1);
+  const char **names = malloc(size * sizeof(char *));
+  char path[] = "/tmp/pet-catalogue-XXXXXX";
+  const int descriptor = mkstemp(path);
+  if (ids == NULL || statuses == NULL || names == NULL || descriptor < 0) {
+    BENCH_FAIL("Could not set up the catalogue\n");
+  }
+  (void) close(descriptor);
+  for (size_t index = 0; index < size; index++) {
+    ids[index] = 1000 + (int) index;
+    names[index] = "Pet";
+  }
+  if (!pet_catalogue_file_write(path, ids, statuses, names, size)
+      || !open_pet_catalogue(path)) {
+    BENCH_FAIL("Could not open the catalogue\n");
+  }
+  // Private mapping first, as the baseline
+  double start = bench_now();
+  BENCH_CONSUME(buy_random_pets(ids, size, 1));
+  BENCH_REPORT("private catalogue", size, ATTEMPTS, bench_now() - start);
+  restock(ids, size);
+  char name[64];
+  (void) snprintf(name, sizeof(name), "/pet-store-bench-%d", (int) getpid());
+  (void) shm_unlink(name);
+  if (!open_shared_pet_catalogue(name)) {
+    BENCH_FAIL("Could not share the catalogue\n");
+  }
+  for (size_t processes = 1; processes <= MAX_PROCESSES; processes *= 2) {
+    restock(ids, size);
+    start = bench_now();
+    for (size_t index = 0; index < processes; index++) {
+      const pid_t worker = fork();
+      if (worker < 0) {
+        BENCH_FAIL("Could not start a worker\n");
+      }
+      if (worker == 0) {
+        _exit(open_shared_pet_catalogue(name)
+              && buy_random_pets(ids, size, index + 1) > 0 ? 0 : 1);
+      }
+    }
+    int failures = 0;
+    for (size_t index = 0; index < processes; index++) {
+      int status;
+      failures += wait(&status) < 0 || !WIFEXITED(status)
+                  || WEXITSTATUS(status) != 0;
+    }
+    if (failures != 0) {
+      BENCH_FAIL("Some workers failed\n");
+    }
+    char label[64];
+    (void) snprintf(label, sizeof(label), "shared catalogue processes=%zu",
+                    processes);
+    BENCH_REPORT(label, size, processes * ATTEMPTS, bench_now() - start);
+  }
+  (void) shm_unlink(name);
+  (void) remove(path);
+  free(ids);
+  free(statuses);
+  free(names);
+  return BENCH_RESULT_PASS;
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <optional.h>
+#include <strview.h>
+#include "bench.h"
+
+#define LINES 100000
+
+// Fields per line
+#define FIELDS 16
+
+// Longest line (plus its terminator)
+#define LINE_SIZE 256
+
+/**
+ * Benchmarks splitting lines with strview_split_next vs. strdup + strtok_r.
+ */
+int main(int argc, char *argv[]) {
+  const size_t max_size = BENCH_MAX_SIZE_ARG(argc, argv);
+  const size_t size = max_size < LINES ? max_size : LINES;
+  char (*lines)[LINE_SIZE] = malloc(size * LINE_SIZE);
+  if (lines == NULL) {
+    BENCH_FAIL("Out of memory\n");
+  }
+  uint64_t seed = 0x9e3779b97f4a7c15;
+  for (size_t index = 0; index < size; index++) {
+    size_t length = 0;
+    for (size_t field = 0; field < FIELDS; field++) {
+      length += (size_t) snprintf(lines[index] + length, LINE_SIZE - length,
+                                  "%s%llu", field > 0 ? "," : "",
+                                  (unsigned long long) (bench_random(&seed)
+                                                        % 1000000));
+    }
+  }
+  size_t viewed = 0;
+  double start = bench_now();
+  for (size_t index = 0; index < size; index++) {
+    struct strview_splitter splitter = strview_split(strview_of(lines[index]),
+                                                     ',');
+    for (OPTIONAL(strview) token = strview_split_next(&splitter);
+         OPTIONAL_IS_PRESENT(token); token = strview_split_next(&splitter)) {
+      viewed += OPTIONAL_USE_VALUE(token).length;
+    }
+  }
+  BENCH_REPORT("strview_split_next", size, size * FIELDS, bench_now() - start);
+  size_t copied = 0;
+  start = bench_now();
+  for (size_t index = 0; index < size; index++) {
+    char *copy = strdup(lines[index]);
+    char *state = NULL;
+    for (char *token = strtok_r(copy, ",", &state); token != NULL;
+         token = strtok_r(NULL, ",", &state)) {
+      copied += strlen(token);
+    }
+    free(copy);
+  }
+  BENCH_REPORT("strdup + strtok_r", size, size * FIELDS, bench_now() - start);
+  if (viewed != copied) {
+    BENCH_FAIL("The tokenizers disagree\n");
+  }
+  free(lines);
+  return BENCH_RESULT_PASS;
+}
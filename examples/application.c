@@ -19,6 +19,8 @@
 /** [application] */
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include "optional-parse.h"
 #include "pet-store.h"
 
 // Prints pet details
@@ -36,28 +38,29 @@ static void print_error(const pet_error error) {
 
 // Pet store application
 int main(int argc, char *argv[]) {
-  int pet_id;
-  OPTIONAL(Pet) optional;
+  OPTIONAL(int) pet_id;
+  RESULT(Pet, pet_error) result;
 
   if (argc != 1) {
     printf("Error: Please provide one argument (pet ID)\n");
     return EXIT_FAILURE;
   }
 
-  if (sscanf(argv[0], "%d", &pet_id) != 1) {
+  pet_id = optional_parse_int(argv[0], strlen(argv[0]));
+  if (OPTIONAL_IS_EMPTY(pet_id)) {
     printf("Error: Illegal pet ID provided: %s\n", argv[0]);
     return EXIT_FAILURE;
   }
 
-  printf("Finding pet %d...\n", pet_id);
-  optional = find_pet(pet_id);
-  OPTIONAL_IF_PRESENT_OR_ELSE(optional, print_pet, print_error);
+  printf("Finding pet %d...\n", OPTIONAL_USE_VALUE(pet_id));
+  result = find_pet(OPTIONAL_USE_VALUE(pet_id));
+  RESULT_IF_SUCCESS_OR_ELSE(result, print_pet, print_error);
 
   printf("Buying pet...\n");
-  optional = OPTIONAL_FLAT_MAP(optional, buy_pet);
-  OPTIONAL_IF_PRESENT_OR_ELSE(optional, print_pet, print_error);
+  result = RESULT_FLAT_MAP(result, buy_pet);
+  RESULT_IF_SUCCESS_OR_ELSE(result, print_pet, print_error);
 
-  if (OPTIONAL_IS_EMPTY(optional)) {
+  if (RESULT_IS_FAILURE(result)) {
     printf("Sorry!\n");
     return EXIT_FAILURE;
   }
@@ -0,0 +1,135 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdalign.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+// Bump-pointer arena allocator.
+//
+// Allocations are carved out of a list of chunks and are never freed one by
+// one: arena_mark() remembers the current position, arena_rewind() drops
+// everything allocated since a mark, and arena_reset() drops everything,
+// all in constant time. Chunks are kept for reuse after rewinding, and only
+// given back to malloc by arena_free().
+
+// Default size of a chunk (allocations larger than this get one of their own)
+#define ARENA_CHUNK_SIZE (64 * 1024)
+
+struct arena_chunk {
+  struct arena_chunk *next;
+  size_t size;
+  alignas(max_align_t) char memory[];
+};
+
+struct arena {
+  struct arena_chunk *first;
+  struct arena_chunk *current;
+  char *cursor;
+  char *limit;
+  size_t chunk_size;
+};
+
+// Position of an arena to rewind to
+struct arena_mark {
+  struct arena_chunk *chunk;
+  char *cursor;
+};
+
+static inline void arena_init(struct arena *arena, size_t chunk_size) {
+  *arena = (struct arena) {
+    .chunk_size = chunk_size > 0 ? chunk_size : ARENA_CHUNK_SIZE
+  };
+}
+
+static inline void arena_free(struct arena *arena) {
+  while (arena->first != NULL) {
+    struct arena_chunk *chunk = arena->first;
+    arena->first = chunk->next;
+    free(chunk);
+  }
+  arena_init(arena, arena->chunk_size);
+}
+
+static inline void arena_use(struct arena *arena, struct arena_chunk *chunk,
+                             char *cursor) {
+  arena->current = chunk;
+  arena->cursor = cursor;
+  arena->limit = chunk != NULL ? chunk->memory + chunk->size : NULL;
+}
+
+// Moves on to the chunk after the current one, reusing it if it is large
+// enough, or inserting a new one there
+static inline bool arena_grow(struct arena *arena, size_t size) {
+  struct arena_chunk *next = arena->current != NULL
+                           ? arena->current->next : arena->first;
+  if (next == NULL || next->size < size) {
+    const size_t chunk_size = size > arena->chunk_size
+                            ? size : arena->chunk_size;
+    struct arena_chunk *chunk = malloc(sizeof(struct arena_chunk)
+                                       + chunk_size);
+    if (chunk == NULL) {
+      return false;
+    }
+    chunk->size = chunk_size;
+    chunk->next = next;
+    if (arena->current != NULL) {
+      arena->current->next = chunk;
+    } else {
+      arena->first = chunk;
+    }
+    next = chunk;
+  }
+  arena_use(arena, next, next->memory);
+  return true;
+}
+
+// Returns uninitialized memory suitably aligned for any type, or NULL
+static inline void *arena_alloc(struct arena *arena, size_t size) {
+  const size_t alignment = alignof(max_align_t);
+  size = (size + alignment - 1) / alignment * alignment;
+  if (arena->cursor == NULL
+      || (size_t) (arena->limit - arena->cursor) < size) {
+    if (!arena_grow(arena, size)) {
+      return NULL;
+    }
+  }
+  void *memory = arena->cursor;
+  arena->cursor += size;
+  return memory;
+}
+
+static inline struct arena_mark arena_mark(const struct arena *arena) {
+  return (struct arena_mark) {.chunk = arena->current, .cursor = arena->cursor};
+}
+
+// Drops everything allocated since the supplied mark was taken
+static inline void arena_rewind(struct arena *arena, struct arena_mark mark) {
+  arena_use(arena, mark.chunk, mark.cursor);
+}
+
+// Drops everything allocated so far
+static inline void arena_reset(struct arena *arena) {
+  arena_use(arena, arena->first,
+            arena->first != NULL ? arena->first->memory : NULL);
+}
+
+#endif
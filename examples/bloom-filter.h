@@ -0,0 +1,142 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef BLOOM_FILTER_H
+#define BLOOM_FILTER_H
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <optional.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// Split-block Bloom filter.
+//
+// Every key maps to one 256-bit block, and sets one bit in each of the eight
+// 32-bit words of that block. Checking a key touches a single cache line and
+// the eight words can be tested at once with SIMD instructions.
+
+#define BLOOM_FILTER_WORDS 8
+
+struct bloom_filter_block {
+  uint32_t words[BLOOM_FILTER_WORDS];
+};
+
+struct bloom_filter {
+  size_t blocks;
+  struct bloom_filter_block *data;
+};
+
+// Odd constants that pick one bit per word
+static const uint32_t bloom_filter_salts[BLOOM_FILTER_WORDS] = {
+  0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+  0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U
+};
+
+// Returns true if a false-positive rate can be achieved (strictly between
+// zero and one)
+static inline bool bloom_filter_valid_fpp(double fpp) {
+  return fpp > 0.0 && fpp < 1.0;
+}
+
+// Returns the number of bytes needed for a false-positive rate and capacity
+// (zero if the rate is not valid, SIZE_MAX if it is too much to allocate)
+static inline size_t bloom_filter_bytes(size_t capacity, double fpp) {
+  if (!bloom_filter_valid_fpp(fpp)) {
+    return 0;
+  }
+  const double bits = -(double) BLOOM_FILTER_WORDS * (double) capacity
+                    / log1p(-pow(fpp, 1.0 / BLOOM_FILTER_WORDS));
+  const double blocks = bits / 256.0 + 1.0;
+  if (!(blocks < (double) (SIZE_MAX / sizeof(struct bloom_filter_block)))) {
+    return SIZE_MAX;
+  }
+  return (size_t) blocks * sizeof(struct bloom_filter_block);
+}
+
+// Creates a filter for the given capacity and false-positive rate (strictly
+// between zero and one), using at most `max_bytes` of memory (at the expense
+// of more false positives)
+static inline bool bloom_filter_init(struct bloom_filter *filter,
+                                     size_t capacity, double fpp,
+                                     size_t max_bytes) {
+  size_t bytes = bloom_filter_bytes(capacity, fpp);
+  if (bytes > max_bytes) {
+    bytes = max_bytes;
+  }
+  filter->blocks = bytes / sizeof(struct bloom_filter_block);
+  if (filter->blocks == 0) {
+    filter->data = NULL;
+    return false;
+  }
+  filter->data = aligned_alloc(sizeof(struct bloom_filter_block),
+                               filter->blocks
+                               * sizeof(struct bloom_filter_block));
+  if (filter->data != NULL) {
+    memset(filter->data, 0, filter->blocks * sizeof(struct bloom_filter_block));
+  }
+  return filter->data != NULL;
+}
+
+static inline void bloom_filter_free(struct bloom_filter *filter) {
+  free(filter->data);
+  filter->data = NULL;
+  filter->blocks = 0;
+}
+
+// Returns the block of a hashed key
+static inline struct bloom_filter_block *bloom_filter_block(
+    const struct bloom_filter *filter, uint64_t hash) {
+  return &filter->data[((hash >> 32) * filter->blocks) >> 32];
+}
+
+static inline void bloom_filter_add(struct bloom_filter *filter,
+                                    uint64_t hash) {
+  struct bloom_filter_block *block = bloom_filter_block(filter, hash);
+  for (int word = 0; word < BLOOM_FILTER_WORDS; word++) {
+    block->words[word] |= 1U << (((uint32_t) hash
+                                  * bloom_filter_salts[word]) >> 27);
+  }
+}
+
+// Returns false if the key was definitely never added
+static inline bool bloom_filter_may_contain(const struct bloom_filter *filter,
+                                            uint64_t hash) {
+  const struct bloom_filter_block *block = bloom_filter_block(filter, hash);
+#ifdef __AVX2__
+  const __m256i salts = _mm256_loadu_si256(
+    (const __m256i *) bloom_filter_salts);
+  const __m256i shifts = _mm256_srli_epi32(
+    _mm256_mullo_epi32(_mm256_set1_epi32((int) (uint32_t) hash), salts), 27);
+  const __m256i bits = _mm256_sllv_epi32(_mm256_set1_epi32(1), shifts);
+  return _mm256_testc_si256(
+    _mm256_load_si256((const __m256i *) block->words), bits);
+#else
+  uint32_t missing = 0;
+  for (int word = 0; word < BLOOM_FILTER_WORDS; word++) {
+    const uint32_t bit = 1U << (((uint32_t) hash
+                                 * bloom_filter_salts[word]) >> 27);
+    missing |= ~block->words[word] & bit;
+  }
+  return missing == 0;
+#endif
+}
+
+#endif
@@ -0,0 +1,150 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef EPOCH_RECLAMATION_H
+#define EPOCH_RECLAMATION_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+// Epoch-based reclamation.
+//
+// Readers announce the global epoch while they hold references to shared
+// objects, and announce zero when they are done. Writers retire the objects
+// they unlink; a retired object is freed once the global epoch is two ahead
+// of the epoch it was retired in, because by then no reader can still be
+// holding a reference to it. The global epoch only advances when every
+// active reader has announced the current one.
+
+// Maximum number of threads that can read concurrently
+#define EPOCH_MAX_READERS 128
+
+// Announced epoch of a reader thread (on a cache line of its own)
+struct epoch_reader {
+  _Alignas(64) atomic_ulong epoch;
+  atomic_bool taken;
+};
+
+// Object waiting to be freed (embedded in the retired object itself)
+struct epoch_node {
+  struct epoch_node *next;
+  unsigned long epoch;
+  void *pointer;
+};
+
+struct epoch_domain {
+  atomic_ulong epoch;
+  struct epoch_reader readers[EPOCH_MAX_READERS];
+  pthread_mutex_t lock;
+  struct epoch_node *retired;
+};
+
+static inline bool epoch_init(struct epoch_domain *domain) {
+  atomic_init(&domain->epoch, 1);
+  for (size_t index = 0; index < EPOCH_MAX_READERS; index++) {
+    atomic_init(&domain->readers[index].epoch, 0);
+    atomic_init(&domain->readers[index].taken, false);
+  }
+  domain->retired = NULL;
+  return pthread_mutex_init(&domain->lock, NULL) == 0;
+}
+
+// Frees every retired object (no reader may be active)
+static inline void epoch_free(struct epoch_domain *domain) {
+  while (domain->retired != NULL) {
+    struct epoch_node *node = domain->retired;
+    domain->retired = node->next;
+    free(node->pointer);
+  }
+  (void) pthread_mutex_destroy(&domain->lock);
+}
+
+// Returns the announcement slot of a new reader thread, or NULL
+static inline struct epoch_reader *epoch_register(struct epoch_domain *domain) {
+  for (size_t index = 0; index < EPOCH_MAX_READERS; index++) {
+    bool taken = false;
+    if (atomic_compare_exchange_strong(&domain->readers[index].taken, &taken,
+                                       true)) {
+      return &domain->readers[index];
+    }
+  }
+  return NULL;
+}
+
+static inline void epoch_unregister(struct epoch_reader *reader) {
+  atomic_store_explicit(&reader->epoch, 0, memory_order_release);
+  atomic_store_explicit(&reader->taken, false, memory_order_release);
+}
+
+// Starts a read-side critical section
+static inline void epoch_enter(struct epoch_domain *domain,
+                               struct epoch_reader *reader) {
+  atomic_store_explicit(&reader->epoch,
+                        atomic_load_explicit(&domain->epoch,
+                                             memory_order_relaxed),
+                        memory_order_relaxed);
+  // The announcement must be visible before any shared object is read
+  atomic_thread_fence(memory_order_seq_cst);
+}
+
+// Ends a read-side critical section
+static inline void epoch_exit(struct epoch_reader *reader) {
+  atomic_store_explicit(&reader->epoch, 0, memory_order_release);
+}
+
+// Advances the global epoch if possible and frees what is safe to free
+// (the caller must hold the lock of the domain)
+static inline void epoch_collect(struct epoch_domain *domain) {
+  // Unlinking must be visible before the announcements are checked
+  atomic_thread_fence(memory_order_seq_cst);
+  unsigned long epoch = atomic_load_explicit(&domain->epoch,
+                                             memory_order_relaxed);
+  bool quiescent = true;
+  for (size_t index = 0; quiescent && index < EPOCH_MAX_READERS; index++) {
+    const unsigned long announced = atomic_load_explicit(
+      &domain->readers[index].epoch, memory_order_acquire);
+    quiescent = announced == 0 || announced == epoch;
+  }
+  if (quiescent) {
+    atomic_store_explicit(&domain->epoch, ++epoch, memory_order_release);
+  }
+  for (struct epoch_node **node = &domain->retired; *node != NULL;) {
+    struct epoch_node *retired = *node;
+    if (retired->epoch + 2 <= epoch) {
+      *node = retired->next;
+      free(retired->pointer);
+    } else {
+      node = &retired->next;
+    }
+  }
+}
+
+// Schedules an object that readers can no longer reach to be freed
+static inline void epoch_retire(struct epoch_domain *domain,
+                                struct epoch_node *node, void *pointer) {
+  (void) pthread_mutex_lock(&domain->lock);
+  node->epoch = atomic_load_explicit(&domain->epoch, memory_order_relaxed);
+  node->pointer = pointer;
+  node->next = domain->retired;
+  domain->retired = node;
+  epoch_collect(domain);
+  (void) pthread_mutex_unlock(&domain->lock);
+}
+
+#endif
@@ -19,6 +19,7 @@
 #include <assert.h>
 #include <optional.h>
 #include <stdio.h>
+#include "arena.h"
 #include "pet-store.h"
 
 int pet_store_application(int argc, char *argv[]);
@@ -50,9 +51,40 @@ static void log_error(pet_error error) {
     last_error = error;
 }
 
+// Returns a copy of a pet, allocated in the supplied arena
+static Pet copy_pet_in(struct arena *arena, Pet pet) {
+    Pet copy = arena_alloc(arena, sizeof(struct pet));
+    if (copy != NULL) {
+        *copy = (struct pet) {.id = PET_ID(pet), .name = PET_NAME(pet), .status = PET_STATUS(pet)};
+    }
+    return copy;
+}
+
+// Returns a copy of a pet, allocated in the supplied arena, if it is available
+static OPTIONAL(Pet) copy_available_pet_in(struct arena *arena, Pet pet) {
+    if (PET_STATUS(pet) != AVAILABLE) {
+        return (OPTIONAL(Pet)) OPTIONAL_EMPTY;
+    }
+    Pet copy = copy_pet_in(arena, pet);
+    return (OPTIONAL(Pet)) OPTIONAL_OF_NULLABLE(copy);
+}
+
+// Buys a pet, regardless of the reason why it can't be bought
+static OPTIONAL(Pet) try_buy_pet(Pet pet) {
+    RESULT(Pet, pet_error) result = buy_pet(pet);
+    return RESULT_TO_OPTIONAL(result, OPTIONAL(Pet));
+}
+
+// Initializes a pet in place
+static bool new_default_pet(Pet pet) {
+    *pet = (struct pet) {.id = 100, .name = "Default pet", .status = AVAILABLE};
+    return true;
+}
+
 // Returns the status of a pet by id
 OPTIONAL(pet_status) get_pet_status(int id) {
-    OPTIONAL(Pet) optional = find_pet(id);
+    RESULT(Pet, pet_error) result = find_pet(id);
+    OPTIONAL(Pet) optional = RESULT_TO_OPTIONAL(result, OPTIONAL(Pet));
     return OPTIONAL_MAP(optional, PET_STATUS, OPTIONAL(pet_status));
 }
 
@@ -229,12 +261,38 @@ assert(OPTIONAL_USE_VALUE(mapped) == SOLD);
 //! [optional_flat_map]
 struct pet sold = {.status = SOLD};
 OPTIONAL(Pet) optional = OPTIONAL_PRESENT(&sold);
-OPTIONAL(Pet) mapped = OPTIONAL_FLAT_MAP(optional, buy_pet);
+OPTIONAL(Pet) mapped = OPTIONAL_FLAT_MAP(optional, try_buy_pet);
 assert(OPTIONAL_IS_EMPTY(mapped));
 //! [optional_flat_map]
         (void) mapped;
     }
 
+    {
+//! [optional_map_in]
+struct arena arena;
+arena_init(&arena, ARENA_CHUNK_SIZE);
+struct pet snoopy = {.id = 1, .name = "Snoopy"};
+OPTIONAL(Pet) optional = OPTIONAL_PRESENT(&snoopy);
+OPTIONAL(Pet) mapped = OPTIONAL_MAP_IN(optional, &arena, copy_pet_in, OPTIONAL(Pet));
+assert(strcmp(PET_NAME(OPTIONAL_USE_VALUE(mapped)), "Snoopy") == 0);
+arena_free(&arena);
+//! [optional_map_in]
+        (void) mapped;
+    }
+
+    {
+//! [optional_flat_map_in]
+struct arena arena;
+arena_init(&arena, ARENA_CHUNK_SIZE);
+struct pet sold = {.status = SOLD};
+OPTIONAL(Pet) optional = OPTIONAL_PRESENT(&sold);
+OPTIONAL(Pet) mapped = OPTIONAL_FLAT_MAP_IN(optional, &arena, copy_available_pet_in);
+assert(OPTIONAL_IS_EMPTY(mapped));
+arena_free(&arena);
+//! [optional_flat_map_in]
+        (void) mapped;
+    }
+
     {
 //! [optional_or]
 OPTIONAL(Pet) optional = OPTIONAL_EMPTY;
@@ -244,6 +302,49 @@ assert(strcmp(PET_NAME(OPTIONAL_USE_VALUE(mapped)), "Default pet") == 0);
         (void) mapped;
     }
 
+    {
+//! [optional_take]
+struct pet snoopy = {.name = "Snoopy"};
+OPTIONAL(Pet) optional = OPTIONAL_PRESENT(&snoopy);
+OPTIONAL(Pet) taken = OPTIONAL_TAKE(optional);
+assert(OPTIONAL_IS_EMPTY(optional));
+assert(OPTIONAL_USE_VALUE(taken) == &snoopy);
+//! [optional_take]
+        (void) taken;
+    }
+
+    {
+//! [optional_replace]
+struct pet snoopy = {.name = "Snoopy"};
+struct pet garfield = {.name = "Garfield"};
+OPTIONAL(Pet) optional = OPTIONAL_PRESENT(&snoopy);
+OPTIONAL(Pet) replaced = OPTIONAL_REPLACE(optional, &garfield);
+assert(OPTIONAL_USE_VALUE(optional) == &garfield);
+assert(OPTIONAL_USE_VALUE(replaced) == &snoopy);
+//! [optional_replace]
+        (void) replaced;
+    }
+
+    {
+//! [optional_swap]
+struct pet snoopy = {.name = "Snoopy"};
+OPTIONAL(Pet) optional1 = OPTIONAL_PRESENT(&snoopy);
+OPTIONAL(Pet) optional2 = OPTIONAL_EMPTY;
+OPTIONAL_SWAP(optional1, optional2);
+assert(OPTIONAL_IS_EMPTY(optional1));
+assert(OPTIONAL_USE_VALUE(optional2) == &snoopy);
+//! [optional_swap]
+    }
+
+    {
+//! [optional_emplace]
+OPTIONAL_STRUCT_TAG(struct pet, optional_pet_value) optional = OPTIONAL_EMPTY;
+bool present = OPTIONAL_EMPLACE(optional, new_default_pet);
+assert(present && PET_ID(&OPTIONAL_USE_VALUE(optional)) == 100);
+//! [optional_emplace]
+        (void) present;
+    }
+
     {
         OPTIONAL(pet_status) optional1 = get_pet_status(0);
         assert(OPTIONAL_IS_PRESENT(optional1));
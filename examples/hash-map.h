@@ -0,0 +1,234 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HASH_MAP_H
+#define HASH_MAP_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <optional.h>
+
+// Generic open-addressing hash map with Robin Hood probing.
+//
+// HASH_MAP(name, key_type, value_type, hash, equals) generates:
+//
+//   struct name
+//   bool name_init(struct name *map, size_t capacity)
+//   void name_free(struct name *map)
+//   bool name_put(struct name *map, key_type key, value_type value)
+//   OPTIONAL(value_type) name_get(const struct name *map, key_type key)
+//   OPTIONAL(value_type) name_remove(struct name *map, key_type key)
+//   void name_get_batch(const struct name *map, const key_type *keys,
+//                       size_t count, OPTIONAL(value_type) *values)
+//   size_t name_values(const struct name *map, value_type *values)
+//
+// OPTIONAL_STRUCT(value_type) must be declared beforehand.
+
+// Minimum number of slots of a hash map
+#define HASH_MAP_MIN_CAPACITY 8
+
+// Maximum number of entries a hash map can hold before growing (7/8 load)
+#define HASH_MAP_MAX_LOAD(slots) ((slots) - (slots) / 8)
+
+// Number of lookups whose cache misses are overlapped by batched gets
+#define HASH_MAP_BATCH_SIZE 16
+
+// Hashes an integer key (SplitMix64 finalizer)
+static inline uint64_t hash_map_hash_int(int key) {
+  uint64_t hash = (uint64_t) (unsigned int) key;
+  hash = (hash ^ (hash >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+  hash = (hash ^ (hash >> 27)) * UINT64_C(0x94d049bb133111eb);
+  return hash ^ (hash >> 31);
+}
+
+// Hashes a string (FNV-1a, followed by the same finalizer)
+static inline uint64_t hash_map_hash_string(const char *key) {
+  uint64_t hash = UINT64_C(0xcbf29ce484222325);
+  for (; *key != '\0'; key++) {
+    hash = (hash ^ (unsigned char) *key) * UINT64_C(0x100000001b3);
+  }
+  hash = (hash ^ (hash >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+  hash = (hash ^ (hash >> 27)) * UINT64_C(0x94d049bb133111eb);
+  return hash ^ (hash >> 31);
+}
+
+// Compares two integer keys
+#define hash_map_equals_int(a, b) ((a) == (b))
+
+#define HASH_MAP(name, key_type, value_type, hash, equals)                    \
+                                                                              \
+  /* A slot is empty if its distance is zero; otherwise it holds an entry  */ \
+  /* which is (distance - 1) slots away from its home slot                 */ \
+  struct name##_slot {                                                        \
+    uint32_t distance;                                                        \
+    key_type key;                                                             \
+    value_type value;                                                         \
+  };                                                                          \
+                                                                              \
+  struct name {                                                               \
+    size_t count;                                                             \
+    size_t mask;                                                              \
+    struct name##_slot *slots;                                                \
+  };                                                                          \
+                                                                              \
+  static inline bool name##_init(struct name *map, size_t capacity) {         \
+    size_t slots = HASH_MAP_MIN_CAPACITY;                                     \
+    while (HASH_MAP_MAX_LOAD(slots) < capacity) {                             \
+      slots *= 2;                                                             \
+    }                                                                         \
+    map->count = 0;                                                           \
+    map->mask = slots - 1;                                                    \
+    map->slots = calloc(slots, sizeof(struct name##_slot));                   \
+    return map->slots != NULL;                                                \
+  }                                                                           \
+                                                                              \
+  static inline void name##_free(struct name *map) {                          \
+    free(map->slots);                                                         \
+    map->slots = NULL;                                                        \
+    map->count = 0;                                                           \
+    map->mask = 0;                                                            \
+  }                                                                           \
+                                                                              \
+  /* Inserts an entry known not to be in the map yet */                       \
+  static inline void name##_insert(struct name *map,                          \
+                                   struct name##_slot entry, size_t index) {  \
+    for (;; index = (index + 1) & map->mask, entry.distance++) {              \
+      struct name##_slot *slot = &map->slots[index];                          \
+      if (slot->distance == 0) {                                              \
+        *slot = entry;                                                        \
+        map->count++;                                                         \
+        return;                                                               \
+      }                                                                       \
+      if (slot->distance < entry.distance) {                                  \
+        struct name##_slot displaced = *slot;                                 \
+        *slot = entry;                                                        \
+        entry = displaced;                                                    \
+      }                                                                       \
+    }                                                                         \
+  }                                                                           \
+                                                                              \
+  static inline bool name##_grow(struct name *map) {                          \
+    struct name old = *map;                                                   \
+    if (!name##_init(map, old.mask + 1)) {                                    \
+      *map = old;                                                             \
+      return false;                                                           \
+    }                                                                         \
+    for (size_t index = 0; index <= old.mask; index++) {                      \
+      struct name##_slot entry = old.slots[index];                            \
+      if (entry.distance != 0) {                                              \
+        entry.distance = 1;                                                   \
+        name##_insert(map, entry, (size_t) (hash(entry.key)) & map->mask);    \
+      }                                                                       \
+    }                                                                         \
+    free(old.slots);                                                          \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  /* Returns the slot holding the supplied key, or NULL */                    \
+  static inline struct name##_slot *name##_find(const struct name *map,       \
+                                                key_type key) {               \
+    size_t index = (size_t) (hash(key)) & map->mask;                          \
+    for (uint32_t distance = 1;; distance++) {                                \
+      struct name##_slot *slot = &map->slots[index];                          \
+      if (slot->distance < distance) {                                        \
+        return NULL;                                                          \
+      }                                                                       \
+      if (slot->distance == distance && equals(slot->key, key)) {             \
+        return slot;                                                          \
+      }                                                                       \
+      index = (index + 1) & map->mask;                                        \
+    }                                                                         \
+  }                                                                           \
+                                                                              \
+  static inline bool name##_put(struct name *map, key_type key,               \
+                                value_type value) {                           \
+    struct name##_slot *slot = name##_find(map, key);                         \
+    if (slot != NULL) {                                                       \
+      slot->value = value;                                                    \
+      return true;                                                            \
+    }                                                                         \
+    bool full = map->count >= HASH_MAP_MAX_LOAD(map->mask + 1);               \
+    if (full && !name##_grow(map)) {                                          \
+      return false;                                                           \
+    }                                                                         \
+    struct name##_slot entry = {.distance = 1, .key = key, .value = value};   \
+    name##_insert(map, entry, (size_t) (hash(key)) & map->mask);              \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  static inline OPTIONAL(value_type) name##_get(const struct name *map,       \
+                                                key_type key) {               \
+    const struct name##_slot *slot = name##_find(map, key);                   \
+    if (slot == NULL) {                                                       \
+      return (OPTIONAL(value_type)) OPTIONAL_EMPTY;                           \
+    }                                                                         \
+    return (OPTIONAL(value_type)) OPTIONAL_PRESENT(slot->value);              \
+  }                                                                           \
+                                                                              \
+  /* Looks up many keys, prefetching the home slots of a group at a time */   \
+  static inline void name##_get_batch(const struct name *map,                 \
+                                      const key_type *keys, size_t count,     \
+                                      OPTIONAL(value_type) *values) {         \
+    for (size_t first = 0; first < count; first += HASH_MAP_BATCH_SIZE) {     \
+      const size_t last = first + HASH_MAP_BATCH_SIZE < count                 \
+                        ? first + HASH_MAP_BATCH_SIZE : count;                \
+      for (size_t index = first; index < last; index++) {                     \
+        __builtin_prefetch(                                                   \
+          &map->slots[(size_t) (hash(keys[index])) & map->mask]);             \
+      }                                                                       \
+      for (size_t index = first; index < last; index++) {                     \
+        values[index] = name##_get(map, keys[index]);                         \
+      }                                                                       \
+    }                                                                         \
+  }                                                                           \
+                                                                              \
+  /* Removes an entry by shifting the following ones back (no tombstones) */  \
+  static inline OPTIONAL(value_type) name##_remove(struct name *map,          \
+                                                   key_type key) {            \
+    struct name##_slot *slot = name##_find(map, key);                         \
+    if (slot == NULL) {                                                       \
+      return (OPTIONAL(value_type)) OPTIONAL_EMPTY;                           \
+    }                                                                         \
+    OPTIONAL(value_type) removed = OPTIONAL_PRESENT(slot->value);             \
+    size_t index = (size_t) (slot - map->slots);                              \
+    for (;;) {                                                                \
+      size_t next = (index + 1) & map->mask;                                  \
+      if (map->slots[next].distance <= 1) {                                   \
+        break;                                                                \
+      }                                                                       \
+      map->slots[index] = map->slots[next];                                   \
+      map->slots[index].distance--;                                           \
+      index = next;                                                           \
+    }                                                                         \
+    map->slots[index].distance = 0;                                           \
+    map->count--;                                                             \
+    return removed;                                                           \
+  }                                                                           \
+                                                                              \
+  /* Copies all values into the supplied array; returns how many there are */ \
+  static inline size_t name##_values(const struct name *map,                  \
+                                     value_type *values) {                    \
+    size_t count = 0;                                                         \
+    for (size_t index = 0; map->slots != NULL && index <= map->mask;          \
+         index++) {                                                           \
+      if (map->slots[index].distance != 0) {                                  \
+        values[count++] = map->slots[index].value;                            \
+      }                                                                       \
+    }                                                                         \
+    return count;                                                             \
+  }
+
+#endif
@@ -0,0 +1,267 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef ITERATOR_H
+#define ITERATOR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <optional.h>
+#include "strview.h"
+
+// Lazy iterators over optionals.
+//
+// An iterator `name` is a `struct name` plus a function
+//
+//   OPTIONAL(type) name_next(struct name *iterator)
+//
+// that returns the next value, or an empty optional at the end of the
+// stream. The macros below generate sources and combinators; every
+// combinator holds its source by value and calls its static inline next
+// function, so a whole chain is inlined into the loop that consumes it
+// instead of materializing every stage. Each generated iterator comes with
+// a constructor, name_of(...), and OPTIONAL_STRUCT(type) must be declared
+// beforehand for every type that flows through it.
+//
+//   ITERATOR_ARRAY(name, type)
+//     name_of(const type *items, size_t count)
+//   ITERATOR_OPTIONAL_ARRAY(name, type)
+//     name_of(const OPTIONAL(type) *items, size_t count) (skips empties)
+//   ITERATOR_MAP(name, input, input_type, type, mapper)
+//     name_of(struct input source)
+//   ITERATOR_FILTER(name, input, type, predicate)
+//     name_of(struct input source)
+//   ITERATOR_TAKE(name, input, type)
+//     name_of(struct input source, size_t count)
+//   ITERATOR_SKIP(name, input, type)
+//     name_of(struct input source, size_t count)
+//   ITERATOR_ZIP(name, left, left_type, right, right_type, pair_type)
+//     name_of(struct left first, struct right second)
+//     (pair_type must have members `first` and `second`)
+//   ITERATOR_CHAIN(name, left, right, type)
+//     name_of(struct left first, struct right second)
+//
+// struct line_iterator is a source of the lines of a file, as views.
+
+#define ITERATOR_ARRAY(name, type)                                            \
+  struct name {                                                               \
+    const type *items;                                                        \
+    size_t count;                                                             \
+    size_t index;                                                             \
+  };                                                                          \
+                                                                              \
+  static inline struct name name##_of(const type *items, size_t count) {      \
+    return (struct name) {.items = items, .count = count, .index = 0};        \
+  }                                                                           \
+                                                                              \
+  static inline OPTIONAL(type) name##_next(struct name *iterator) {           \
+    if (iterator->index == iterator->count) {                                 \
+      return (OPTIONAL(type)) OPTIONAL_EMPTY;                                 \
+    }                                                                         \
+    return (OPTIONAL(type)) OPTIONAL_PRESENT(                                 \
+      iterator->items[iterator->index++]);                                    \
+  }
+
+#define ITERATOR_OPTIONAL_ARRAY(name, type)                                   \
+  struct name {                                                               \
+    const OPTIONAL(type) *items;                                              \
+    size_t count;                                                             \
+    size_t index;                                                             \
+  };                                                                          \
+                                                                              \
+  static inline struct name name##_of(const OPTIONAL(type) *items,            \
+                                      size_t count) {                         \
+    return (struct name) {.items = items, .count = count, .index = 0};        \
+  }                                                                           \
+                                                                              \
+  static inline OPTIONAL(type) name##_next(struct name *iterator) {           \
+    while (iterator->index < iterator->count) {                               \
+      const OPTIONAL(type) item = iterator->items[iterator->index++];         \
+      if (OPTIONAL_IS_PRESENT(item)) {                                        \
+        return item;                                                          \
+      }                                                                       \
+    }                                                                         \
+    return (OPTIONAL(type)) OPTIONAL_EMPTY;                                   \
+  }
+
+#define ITERATOR_MAP(name, input, input_type, type, mapper)                   \
+  struct name {                                                               \
+    struct input source;                                                      \
+  };                                                                          \
+                                                                              \
+  static inline struct name name##_of(struct input source) {                  \
+    return (struct name) {.source = source};                                  \
+  }                                                                           \
+                                                                              \
+  static inline OPTIONAL(type) name##_next(struct name *iterator) {           \
+    const OPTIONAL(input_type) item = input##_next(&iterator->source);        \
+    if (OPTIONAL_IS_EMPTY(item)) {                                            \
+      return (OPTIONAL(type)) OPTIONAL_EMPTY;                                 \
+    }                                                                         \
+    return (OPTIONAL(type)) OPTIONAL_PRESENT(                                 \
+      mapper(OPTIONAL_USE_VALUE(item)));                                      \
+  }
+
+#define ITERATOR_FILTER(name, input, type, predicate)                         \
+  struct name {                                                               \
+    struct input source;                                                      \
+  };                                                                          \
+                                                                              \
+  static inline struct name name##_of(struct input source) {                  \
+    return (struct name) {.source = source};                                  \
+  }                                                                           \
+                                                                              \
+  static inline OPTIONAL(type) name##_next(struct name *iterator) {           \
+    for (;;) {                                                                \
+      const OPTIONAL(type) item = input##_next(&iterator->source);            \
+      if (OPTIONAL_IS_EMPTY(item) || predicate(OPTIONAL_USE_VALUE(item))) {   \
+        return item;                                                          \
+      }                                                                       \
+    }                                                                         \
+  }
+
+#define ITERATOR_TAKE(name, input, type)                                      \
+  struct name {                                                               \
+    struct input source;                                                      \
+    size_t remaining;                                                         \
+  };                                                                          \
+                                                                              \
+  static inline struct name name##_of(struct input source, size_t count) {    \
+    return (struct name) {.source = source, .remaining = count};              \
+  }                                                                           \
+                                                                              \
+  static inline OPTIONAL(type) name##_next(struct name *iterator) {           \
+    if (iterator->remaining == 0) {                                           \
+      return (OPTIONAL(type)) OPTIONAL_EMPTY;                                 \
+    }                                                                         \
+    iterator->remaining--;                                                    \
+    return input##_next(&iterator->source);                                   \
+  }
+
+#define ITERATOR_SKIP(name, input, type)                                      \
+  struct name {                                                               \
+    struct input source;                                                      \
+    size_t skipped;                                                           \
+  };                                                                          \
+                                                                              \
+  static inline struct name name##_of(struct input source, size_t count) {    \
+    return (struct name) {.source = source, .skipped = count};                \
+  }                                                                           \
+                                                                              \
+  static inline OPTIONAL(type) name##_next(struct name *iterator) {           \
+    for (; iterator->skipped > 0; iterator->skipped--) {                      \
+      if (OPTIONAL_IS_EMPTY(input##_next(&iterator->source))) {               \
+        iterator->skipped = 0;                                                \
+        return (OPTIONAL(type)) OPTIONAL_EMPTY;                               \
+      }                                                                       \
+    }                                                                         \
+    return input##_next(&iterator->source);                                   \
+  }
+
+#define ITERATOR_ZIP(name, left, left_type, right, right_type, pair_type)     \
+  struct name {                                                               \
+    struct left first;                                                        \
+    struct right second;                                                      \
+  };                                                                          \
+                                                                              \
+  static inline struct name name##_of(struct left first,                      \
+                                      struct right second) {                  \
+    return (struct name) {.first = first, .second = second};                  \
+  }                                                                           \
+                                                                              \
+  static inline OPTIONAL(pair_type) name##_next(struct name *iterator) {      \
+    const OPTIONAL(left_type) a = left##_next(&iterator->first);              \
+    if (OPTIONAL_IS_EMPTY(a)) {                                               \
+      return (OPTIONAL(pair_type)) OPTIONAL_EMPTY;                            \
+    }                                                                         \
+    const OPTIONAL(right_type) b = right##_next(&iterator->second);           \
+    if (OPTIONAL_IS_EMPTY(b)) {                                               \
+      return (OPTIONAL(pair_type)) OPTIONAL_EMPTY;                            \
+    }                                                                         \
+    const pair_type pair = {                                                  \
+      .first = OPTIONAL_USE_VALUE(a),                                         \
+      .second = OPTIONAL_USE_VALUE(b)                                         \
+    };                                                                        \
+    return (OPTIONAL(pair_type)) OPTIONAL_PRESENT(pair);                      \
+  }
+
+#define ITERATOR_CHAIN(name, left, right, type)                               \
+  struct name {                                                               \
+    struct left first;                                                        \
+    struct right second;                                                      \
+    bool first_done;                                                          \
+  };                                                                          \
+                                                                              \
+  static inline struct name name##_of(struct left first,                      \
+                                      struct right second) {                  \
+    return (struct name) {                                                    \
+      .first = first,                                                         \
+      .second = second,                                                       \
+      .first_done = false                                                     \
+    };                                                                        \
+  }                                                                           \
+                                                                              \
+  static inline OPTIONAL(type) name##_next(struct name *iterator) {           \
+    if (!iterator->first_done) {                                              \
+      const OPTIONAL(type) item = left##_next(&iterator->first);              \
+      if (OPTIONAL_IS_PRESENT(item)) {                                        \
+        return item;                                                          \
+      }                                                                       \
+      iterator->first_done = true;                                            \
+    }                                                                         \
+    return right##_next(&iterator->second);                                   \
+  }
+
+// Lines of a file, without their line terminators; a line is only valid
+// until the next one is read (the buffer is reused, and only grows when a
+// line doesn't fit)
+struct line_iterator {
+  FILE *file;
+  char *buffer;
+  size_t size;
+};
+
+static inline struct line_iterator line_iterator_of(FILE *file) {
+  return (struct line_iterator) {.file = file, .buffer = NULL, .size = 0};
+}
+
+static inline OPTIONAL(strview) line_iterator_next(
+    struct line_iterator *iterator) {
+  const ssize_t length = getline(&iterator->buffer, &iterator->size,
+                                 iterator->file);
+  if (length < 0) {
+    return (OPTIONAL(strview)) OPTIONAL_EMPTY;
+  }
+  strview line = {.data = iterator->buffer, .length = (size_t) length};
+  if (line.length > 0 && line.data[line.length - 1] == '\n') {
+    line.length--;
+  }
+  if (line.length > 0 && line.data[line.length - 1] == '\r') {
+    line.length--;
+  }
+  return (OPTIONAL(strview)) OPTIONAL_PRESENT(line);
+}
+
+static inline void line_iterator_free(struct line_iterator *iterator) {
+  free(iterator->buffer);
+  iterator->buffer = NULL;
+  iterator->size = 0;
+}
+
+#endif
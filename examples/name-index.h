@@ -0,0 +1,245 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef NAME_INDEX_H
+#define NAME_INDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hash-map.h"
+#include "pet-store.h"
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Index of pets by name.
+//
+// Exact lookups go through an open-addressing table. Every slot keeps the
+// first 16 bytes of the name, its length and 32 bits of its hash next to the
+// pet, so most mismatches are rejected with a single SIMD comparison and
+// only candidates that pass it compare the rest of the name with memcmp.
+//
+// Case-insensitive and prefix searches go through a second array of the pets
+// sorted by case-folded name (ASCII only).
+
+// Number of name bytes kept in every slot
+#define NAME_INDEX_PREFIX 16
+
+// Slot of the exact-lookup table (the first 24 bytes are compared at once)
+struct name_index_slot {
+  char prefix[NAME_INDEX_PREFIX];
+  uint32_t length;
+  uint32_t tag;
+  Pet pet;
+};
+
+struct name_index {
+  size_t mask;
+  struct name_index_slot *slots;
+  // Pets sorted by case-folded name
+  size_t count;
+  Pet *sorted;
+};
+
+// Iterates over the pets whose names fall within a range of the sorted array
+// (and start with `prefix`, unless it is NULL)
+struct pet_name_range {
+  const struct name_index *index;
+  size_t next;
+  size_t end;
+  const char *prefix;
+  size_t prefix_length;
+};
+
+// Returns the slot that the supplied name would have (without a pet)
+static inline struct name_index_slot name_index_key(const char *name,
+                                                    uint64_t hash) {
+  struct name_index_slot key = {.pet = NULL};
+  const size_t length = strlen(name);
+  memcpy(key.prefix, name,
+         length < NAME_INDEX_PREFIX ? length : NAME_INDEX_PREFIX);
+  key.length = (uint32_t) length;
+  key.tag = (uint32_t) (hash >> 32);
+  return key;
+}
+
+// Returns true if a slot has the same prefix, length and tag as a key
+static inline bool name_index_may_match(const struct name_index_slot *slot,
+                                        const struct name_index_slot *key) {
+#if defined(__AVX2__)
+  const __m256i found = _mm256_loadu_si256((const __m256i *) slot);
+  const __m256i expected = _mm256_loadu_si256((const __m256i *) key);
+  const uint32_t equal = (uint32_t) _mm256_movemask_epi8(
+    _mm256_cmpeq_epi8(found, expected));
+  return (equal & 0x00ffffffU) == 0x00ffffffU;
+#elif defined(__SSE2__)
+  const __m128i found = _mm_loadu_si128((const __m128i *) slot->prefix);
+  const __m128i expected = _mm_loadu_si128((const __m128i *) key->prefix);
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(found, expected)) == 0xffff
+      && slot->length == key->length && slot->tag == key->tag;
+#else
+  return memcmp(slot, key, offsetof(struct name_index_slot, pet)) == 0;
+#endif
+}
+
+// Returns a pet by name (the first one indexed, if several share it)
+static inline OPTIONAL(Pet) name_index_find(const struct name_index *index,
+                                            const char *name) {
+  if (index->slots == NULL) {
+    return (OPTIONAL(Pet)) OPTIONAL_EMPTY;
+  }
+  const uint64_t hash = hash_map_hash_string(name);
+  const struct name_index_slot key = name_index_key(name, hash);
+  for (size_t position = hash & index->mask;
+       index->slots[position].pet != NULL;
+       position = (position + 1) & index->mask) {
+    const struct name_index_slot *slot = &index->slots[position];
+    if (name_index_may_match(slot, &key)
+        && (key.length <= NAME_INDEX_PREFIX
+            || memcmp(PET_NAME(slot->pet) + NAME_INDEX_PREFIX,
+                      name + NAME_INDEX_PREFIX,
+                      key.length - NAME_INDEX_PREFIX) == 0)) {
+      return (OPTIONAL(Pet)) OPTIONAL_PRESENT(slot->pet);
+    }
+  }
+  return (OPTIONAL(Pet)) OPTIONAL_EMPTY;
+}
+
+// Compares at most `length` characters of two strings, ignoring ASCII case
+static inline int name_index_compare_folded(const char *a, const char *b,
+                                            size_t length) {
+  for (size_t index = 0; index < length; index++) {
+    int x = (unsigned char) a[index];
+    int y = (unsigned char) b[index];
+    x += (x >= 'A' && x <= 'Z') ? 'a' - 'A' : 0;
+    y += (y >= 'A' && y <= 'Z') ? 'a' - 'A' : 0;
+    if (x != y || x == '\0') {
+      return x - y;
+    }
+  }
+  return 0;
+}
+
+// Sorts pets by case-folded name, then by name
+static inline int name_index_compare(const void *a, const void *b) {
+  const char *x = PET_NAME(*(const Pet *) a);
+  const char *y = PET_NAME(*(const Pet *) b);
+  const int folded = name_index_compare_folded(x, y, SIZE_MAX);
+  return folded != 0 ? folded : strcmp(x, y);
+}
+
+// Returns the first sorted position whose first `length` case-folded
+// characters are not less (or, if `after`, greater) than those of `name`
+static inline size_t name_index_bound(const struct name_index *index,
+                                      const char *name, size_t length,
+                                      bool after) {
+  size_t low = 0;
+  size_t high = index->count;
+  while (low < high) {
+    const size_t middle = low + (high - low) / 2;
+    const int order = name_index_compare_folded(
+      PET_NAME(index->sorted[middle]), name, length);
+    if (order < 0 || (after && order == 0)) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+// Returns an iterator over the pets with the supplied name, ignoring case
+static inline struct pet_name_range name_index_ignoring_case(
+    const struct name_index *index, const char *name) {
+  return (struct pet_name_range) {
+    .index = index,
+    .next = name_index_bound(index, name, SIZE_MAX, false),
+    .end = name_index_bound(index, name, SIZE_MAX, true),
+    .prefix = NULL
+  };
+}
+
+// Returns an iterator over the pets whose names start with `prefix`
+// (which must outlive the iterator)
+static inline struct pet_name_range name_index_prefix(
+    const struct name_index *index, const char *prefix) {
+  const size_t length = strlen(prefix);
+  return (struct pet_name_range) {
+    .index = index,
+    .next = name_index_bound(index, prefix, length, false),
+    .end = name_index_bound(index, prefix, length, true),
+    .prefix = prefix,
+    .prefix_length = length
+  };
+}
+
+// Returns the next pet of the range (or empty, once all have been seen)
+static inline OPTIONAL(Pet) pet_name_range_next(struct pet_name_range *range) {
+  for (; range->next < range->end; range->next++) {
+    Pet pet = range->index->sorted[range->next];
+    // Names that only match ignoring case are interleaved with the rest
+    if (range->prefix == NULL
+        || strncmp(PET_NAME(pet), range->prefix, range->prefix_length) == 0) {
+      range->next++;
+      return (OPTIONAL(Pet)) OPTIONAL_PRESENT(pet);
+    }
+  }
+  return (OPTIONAL(Pet)) OPTIONAL_EMPTY;
+}
+
+static inline void name_index_free(struct name_index *index) {
+  free(index->slots);
+  free(index->sorted);
+  *index = (struct name_index) {.slots = NULL};
+}
+
+// Builds an index of the supplied pets
+static inline bool name_index_build(struct name_index *index, const Pet *pets,
+                                    size_t count) {
+  size_t slots = HASH_MAP_MIN_CAPACITY;
+  while (slots / 2 < count) {
+    slots *= 2;
+  }
+  index->mask = slots - 1;
+  index->slots = calloc(slots, sizeof(struct name_index_slot));
+  index->count = count;
+  index->sorted = malloc((count + 1) * sizeof(Pet));
+  if (index->slots == NULL || index->sorted == NULL) {
+    name_index_free(index);
+    return false;
+  }
+  for (size_t next = 0; next < count; next++) {
+    const char *name = PET_NAME(pets[next]);
+    if (OPTIONAL_IS_PRESENT(name_index_find(index, name))) {
+      continue;
+    }
+    const uint64_t hash = hash_map_hash_string(name);
+    size_t position = hash & index->mask;
+    while (index->slots[position].pet != NULL) {
+      position = (position + 1) & index->mask;
+    }
+    index->slots[position] = name_index_key(name, hash);
+    index->slots[position].pet = pets[next];
+  }
+  memcpy(index->sorted, pets, count * sizeof(Pet));
+  qsort(index->sorted, count, sizeof(Pet), name_index_compare);
+  return true;
+}
+
+#endif
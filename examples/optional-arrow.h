@@ -0,0 +1,452 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef OPTIONAL_ARROW_H
+#define OPTIONAL_ARROW_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <optional.h>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Optional columns that can be handed to (and taken from) engines speaking
+// the Arrow C Data Interface without copying.
+//
+// OPTIONAL_ARROW_COLUMN(name, type, format) generates:
+//
+//   struct name
+//   bool name_from_optionals(struct name *column,
+//                            const OPTIONAL(type) *optionals, size_t count)
+//   OPTIONAL(type) name_get(const struct name *column, size_t index)
+//   void name_to_optionals(const struct name *column,
+//                          OPTIONAL(type) *optionals)
+//   bool name_export(struct name *column, struct ArrowArray *array,
+//                    struct ArrowSchema *schema)
+//   bool name_import(struct name *column, struct ArrowArray *array,
+//                    const struct ArrowSchema *schema)
+//   void name_free(struct name *column)
+//
+// A column keeps its values in one buffer and whether they are present in a
+// separate bitmap (bit n of byte n / 8 is set if element n is present), the
+// layout of an Arrow primitive array. `format` is the Arrow format string of
+// the type ("i" for int32_t, "g" for double...). OPTIONAL_STRUCT(type) must
+// be declared beforehand.
+//
+// Exporting moves the buffers of a column into an ArrowArray, whose release
+// callback frees them; importing moves an ArrowArray into a column, which
+// calls its release callback when freed. Either way, the column is left
+// empty and nothing is copied. Only building a column from an array of
+// optionals copies, deinterleaving 32- and 64-bit values with SIMD (other
+// types are copied one at a time).
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+  const char *format;
+  const char *name;
+  const char *metadata;
+  int64_t flags;
+  int64_t n_children;
+  struct ArrowSchema **children;
+  struct ArrowSchema *dictionary;
+  void (*release)(struct ArrowSchema *);
+  void *private_data;
+};
+
+struct ArrowArray {
+  int64_t length;
+  int64_t null_count;
+  int64_t offset;
+  int64_t n_buffers;
+  int64_t n_children;
+  const void **buffers;
+  struct ArrowArray **children;
+  struct ArrowArray *dictionary;
+  void (*release)(struct ArrowArray *);
+  void *private_data;
+};
+
+#endif
+
+// Alignment (and padding) of the buffers of a column, as Arrow recommends
+#define OPTIONAL_ARROW_ALIGNMENT 64
+
+// True if OPTIONAL(type) is a flag followed by a value of `size` bytes, so
+// that it can be deinterleaved with SIMD
+#define OPTIONAL_ARROW_PACKS(type, size)                                      \
+  (sizeof(type) == (size) && sizeof(OPTIONAL(type)) == 2 * (size)             \
+   && offsetof(OPTIONAL(type), _empty) == 0                                   \
+   && offsetof(OPTIONAL(type), _value) == (size))
+
+// Buffers of an exported array
+struct optional_arrow_buffers {
+  const void *buffers[2];
+};
+
+// Allocates an aligned buffer (padded to a multiple of the alignment)
+static inline void *optional_arrow_alloc(size_t size) {
+  const size_t padded = (size / OPTIONAL_ARROW_ALIGNMENT + 1)
+                      * OPTIONAL_ARROW_ALIGNMENT;
+  return aligned_alloc(OPTIONAL_ARROW_ALIGNMENT, padded);
+}
+
+static inline void optional_arrow_release_schema(struct ArrowSchema *schema) {
+  schema->release = NULL;
+}
+
+static inline void optional_arrow_release_array(struct ArrowArray *array) {
+  struct optional_arrow_buffers *buffers = array->private_data;
+  free((void *) buffers->buffers[0]);
+  free((void *) buffers->buffers[1]);
+  free(buffers);
+  array->release = NULL;
+}
+
+// Returns the schema of a nullable primitive array
+static inline struct ArrowSchema optional_arrow_schema(const char *format) {
+  return (struct ArrowSchema) {
+    .format = format,
+    .name = "",
+    .flags = ARROW_FLAG_NULLABLE,
+    .release = optional_arrow_release_schema
+  };
+}
+
+// Makes an array that frees the supplied buffers when released
+static inline bool optional_arrow_export(struct ArrowArray *array,
+                                         const void *validity,
+                                         const void *values, size_t length,
+                                         size_t null_count) {
+  struct optional_arrow_buffers *buffers = malloc(sizeof(*buffers));
+  if (buffers == NULL) {
+    return false;
+  }
+  *buffers = (struct optional_arrow_buffers) {.buffers = {validity, values}};
+  *array = (struct ArrowArray) {
+    .length = (int64_t) length,
+    .null_count = (int64_t) null_count,
+    .n_buffers = 2,
+    .buffers = buffers->buffers,
+    .release = optional_arrow_release_array,
+    .private_data = buffers
+  };
+  return true;
+}
+
+// Returns true if an array is a live primitive array of the supplied format
+static inline bool optional_arrow_importable(const struct ArrowArray *array,
+                                             const struct ArrowSchema *schema,
+                                             const char *format) {
+  return array->release != NULL && schema->release != NULL
+      && strcmp(schema->format, format) == 0
+      && schema->n_children == 0 && schema->dictionary == NULL
+      && array->n_buffers == 2 && array->n_children == 0
+      && array->dictionary == NULL && array->length >= 0
+      && array->offset >= 0
+      && (array->buffers[1] != NULL || array->length == 0);
+}
+
+// Counts the unset bits of a bitmap in [offset, offset + length)
+static inline size_t optional_arrow_count_nulls(const uint8_t *validity,
+                                                size_t offset, size_t length) {
+  size_t nulls = 0;
+  for (size_t position = offset;
+       validity != NULL && position < offset + length; position++) {
+    nulls += (validity[position / 8] >> (position % 8) & 1) == 0;
+  }
+  return nulls;
+}
+
+// Deinterleaves optionals of `size`-byte values one at a time, starting at
+// `index` (the validity byte of `index` must be zero); returns the number of
+// present ones
+static inline size_t optional_arrow_pack_tail(const unsigned char *input,
+                                              size_t size, size_t index,
+                                              size_t count, uint8_t *validity,
+                                              unsigned char *output) {
+  size_t present = 0;
+  for (; index < count; index++) {
+    const unsigned char *optional = input + index * 2 * size;
+    if (optional[0] != 0) {
+      memset(output + index * size, 0, size);
+      continue;
+    }
+    memcpy(output + index * size, optional + size, size);
+    validity[index / 8] |= (uint8_t) (1U << (index % 8));
+    present++;
+  }
+  return present;
+}
+
+// Deinterleaves optionals of 32-bit values into a (zeroed) validity bitmap
+// and a value buffer, zeroing the values of empty ones; returns the number
+// of empty optionals
+static inline size_t optional_arrow_pack32(const void *optionals,
+                                           size_t count, uint8_t *validity,
+                                           void *values) {
+  const unsigned char *input = optionals;
+  unsigned char *output = values;
+  size_t present = 0;
+  size_t index = 0;
+#if defined(__AVX2__)
+  const __m256i flag = _mm256_set1_epi32(0xff);
+  for (; index + 8 <= count; index += 8) {
+    // [f0 v0 f1 v1 f2 v2 f3 v3] [f4 v4 f5 v5 f6 v6 f7 v7]
+    const __m256 low = _mm256_castsi256_ps(
+      _mm256_loadu_si256((const __m256i *) (input + index * 8)));
+    const __m256 high = _mm256_castsi256_ps(
+      _mm256_loadu_si256((const __m256i *) (input + index * 8 + 32)));
+    // [f0 f1 f4 f5 f2 f3 f6 f7] -> [f0 f1 f2 f3 f4 f5 f6 f7]
+    const __m256i flags = _mm256_permute4x64_epi64(
+      _mm256_castps_si256(
+        _mm256_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0))),
+      _MM_SHUFFLE(3, 1, 2, 0));
+    const __m256i value = _mm256_permute4x64_epi64(
+      _mm256_castps_si256(
+        _mm256_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1))),
+      _MM_SHUFFLE(3, 1, 2, 0));
+    // Only the first byte is the flag; the rest is padding
+    const __m256i mask = _mm256_cmpeq_epi32(_mm256_and_si256(flags, flag),
+                                            _mm256_setzero_si256());
+    _mm256_storeu_si256((__m256i *) (output + index * 4),
+                        _mm256_and_si256(value, mask));
+    const unsigned bits = (unsigned) _mm256_movemask_ps(
+      _mm256_castsi256_ps(mask));
+    validity[index / 8] = (uint8_t) bits;
+    present += (size_t) __builtin_popcount(bits);
+  }
+#elif defined(__SSE2__)
+  const __m128i flag = _mm_set1_epi32(0xff);
+  for (; index + 8 <= count; index += 8) {
+    unsigned bits = 0;
+    for (size_t half = 0; half < 8; half += 4) {
+      // [f0 v0 f1 v1] [f2 v2 f3 v3]
+      const unsigned char *next = input + (index + half) * 8;
+      const __m128 low = _mm_castsi128_ps(
+        _mm_loadu_si128((const __m128i *) next));
+      const __m128 high = _mm_castsi128_ps(
+        _mm_loadu_si128((const __m128i *) (next + 16)));
+      const __m128i flags = _mm_castps_si128(
+        _mm_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0)));
+      const __m128i value = _mm_castps_si128(
+        _mm_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1)));
+      // Only the first byte is the flag; the rest is padding
+      const __m128i mask = _mm_cmpeq_epi32(_mm_and_si128(flags, flag),
+                                           _mm_setzero_si128());
+      _mm_storeu_si128((__m128i *) (output + (index + half) * 4),
+                       _mm_and_si128(value, mask));
+      bits |= (unsigned) _mm_movemask_ps(_mm_castsi128_ps(mask)) << half;
+    }
+    validity[index / 8] = (uint8_t) bits;
+    present += (size_t) __builtin_popcount(bits);
+  }
+#endif
+  present += optional_arrow_pack_tail(input, 4, index, count, validity,
+                                      output);
+  return count - present;
+}
+
+// Deinterleaves optionals of 64-bit values (see optional_arrow_pack32)
+static inline size_t optional_arrow_pack64(const void *optionals,
+                                           size_t count, uint8_t *validity,
+                                           void *values) {
+  const unsigned char *input = optionals;
+  unsigned char *output = values;
+  size_t present = 0;
+  size_t index = 0;
+#if defined(__AVX2__)
+  const __m256i flag = _mm256_set1_epi64x(0xff);
+  for (; index + 8 <= count; index += 8) {
+    unsigned bits = 0;
+    for (size_t half = 0; half < 8; half += 4) {
+      // [f0 v0 f1 v1] [f2 v2 f3 v3]
+      const unsigned char *next = input + (index + half) * 16;
+      const __m256i low = _mm256_loadu_si256((const __m256i *) next);
+      const __m256i high = _mm256_loadu_si256((const __m256i *) (next + 32));
+      // [f0 f2 f1 f3] -> [f0 f1 f2 f3]
+      const __m256i flags = _mm256_permute4x64_epi64(
+        _mm256_unpacklo_epi64(low, high), _MM_SHUFFLE(3, 1, 2, 0));
+      const __m256i value = _mm256_permute4x64_epi64(
+        _mm256_unpackhi_epi64(low, high), _MM_SHUFFLE(3, 1, 2, 0));
+      // Only the first byte is the flag; the rest is padding
+      const __m256i mask = _mm256_cmpeq_epi64(_mm256_and_si256(flags, flag),
+                                              _mm256_setzero_si256());
+      _mm256_storeu_si256((__m256i *) (output + (index + half) * 8),
+                          _mm256_and_si256(value, mask));
+      bits |= (unsigned) _mm256_movemask_pd(_mm256_castsi256_pd(mask))
+           << half;
+    }
+    validity[index / 8] = (uint8_t) bits;
+    present += (size_t) __builtin_popcount(bits);
+  }
+#elif defined(__SSE2__)
+  const __m128i flag = _mm_set1_epi64x(0xff);
+  for (; index + 8 <= count; index += 8) {
+    unsigned bits = 0;
+    for (size_t pair = 0; pair < 8; pair += 2) {
+      // [f0 v0] [f1 v1]
+      const unsigned char *next = input + (index + pair) * 16;
+      const __m128i low = _mm_loadu_si128((const __m128i *) next);
+      const __m128i high = _mm_loadu_si128((const __m128i *) (next + 16));
+      const __m128i flags = _mm_unpacklo_epi64(low, high);
+      const __m128i value = _mm_unpackhi_epi64(low, high);
+      // Compare the low halves (the high ones are zero after masking)
+      const __m128i mask = _mm_shuffle_epi32(
+        _mm_cmpeq_epi32(_mm_and_si128(flags, flag), _mm_setzero_si128()),
+        _MM_SHUFFLE(2, 2, 0, 0));
+      _mm_storeu_si128((__m128i *) (output + (index + pair) * 8),
+                       _mm_and_si128(value, mask));
+      bits |= (unsigned) _mm_movemask_pd(_mm_castsi128_pd(mask)) << pair;
+    }
+    validity[index / 8] = (uint8_t) bits;
+    present += (size_t) __builtin_popcount(bits);
+  }
+#endif
+  present += optional_arrow_pack_tail(input, 8, index, count, validity,
+                                      output);
+  return count - present;
+}
+
+#define OPTIONAL_ARROW_COLUMN(name, type, format)                             \
+                                                                              \
+  struct name {                                                               \
+    size_t length;                                                            \
+    size_t null_count;                                                        \
+    /* Position of the first element in the buffers (imported arrays) */      \
+    size_t offset;                                                            \
+    /* NULL if every element is present (imported arrays) */                  \
+    const uint8_t *validity;                                                  \
+    const type *values;                                                       \
+    /* Imported array owning the buffers (released if NULL) */                \
+    struct ArrowArray owner;                                                  \
+  };                                                                          \
+                                                                              \
+  static inline bool name##_from_optionals(struct name *column,               \
+                                           const OPTIONAL(type) *optionals,   \
+                                           size_t count) {                    \
+    uint8_t *validity = optional_arrow_alloc((count + 7) / 8);                \
+    type *values = optional_arrow_alloc(count * sizeof(type));                \
+    if (validity == NULL || values == NULL) {                                 \
+      free(validity);                                                         \
+      free(values);                                                           \
+      return false;                                                           \
+    }                                                                         \
+    memset(validity, 0, (count + 7) / 8);                                     \
+    size_t null_count;                                                        \
+    if (OPTIONAL_ARROW_PACKS(type, 4)) {                                      \
+      null_count = optional_arrow_pack32(optionals, count, validity, values); \
+    } else if (OPTIONAL_ARROW_PACKS(type, 8)) {                               \
+      null_count = optional_arrow_pack64(optionals, count, validity, values); \
+    } else {                                                                  \
+      null_count = 0;                                                         \
+      for (size_t index = 0; index < count; index++) {                        \
+        if (OPTIONAL_IS_EMPTY(optionals[index])) {                            \
+          memset(&values[index], 0, sizeof(type));                            \
+          null_count++;                                                       \
+        } else {                                                              \
+          values[index] = OPTIONAL_USE_VALUE(optionals[index]);               \
+          validity[index / 8] |= (uint8_t) (1U << (index % 8));               \
+        }                                                                     \
+      }                                                                       \
+    }                                                                         \
+    *column = (struct name) {                                                 \
+      .length = count,                                                        \
+      .null_count = null_count,                                               \
+      .validity = validity,                                                   \
+      .values = values                                                        \
+    };                                                                        \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  static inline OPTIONAL(type) name##_get(const struct name *column,          \
+                                          size_t index) {                     \
+    const size_t position = column->offset + index;                           \
+    if (column->validity != NULL                                              \
+        && (column->validity[position / 8] >> (position % 8) & 1) == 0) {     \
+      return (OPTIONAL(type)) OPTIONAL_EMPTY;                                 \
+    }                                                                         \
+    return (OPTIONAL(type)) OPTIONAL_PRESENT(column->values[position]);       \
+  }                                                                           \
+                                                                              \
+  static inline void name##_to_optionals(const struct name *column,           \
+                                         OPTIONAL(type) *optionals) {         \
+    for (size_t index = 0; index < column->length; index++) {                 \
+      optionals[index] = name##_get(column, index);                           \
+    }                                                                         \
+  }                                                                           \
+                                                                              \
+  /* Moves the buffers of a column into an array (the column is emptied) */   \
+  static inline bool name##_export(struct name *column,                       \
+                                   struct ArrowArray *array,                  \
+                                   struct ArrowSchema *schema) {              \
+    if (column->owner.release != NULL) {                                      \
+      /* An imported array is handed over as it is */                         \
+      *array = column->owner;                                                 \
+    } else if (!optional_arrow_export(array, column->validity,                \
+                                      column->values, column->length,         \
+                                      column->null_count)) {                  \
+      return false;                                                           \
+    }                                                                         \
+    *schema = optional_arrow_schema(format);                                  \
+    *column = (struct name) {.values = NULL};                                 \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  /* Moves an array into a column (the schema is left to the caller) */       \
+  static inline bool name##_import(struct name *column,                       \
+                                   struct ArrowArray *array,                  \
+                                   const struct ArrowSchema *schema) {        \
+    if (!optional_arrow_importable(array, schema, format)) {                  \
+      return false;                                                           \
+    }                                                                         \
+    *column = (struct name) {                                                 \
+      .length = (size_t) array->length,                                       \
+      .offset = (size_t) array->offset,                                       \
+      .validity = array->buffers[0],                                          \
+      .values = array->buffers[1],                                            \
+      .owner = *array                                                         \
+    };                                                                        \
+    column->null_count = array->null_count >= 0                               \
+                       ? (size_t) array->null_count                           \
+                       : optional_arrow_count_nulls(column->validity,         \
+                                                    column->offset,           \
+                                                    column->length);          \
+    array->release = NULL;                                                    \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  static inline void name##_free(struct name *column) {                       \
+    if (column->owner.release != NULL) {                                      \
+      column->owner.release(&column->owner);                                  \
+    } else {                                                                  \
+      free((void *) column->validity);                                        \
+      free((void *) column->values);                                          \
+    }                                                                         \
+    *column = (struct name) {.values = NULL};                                 \
+  }
+
+#endif
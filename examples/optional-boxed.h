@@ -0,0 +1,313 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef OPTIONAL_BOXED_H
+#define OPTIONAL_BOXED_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <optional.h>
+
+// Boxed optionals: the value lives in a pool, the optional only holds a
+// pointer to it, so an empty optional of a large type costs two words
+// instead of the whole type.
+//
+//   OPTIONAL_BOXED_STRUCT(type)   declares OPTIONAL_BOXED(type)
+//   OPTIONAL_BOXED(type)          an optional pointer to a boxed type
+//   OPTIONAL_BOXED_RELEASE(pool, optional)
+//
+// OPTIONAL_BOXED(type) is an Optional of `type *`, so the OPTIONAL_* macros
+// work on it, passing the pointer to the box on to mappers and predicates:
+//
+//   type *box = box_pool_copy(&pool, &value, sizeof(value));
+//   OPTIONAL_BOXED(type) optional = OPTIONAL_OF_NULLABLE(box);
+//
+// A box pool carves boxes out of 256 KB slabs, in power-of-two size classes
+// from 16 bytes to 16 KB, aligned to 16 bytes (larger boxes get a slab of
+// their own, which is only given back when the pool is freed). Released
+// boxes go to a free list of the releasing thread, which hands batches of
+// them back to the pool when it grows too long. A thread's free lists follow
+// the last pool it used: switching to another pool (or exiting) hands every
+// cached box back. box_pool_free() releases every box at once.
+//
+// The free lists are thread-local variables of this header, so every
+// translation unit gets its own set of them; they are keyed on the address
+// of the pool, so pools can be shared by any number of translation units.
+
+#define OPTIONAL_BOXED_TAG(type_name)                                       \
+  optional_boxed_ ## type_name
+
+#define OPTIONAL_BOXED(type_name)                                           \
+  struct OPTIONAL_BOXED_TAG(type_name)
+
+#define OPTIONAL_BOXED_STRUCT(type)                                         \
+  OPTIONAL_STRUCT_TAG(                                                      \
+    type *,                                                                 \
+    OPTIONAL_BOXED_TAG(type)                                                \
+  )
+
+// Returns the box of a present optional to the pool and empties it
+#define OPTIONAL_BOXED_RELEASE(pool, optional)                              \
+  do {                                                                      \
+    if (OPTIONAL_IS_PRESENT(optional)) {                                    \
+      box_pool_release((pool), OPTIONAL_USE_VALUE(optional),                \
+                       sizeof(*OPTIONAL_USE_VALUE(optional)));              \
+      (optional) = (typeof(optional)) OPTIONAL_EMPTY;                       \
+    }                                                                       \
+  } while(false)
+
+// Smallest box (and alignment of every box)
+#define BOX_POOL_MIN_SIZE 16
+
+// Number of size classes (16 bytes to 16 KB)
+#define BOX_POOL_CLASSES 11
+
+#define BOX_POOL_MAX_SIZE (BOX_POOL_MIN_SIZE << (BOX_POOL_CLASSES - 1))
+
+#define BOX_POOL_SLAB_SIZE (256 * 1024)
+
+// Longest free list a thread keeps per size class
+#define BOX_POOL_CACHE_SIZE 64
+
+// Slab header (slabs are linked so that they can be released at once)
+struct box_slab {
+  _Alignas(BOX_POOL_MIN_SIZE) struct box_slab *next;
+};
+
+struct box_free {
+  struct box_free *next;
+};
+
+struct box_class {
+  struct box_free *free;
+  char *cursor;
+  char *limit;
+};
+
+struct box_pool {
+  pthread_mutex_t lock;
+  struct box_class classes[BOX_POOL_CLASSES];
+  struct box_slab *slabs;
+  size_t reserved;
+  // Free lists of the threads holding boxes of this pool
+  struct box_cache *caches;
+};
+
+// Free lists of the current thread, for the pool it last used
+struct box_cache {
+  struct box_pool *pool;
+  // Next free lists holding boxes of the same pool
+  struct box_cache *next;
+  struct box_free *free[BOX_POOL_CLASSES];
+  size_t count[BOX_POOL_CLASSES];
+};
+
+static _Thread_local struct box_cache box_cache;
+
+// Hands the free lists of exiting threads back to their pools
+static pthread_key_t box_cache_key;
+static pthread_once_t box_cache_once = PTHREAD_ONCE_INIT;
+
+static inline bool box_pool_init(struct box_pool *pool) {
+  *pool = (struct box_pool) {.slabs = NULL};
+  return pthread_mutex_init(&pool->lock, NULL) == 0;
+}
+
+// Releases every box of the pool at once (no other thread may be using it)
+static inline void box_pool_free(struct box_pool *pool) {
+  // Free lists of any thread may point into the slabs
+  for (struct box_cache *cache = pool->caches; cache != NULL;) {
+    struct box_cache *next = cache->next;
+    *cache = (struct box_cache) {.pool = NULL};
+    cache = next;
+  }
+  pool->caches = NULL;
+  while (pool->slabs != NULL) {
+    struct box_slab *slab = pool->slabs;
+    pool->slabs = slab->next;
+    free(slab);
+  }
+  (void) pthread_mutex_destroy(&pool->lock);
+  pool->reserved = 0;
+}
+
+// Returns the size class of a box, or BOX_POOL_CLASSES if it is too large
+static inline size_t box_pool_class(size_t size) {
+  size_t class = 0;
+  while (class < BOX_POOL_CLASSES && (BOX_POOL_MIN_SIZE << class) < size) {
+    class++;
+  }
+  return class;
+}
+
+// Hands every box of some free lists back to their pool
+static inline void box_cache_flush(struct box_cache *cache) {
+  struct box_pool *pool = cache->pool;
+  if (pool == NULL) {
+    return;
+  }
+  (void) pthread_mutex_lock(&pool->lock);
+  for (size_t class = 0; class < BOX_POOL_CLASSES; class++) {
+    struct box_free *first = cache->free[class];
+    if (first == NULL) {
+      continue;
+    }
+    struct box_free *last = first;
+    while (last->next != NULL) {
+      last = last->next;
+    }
+    last->next = pool->classes[class].free;
+    pool->classes[class].free = first;
+  }
+  struct box_cache **link = &pool->caches;
+  while (*link != cache) {
+    link = &(*link)->next;
+  }
+  *link = cache->next;
+  (void) pthread_mutex_unlock(&pool->lock);
+  *cache = (struct box_cache) {.pool = NULL};
+}
+
+static inline void box_cache_exit(void *cache) {
+  box_cache_flush(cache);
+}
+
+static inline void box_cache_key_create(void) {
+  (void) pthread_key_create(&box_cache_key, box_cache_exit);
+}
+
+// Returns the current thread's free lists, handing those of another pool
+// back to it first
+static inline struct box_cache *box_pool_cache(struct box_pool *pool) {
+  struct box_cache *cache = &box_cache;
+  if (cache->pool != pool) {
+    box_cache_flush(cache);
+    (void) pthread_once(&box_cache_once, box_cache_key_create);
+    (void) pthread_setspecific(box_cache_key, cache);
+    (void) pthread_mutex_lock(&pool->lock);
+    cache->pool = pool;
+    cache->next = pool->caches;
+    pool->caches = cache;
+    (void) pthread_mutex_unlock(&pool->lock);
+  }
+  return cache;
+}
+
+// Adds a slab to the pool and returns the memory after its header
+static inline char *box_pool_add_slab(struct box_pool *pool, size_t size) {
+  struct box_slab *slab = malloc(sizeof(struct box_slab) + size);
+  if (slab == NULL) {
+    return NULL;
+  }
+  slab->next = pool->slabs;
+  pool->slabs = slab;
+  pool->reserved += sizeof(struct box_slab) + size;
+  return (char *) (slab + 1);
+}
+
+// Moves up to half a cache worth of boxes from the pool to the thread
+static inline bool box_pool_refill(struct box_pool *pool,
+                                   struct box_cache *cache, size_t class) {
+  const size_t size = (size_t) BOX_POOL_MIN_SIZE << class;
+  struct box_class *boxes = &pool->classes[class];
+  (void) pthread_mutex_lock(&pool->lock);
+  while (cache->count[class] < BOX_POOL_CACHE_SIZE / 2) {
+    struct box_free *box = boxes->free;
+    if (box != NULL) {
+      boxes->free = box->next;
+    } else {
+      if (boxes->cursor == boxes->limit) {
+        const size_t slab = BOX_POOL_SLAB_SIZE - sizeof(struct box_slab);
+        char *memory = box_pool_add_slab(pool, slab - slab % size);
+        if (memory == NULL) {
+          break;
+        }
+        boxes->cursor = memory;
+        boxes->limit = memory + (slab - slab % size);
+      }
+      box = (struct box_free *) boxes->cursor;
+      boxes->cursor += size;
+    }
+    box->next = cache->free[class];
+    cache->free[class] = box;
+    cache->count[class]++;
+  }
+  (void) pthread_mutex_unlock(&pool->lock);
+  return cache->count[class] > 0;
+}
+
+// Returns an uninitialized box of the supplied size, or NULL
+static inline void *box_pool_alloc(struct box_pool *pool, size_t size) {
+  const size_t class = box_pool_class(size);
+  if (class == BOX_POOL_CLASSES) {
+    (void) pthread_mutex_lock(&pool->lock);
+    void *box = box_pool_add_slab(pool, size);
+    (void) pthread_mutex_unlock(&pool->lock);
+    return box;
+  }
+  struct box_cache *cache = box_pool_cache(pool);
+  if (cache->free[class] == NULL && !box_pool_refill(pool, cache, class)) {
+    return NULL;
+  }
+  struct box_free *box = cache->free[class];
+  cache->free[class] = box->next;
+  cache->count[class]--;
+  return box;
+}
+
+// Returns a box holding a copy of the supplied value, or NULL
+static inline void *box_pool_copy(struct box_pool *pool, const void *value,
+                                  size_t size) {
+  void *box = box_pool_alloc(pool, size);
+  if (box != NULL) {
+    memcpy(box, value, size);
+  }
+  return box;
+}
+
+// Gives a box back to the pool
+static inline void box_pool_release(struct box_pool *pool, void *box,
+                                    size_t size) {
+  const size_t class = box_pool_class(size);
+  if (class == BOX_POOL_CLASSES) {
+    return;
+  }
+  struct box_cache *cache = box_pool_cache(pool);
+  struct box_free *released = box;
+  released->next = cache->free[class];
+  cache->free[class] = released;
+  if (++cache->count[class] < BOX_POOL_CACHE_SIZE) {
+    return;
+  }
+  // Hand half of the list back to the pool
+  struct box_free *first = cache->free[class];
+  struct box_free *last = first;
+  for (size_t count = 1; count < BOX_POOL_CACHE_SIZE / 2; count++) {
+    last = last->next;
+  }
+  cache->free[class] = last->next;
+  cache->count[class] -= BOX_POOL_CACHE_SIZE / 2;
+  (void) pthread_mutex_lock(&pool->lock);
+  last->next = pool->classes[class].free;
+  pool->classes[class].free = first;
+  (void) pthread_mutex_unlock(&pool->lock);
+}
+
+#endif
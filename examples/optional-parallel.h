@@ -0,0 +1,170 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef OPTIONAL_PARALLEL_H
+#define OPTIONAL_PARALLEL_H
+
+#include <stdlib.h>
+#include <optional.h>
+#include "work-pool.h"
+
+// Parallel map, filter and reduce over arrays of optionals.
+//
+//   OPTIONAL_PARALLEL_MAP(name, input_type, output_type, mapper)
+//     void name(struct work_pool *pool, const OPTIONAL(input_type) *input,
+//               OPTIONAL(output_type) *output, size_t count)
+//   OPTIONAL_PARALLEL_FILTER(name, type, is_acceptable)
+//     void name(struct work_pool *pool, const OPTIONAL(type) *input,
+//               OPTIONAL(type) *output, size_t count)
+//   OPTIONAL_PARALLEL_REDUCE(name, type, combine)
+//     OPTIONAL(type) name(struct work_pool *pool,
+//                         const OPTIONAL(type) *input, size_t count)
+//
+// Map and filter apply OPTIONAL_MAP and OPTIONAL_FILTER to every element, so
+// with a pure mapper or predicate the output is exactly the sequential one.
+// Chunks are multiples of 64 elements, which makes them whole cache lines of
+// a 64-byte aligned output array: no two threads ever write to the same one.
+// Reduce combines the present values of every chunk, then the results of
+// the chunks in order; it returns an empty optional if there are none. The
+// chunks only depend on the count, so a reduction is deterministic, and
+// equal to the sequential one as long as combine is associative.
+//
+// OPTIONAL_STRUCT must be declared beforehand for every type involved.
+
+// Smallest chunk of elements handed out to a worker
+#define OPTIONAL_PARALLEL_MIN_GRAIN 4096
+
+// Largest number of chunks an array is split into
+#define OPTIONAL_PARALLEL_MAX_CHUNKS 4096
+
+// Returns the chunk size for an array (a multiple of 64 elements)
+static inline size_t optional_parallel_grain(size_t count) {
+  size_t grain = count / OPTIONAL_PARALLEL_MAX_CHUNKS;
+  if (grain < OPTIONAL_PARALLEL_MIN_GRAIN) {
+    grain = OPTIONAL_PARALLEL_MIN_GRAIN;
+  }
+  return (grain + 63) / 64 * 64;
+}
+
+#define OPTIONAL_PARALLEL_MAP(name, input_type, output_type, mapper)          \
+  struct name##_context {                                                     \
+    const OPTIONAL(input_type) *input;                                        \
+    OPTIONAL(output_type) *output;                                            \
+  };                                                                          \
+                                                                              \
+  static inline void name##_chunk(void *argument, size_t begin, size_t end) { \
+    const struct name##_context *context = argument;                          \
+    for (size_t index = begin; index < end; index++) {                        \
+      context->output[index] = OPTIONAL_MAP(context->input[index], mapper,    \
+                                            OPTIONAL(output_type));           \
+    }                                                                         \
+  }                                                                           \
+                                                                              \
+  static inline void name(struct work_pool *pool,                             \
+                          const OPTIONAL(input_type) *input,                  \
+                          OPTIONAL(output_type) *output, size_t count) {      \
+    struct name##_context context = {.input = input, .output = output};       \
+    work_pool_run(pool, name##_chunk, &context, count,                        \
+                  optional_parallel_grain(count));                            \
+  }
+
+#define OPTIONAL_PARALLEL_FILTER(name, type, is_acceptable)                   \
+  struct name##_context {                                                     \
+    const OPTIONAL(type) *input;                                              \
+    OPTIONAL(type) *output;                                                   \
+  };                                                                          \
+                                                                              \
+  static inline void name##_chunk(void *argument, size_t begin, size_t end) { \
+    const struct name##_context *context = argument;                          \
+    for (size_t index = begin; index < end; index++) {                        \
+      context->output[index] = OPTIONAL_FILTER(context->input[index],         \
+                                               is_acceptable);                \
+    }                                                                         \
+  }                                                                           \
+                                                                              \
+  static inline void name(struct work_pool *pool,                             \
+                          const OPTIONAL(type) *input,                        \
+                          OPTIONAL(type) *output, size_t count) {             \
+    struct name##_context context = {.input = input, .output = output};       \
+    work_pool_run(pool, name##_chunk, &context, count,                        \
+                  optional_parallel_grain(count));                            \
+  }
+
+#define OPTIONAL_PARALLEL_REDUCE(name, type, combine)                         \
+  struct name##_context {                                                     \
+    const OPTIONAL(type) *input;                                              \
+    OPTIONAL(type) *partials;                                                 \
+    size_t grain;                                                             \
+  };                                                                          \
+                                                                              \
+  static inline OPTIONAL(type) name##_fold(const OPTIONAL(type) *input,       \
+                                           size_t begin, size_t end) {        \
+    OPTIONAL(type) result = OPTIONAL_EMPTY;                                   \
+    for (size_t index = begin; index < end; index++) {                        \
+      if (OPTIONAL_IS_EMPTY(input[index])) {                                  \
+        continue;                                                             \
+      }                                                                       \
+      result = OPTIONAL_IS_EMPTY(result)                                      \
+        ? input[index]                                                        \
+        : (OPTIONAL(type)) OPTIONAL_PRESENT(                                  \
+            combine(OPTIONAL_USE_VALUE(result),                               \
+                    OPTIONAL_USE_VALUE(input[index])));                       \
+    }                                                                         \
+    return result;                                                            \
+  }                                                                           \
+                                                                              \
+  static inline void name##_chunk(void *argument, size_t begin, size_t end) { \
+    const struct name##_context *context = argument;                          \
+    context->partials[begin / context->grain] =                               \
+      name##_fold(context->input, begin, end);                                \
+  }                                                                           \
+                                                                              \
+  static inline OPTIONAL(type) name(struct work_pool *pool,                   \
+                                    const OPTIONAL(type) *input,              \
+                                    size_t count) {                           \
+    const size_t grain = optional_parallel_grain(count);                      \
+    const size_t chunks = (count + grain - 1) / grain;                        \
+    OPTIONAL(type) *partials = malloc(chunks * sizeof(OPTIONAL(type)));       \
+    if (partials != NULL) {                                                   \
+      struct name##_context context = {                                       \
+        .input = input,                                                       \
+        .partials = partials,                                                 \
+        .grain = grain                                                        \
+      };                                                                      \
+      work_pool_run(pool, name##_chunk, &context, count, grain);              \
+    }                                                                         \
+    /* Without room for the partials, fold the same chunks sequentially */    \
+    OPTIONAL(type) result = OPTIONAL_EMPTY;                                   \
+    for (size_t chunk = 0; chunk < chunks; chunk++) {                         \
+      const size_t begin = chunk * grain;                                     \
+      const OPTIONAL(type) partial = partials != NULL                         \
+        ? partials[chunk]                                                     \
+        : name##_fold(input, begin,                                           \
+                      count - begin > grain ? begin + grain : count);         \
+      if (OPTIONAL_IS_EMPTY(partial)) {                                       \
+        continue;                                                             \
+      }                                                                       \
+      result = OPTIONAL_IS_EMPTY(result)                                      \
+        ? partial                                                             \
+        : (OPTIONAL(type)) OPTIONAL_PRESENT(                                  \
+            combine(OPTIONAL_USE_VALUE(result), OPTIONAL_USE_VALUE(partial)));\
+    }                                                                         \
+    free(partials);                                                           \
+    return result;                                                            \
+  }
+
+#endif
@@ -0,0 +1,220 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef OPTIONAL_PARSE_H
+#define OPTIONAL_PARSE_H
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <optional.h>
+
+// Allocation-free number parsing.
+//
+// Every parser takes the characters of a number (not necessarily null-
+// terminated) and returns an empty optional unless all of them make up a
+// number that fits in the type. No whitespace is skipped, and the decimal
+// point is always a dot, whatever the locale.
+//
+// Integer digits are converted eight at a time: eight bytes are loaded into
+// a 64-bit word, checked to be digits and combined in three multiplications
+// (SWAR, SIMD within a register).
+
+OPTIONAL_STRUCT(int);
+OPTIONAL_STRUCT(long);
+OPTIONAL_STRUCT(double);
+
+// Longest number optional_parse_double accepts
+#define OPTIONAL_PARSE_MAX_LENGTH 256
+
+// Most significant digits an unsigned 64-bit integer can hold in full
+#define OPTIONAL_PARSE_MAX_DIGITS 19
+
+// Returns true if the eight bytes of a word are all digits
+static inline bool optional_parse_eight_digits(uint64_t word) {
+  return ((word & UINT64_C(0xf0f0f0f0f0f0f0f0))
+          | (((word + UINT64_C(0x0606060606060606))
+              & UINT64_C(0xf0f0f0f0f0f0f0f0)) >> 4))
+         == UINT64_C(0x3333333333333333);
+}
+
+// Converts eight digits loaded into a word (the first one in the lowest
+// byte): pairs, then quads, then the whole number
+static inline uint64_t optional_parse_eight_digits_value(uint64_t word) {
+  word -= UINT64_C(0x3030303030303030);
+  word = word * 10 + (word >> 8);
+  return (((word & UINT64_C(0x000000ff000000ff))
+           * (100 + (UINT64_C(1000000) << 32)))
+          + (((word >> 16) & UINT64_C(0x000000ff000000ff))
+             * (1 + (UINT64_C(10000) << 32)))) >> 32;
+}
+
+// Parses an unsigned number of up to OPTIONAL_PARSE_MAX_DIGITS significant
+// digits; returns false if there are no digits, other characters or more
+// significant digits
+static inline bool optional_parse_digits(const char *text, size_t length,
+                                         uint64_t *value) {
+  size_t index = 0;
+  while (index < length && text[index] == '0') {
+    index++;
+  }
+  if (length == 0 || length - index > OPTIONAL_PARSE_MAX_DIGITS) {
+    return false;
+  }
+  uint64_t result = 0;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  for (; length - index >= 8; index += 8) {
+    uint64_t word;
+    memcpy(&word, text + index, sizeof(word));
+    if (!optional_parse_eight_digits(word)) {
+      return false;
+    }
+    result = result * 100000000 + optional_parse_eight_digits_value(word);
+  }
+#endif
+  for (; index < length; index++) {
+    const unsigned digit = (unsigned) (unsigned char) text[index] - '0';
+    if (digit > 9) {
+      return false;
+    }
+    result = result * 10 + digit;
+  }
+  *value = result;
+  return true;
+}
+
+// Parses a signed magnitude no greater than `max` (or `max + 1` if
+// negative); returns false otherwise
+static inline bool optional_parse_signed(const char *text, size_t length,
+                                         uint64_t max, bool *negative,
+                                         uint64_t *magnitude) {
+  *negative = length > 0 && text[0] == '-';
+  const size_t sign = length > 0 && (text[0] == '-' || text[0] == '+');
+  return optional_parse_digits(text + sign, length - sign, magnitude)
+      && *magnitude <= max + *negative;
+}
+
+// Parses an int
+static inline OPTIONAL(int) optional_parse_int(const char *text,
+                                               size_t length) {
+  bool negative;
+  uint64_t magnitude;
+  if (!optional_parse_signed(text, length, INT_MAX, &negative, &magnitude)) {
+    return (OPTIONAL(int)) OPTIONAL_EMPTY;
+  }
+  // The magnitude of INT_MIN does not fit in an int
+  const int value = negative && magnitude > 0 ? -(int) (magnitude - 1) - 1
+                                              : (int) magnitude;
+  return (OPTIONAL(int)) OPTIONAL_PRESENT(value);
+}
+
+// Parses a long
+static inline OPTIONAL(long) optional_parse_long(const char *text,
+                                                 size_t length) {
+  bool negative;
+  uint64_t magnitude;
+  if (!optional_parse_signed(text, length, LONG_MAX, &negative, &magnitude)) {
+    return (OPTIONAL(long)) OPTIONAL_EMPTY;
+  }
+  const long value = negative && magnitude > 0 ? -(long) (magnitude - 1) - 1
+                                               : (long) magnitude;
+  return (OPTIONAL(long)) OPTIONAL_PRESENT(value);
+}
+
+// Parses a double: an optional sign, digits with an optional decimal point
+// (at least one digit), and an optional exponent. Numbers whose significant
+// digits and exponent can be represented exactly are computed with a single
+// multiplication or division, which rounds correctly; the rest are left to
+// strtod, which expects the "C" locale
+static inline OPTIONAL(double) optional_parse_double(const char *text,
+                                                     size_t length) {
+  static const double powers[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+  size_t index = length > 0 && (text[0] == '-' || text[0] == '+');
+  uint64_t mantissa = 0;
+  size_t digits = 0;
+  size_t significant = 0;
+  long exponent = 0;
+  bool point = false;
+  for (; index < length; index++) {
+    const unsigned digit = (unsigned) (unsigned char) text[index] - '0';
+    if (digit <= 9) {
+      digits++;
+      if (significant > 0 || digit != 0) {
+        significant++;
+      }
+      if (significant <= OPTIONAL_PARSE_MAX_DIGITS) {
+        mantissa = mantissa * 10 + digit;
+        exponent -= point;
+      } else {
+        exponent += !point;
+      }
+    } else if (text[index] == '.' && !point) {
+      point = true;
+    } else {
+      break;
+    }
+  }
+  if (digits == 0 || length > OPTIONAL_PARSE_MAX_LENGTH) {
+    return (OPTIONAL(double)) OPTIONAL_EMPTY;
+  }
+  if (index < length && (text[index] == 'e' || text[index] == 'E')) {
+    index++;
+    const size_t sign = index < length
+                     && (text[index] == '-' || text[index] == '+');
+    const bool negative = sign && text[index] == '-';
+    uint64_t value;
+    // Longer exponents overflow or underflow anyway
+    if (!optional_parse_digits(text + index + sign, length - index - sign,
+                               &value)
+        || value > 100000) {
+      return (OPTIONAL(double)) OPTIONAL_EMPTY;
+    }
+    exponent += negative ? -(long) value : (long) value;
+    index = length;
+  }
+  if (index != length) {
+    return (OPTIONAL(double)) OPTIONAL_EMPTY;
+  }
+  double value;
+  if (significant <= OPTIONAL_PARSE_MAX_DIGITS
+      && mantissa <= (UINT64_C(1) << 53) && exponent >= -22 && exponent <= 22) {
+    value = exponent < 0 ? (double) mantissa / powers[-exponent]
+                         : (double) mantissa * powers[exponent];
+    value = text[0] == '-' ? -value : value;
+  } else {
+    char copy[OPTIONAL_PARSE_MAX_LENGTH + 1];
+    char *end;
+    memcpy(copy, text, length);
+    copy[length] = '\0';
+    value = strtod(copy, &end);
+    if (end != copy + length) {
+      return (OPTIONAL(double)) OPTIONAL_EMPTY;
+    }
+  }
+  if (value - value != 0) {
+    // Overflow
+    return (OPTIONAL(double)) OPTIONAL_EMPTY;
+  }
+  return (OPTIONAL(double)) OPTIONAL_PRESENT(value);
+}
+
+#endif
@@ -0,0 +1,178 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef PERFECT_HASH_H
+#define PERFECT_HASH_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hash-map.h"
+
+// Collision-free hash of a fixed set of integer keys (hash and displace).
+//
+// Keys are first distributed into buckets; then each bucket gets the smallest
+// displacement that sends all of its keys to free slots. Looking a key up
+// takes one displacement read plus one slot read.
+
+// Average number of keys per bucket
+#define PERFECT_HASH_BUCKET_SIZE 4
+
+// Number of displacements to try per bucket before giving up
+#define PERFECT_HASH_MAX_ATTEMPTS (1u << 20)
+
+struct perfect_hash {
+  size_t buckets;
+  size_t mask;
+  uint32_t *displacements;
+  // Index of the key that owns each slot (unused slots point to key zero)
+  uint32_t *slots;
+};
+
+// Returns the bucket of a hashed key
+static inline size_t perfect_hash_bucket(uint64_t hash, size_t buckets) {
+  return (size_t) (hash >> 32) % buckets;
+}
+
+// Returns the slot of a hashed key, given the displacement of its bucket
+static inline size_t perfect_hash_slot(uint64_t hash, uint32_t displacement,
+                                       size_t mask) {
+  hash ^= displacement * UINT64_C(0x9e3779b97f4a7c15);
+  hash ^= hash >> 29;
+  hash *= UINT64_C(0xbf58476d1ce4e5b9);
+  return (size_t) (hash ^ (hash >> 32)) & mask;
+}
+
+// Returns the index of the only key that may be equal to the supplied one
+static inline uint32_t perfect_hash_lookup(const struct perfect_hash *table,
+                                           int key) {
+  const uint64_t hash = hash_map_hash_int(key);
+  const size_t bucket = perfect_hash_bucket(hash, table->buckets);
+  return table->slots[perfect_hash_slot(hash, table->displacements[bucket],
+                                        table->mask)];
+}
+
+static inline void perfect_hash_free(struct perfect_hash *table) {
+  free(table->displacements);
+  free(table->slots);
+  table->displacements = NULL;
+  table->slots = NULL;
+}
+
+// Tries to place all keys of a bucket using the supplied displacement
+static inline bool perfect_hash_place(struct perfect_hash *table,
+                                      const uint64_t *hashes,
+                                      const uint32_t *keys, size_t count,
+                                      uint32_t displacement, bool *taken) {
+  size_t placed = 0;
+  for (; placed < count; placed++) {
+    const size_t slot = perfect_hash_slot(hashes[keys[placed]], displacement,
+                                          table->mask);
+    if (taken[slot]) {
+      break;
+    }
+    taken[slot] = true;
+    table->slots[slot] = keys[placed];
+  }
+  if (placed == count) {
+    return true;
+  }
+  // Roll back the keys placed so far
+  while (placed-- > 0) {
+    taken[perfect_hash_slot(hashes[keys[placed]], displacement,
+                            table->mask)] = false;
+  }
+  return false;
+}
+
+// Sorts buckets by decreasing size
+static inline int perfect_hash_compare(const void *a, const void *b) {
+  const uint64_t x = *(const uint64_t *) a;
+  const uint64_t y = *(const uint64_t *) b;
+  return (x < y) - (x > y);
+}
+
+// Builds a perfect hash of distinct keys; returns false if it cannot be built
+static inline bool perfect_hash_build(struct perfect_hash *table,
+                                      const int *keys, size_t count) {
+  size_t slots = 1;
+  while (slots < count + count / 4) {
+    slots *= 2;
+  }
+  table->buckets = (count + PERFECT_HASH_BUCKET_SIZE - 1)
+                 / PERFECT_HASH_BUCKET_SIZE + 1;
+  table->mask = slots - 1;
+  table->displacements = calloc(table->buckets, sizeof(uint32_t));
+  table->slots = calloc(slots, sizeof(uint32_t));
+  uint64_t *hashes = malloc((count + 1) * sizeof(uint64_t));
+  size_t *start = calloc(table->buckets + 1, sizeof(size_t));
+  uint32_t *by_bucket = malloc((count + 1) * sizeof(uint32_t));
+  uint64_t *order = malloc(table->buckets * sizeof(uint64_t));
+  bool *taken = calloc(slots, sizeof(bool));
+  bool built = table->displacements != NULL && table->slots != NULL
+            && hashes != NULL && start != NULL && by_bucket != NULL
+            && order != NULL && taken != NULL;
+  if (built) {
+    // Group keys by bucket (counting sort)
+    for (size_t index = 0; index < count; index++) {
+      hashes[index] = hash_map_hash_int(keys[index]);
+      start[perfect_hash_bucket(hashes[index], table->buckets) + 1]++;
+    }
+    for (size_t bucket = 0; bucket < table->buckets; bucket++) {
+      start[bucket + 1] += start[bucket];
+    }
+    for (size_t index = 0; index < count; index++) {
+      size_t bucket = perfect_hash_bucket(hashes[index], table->buckets);
+      by_bucket[start[bucket]++] = (uint32_t) index;
+    }
+    for (size_t bucket = table->buckets; bucket > 0; bucket--) {
+      start[bucket] = start[bucket - 1];
+    }
+    start[0] = 0;
+    // Place the largest buckets first
+    for (size_t bucket = 0; bucket < table->buckets; bucket++) {
+      const uint64_t size = start[bucket + 1] - start[bucket];
+      order[bucket] = (size << 32) | bucket;
+    }
+    qsort(order, table->buckets, sizeof(uint64_t), perfect_hash_compare);
+    for (size_t index = 0; built && index < table->buckets; index++) {
+      const uint32_t bucket = (uint32_t) order[index];
+      const size_t size = start[bucket + 1] - start[bucket];
+      uint32_t displacement = 0;
+      while (size > 0 && !perfect_hash_place(table, hashes,
+                                             &by_bucket[start[bucket]], size,
+                                             displacement, taken)) {
+        if (++displacement == PERFECT_HASH_MAX_ATTEMPTS) {
+          built = false;
+          break;
+        }
+      }
+      table->displacements[bucket] = displacement;
+    }
+  }
+  free(hashes);
+  free(start);
+  free(by_bucket);
+  free(order);
+  free(taken);
+  if (!built) {
+    perfect_hash_free(table);
+  }
+  return built;
+}
+
+#endif
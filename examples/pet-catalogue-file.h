@@ -0,0 +1,299 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef PET_CATALOGUE_FILE_H
+#define PET_CATALOGUE_FILE_H
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "perfect-hash.h"
+
+// Binary pet catalogue, meant to be memory-mapped.
+//
+// The file starts with a header followed by fixed-width sections, each of
+// them aligned to a cache line: pet ids, one-byte statuses, 32-bit offsets
+// of the names, the string pool and the perfect hash of the ids. All of them
+// are stored in the byte order of the machine that wrote the file, so that
+// they can be used in place without any parsing or copying.
+
+#define PET_CATALOGUE_FILE_MAGIC "PETCATLG"
+
+// Incremented whenever the layout changes
+#define PET_CATALOGUE_FILE_VERSION 1
+
+// Written as is, so that files from machines with another byte order are
+// rejected
+#define PET_CATALOGUE_FILE_BYTE_ORDER UINT32_C(0x01020304)
+
+#define PET_CATALOGUE_FILE_ALIGNMENT 64
+
+// Statuses are stored as bytes below this (AVAILABLE, PENDING or SOLD)
+#define PET_CATALOGUE_FILE_STATUSES 3
+
+struct pet_catalogue_file_header {
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  uint64_t count;
+  uint64_t strings_size;
+  uint64_t buckets;
+  uint64_t mask;
+  // Offsets of the sections from the start of the file
+  uint64_t ids;
+  uint64_t statuses;
+  uint64_t names;
+  uint64_t strings;
+  uint64_t displacements;
+  uint64_t slots;
+  uint64_t size;
+};
+
+// A catalogue mapped into memory (statuses can be written; whether other
+// processes see the changes depends on how it was mapped)
+struct pet_catalogue_file {
+  void *data;
+  size_t size;
+  size_t count;
+  int *ids;
+  uint8_t *statuses;
+  uint32_t *names;
+  char *strings;
+  size_t strings_size;
+  struct perfect_hash hash;
+};
+
+// Rounds a file offset up to the section alignment
+static inline uint64_t pet_catalogue_file_align(uint64_t offset) {
+  return (offset + PET_CATALOGUE_FILE_ALIGNMENT - 1)
+       & ~(uint64_t) (PET_CATALOGUE_FILE_ALIGNMENT - 1);
+}
+
+// Lays out a catalogue of at least one pet in memory; returns the image
+// (to be freed by the caller) or NULL
+static inline void *pet_catalogue_file_image(const int *ids,
+                                             const uint8_t *statuses,
+                                             const char *const *names,
+                                             size_t count, size_t *size) {
+  struct perfect_hash hash;
+  if (count == 0 || count > UINT32_MAX
+      || !perfect_hash_build(&hash, ids, count)) {
+    return NULL;
+  }
+  struct pet_catalogue_file_header header = {
+    .magic = PET_CATALOGUE_FILE_MAGIC,
+    .version = PET_CATALOGUE_FILE_VERSION,
+    .byte_order = PET_CATALOGUE_FILE_BYTE_ORDER,
+    .count = count,
+    .buckets = hash.buckets,
+    .mask = hash.mask
+  };
+  for (size_t index = 0; index < count; index++) {
+    header.strings_size += strlen(names[index]) + 1;
+  }
+  header.ids = pet_catalogue_file_align(sizeof(header));
+  header.statuses = pet_catalogue_file_align(header.ids + count * sizeof(int));
+  header.names = pet_catalogue_file_align(header.statuses + count);
+  header.strings = pet_catalogue_file_align(header.names
+                                            + count * sizeof(uint32_t));
+  header.displacements = pet_catalogue_file_align(header.strings
+                                                  + header.strings_size);
+  header.slots = pet_catalogue_file_align(header.displacements
+                                          + hash.buckets * sizeof(uint32_t));
+  header.size = header.slots + (hash.mask + 1) * sizeof(uint32_t);
+  char *image = NULL;
+  if (header.strings_size < UINT32_MAX && header.size <= SIZE_MAX) {
+    image = calloc(1, (size_t) header.size);
+  }
+  if (image != NULL) {
+    memcpy(image, &header, sizeof(header));
+    memcpy(image + header.ids, ids, count * sizeof(int));
+    memcpy(image + header.statuses, statuses, count);
+    uint32_t *offsets = (uint32_t *) (image + header.names);
+    uint32_t offset = 0;
+    for (size_t index = 0; index < count; index++) {
+      const size_t length = strlen(names[index]) + 1;
+      offsets[index] = offset;
+      memcpy(image + header.strings + offset, names[index], length);
+      offset += (uint32_t) length;
+    }
+    memcpy(image + header.displacements, hash.displacements,
+           hash.buckets * sizeof(uint32_t));
+    memcpy(image + header.slots, hash.slots,
+           (hash.mask + 1) * sizeof(uint32_t));
+    *size = (size_t) header.size;
+  }
+  perfect_hash_free(&hash);
+  return image;
+}
+
+// Writes a catalogue of at least one pet; the file is replaced atomically
+static inline bool pet_catalogue_file_write(const char *path, const int *ids,
+                                            const uint8_t *statuses,
+                                            const char *const *names,
+                                            size_t count) {
+  size_t size = 0;
+  void *image = pet_catalogue_file_image(ids, statuses, names, count, &size);
+  const size_t length = strlen(path);
+  char *temporary = malloc(length + sizeof(".tmp"));
+  FILE *file = NULL;
+  if (image != NULL && temporary != NULL) {
+    memcpy(temporary, path, length);
+    memcpy(temporary + length, ".tmp", sizeof(".tmp"));
+    file = fopen(temporary, "wb");
+  }
+  bool written = file != NULL && fwrite(image, size, 1, file) == 1;
+  if (file != NULL) {
+    written = fclose(file) == 0 && written
+           && rename(temporary, path) == 0;
+    if (!written) {
+      (void) remove(temporary);
+    }
+  }
+  free(temporary);
+  free(image);
+  return written;
+}
+
+// Returns true if a section lies within the file
+static inline bool pet_catalogue_file_fits(
+    const struct pet_catalogue_file_header *header, uint64_t offset,
+    uint64_t size) {
+  return offset % PET_CATALOGUE_FILE_ALIGNMENT == 0
+      && offset <= header->size && size <= header->size - offset;
+}
+
+// Returns true if all of some 32-bit indices are below a limit
+static inline bool pet_catalogue_file_below(const void *indices, uint64_t count,
+                                            uint64_t limit) {
+  const uint32_t *index = indices;
+  for (uint64_t position = 0; position < count; position++) {
+    if (index[position] >= limit) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns true if all of some statuses are known ones
+static inline bool pet_catalogue_file_known(const void *statuses,
+                                            uint64_t count) {
+  const uint8_t *status = statuses;
+  for (uint64_t position = 0; position < count; position++) {
+    if (status[position] >= PET_CATALOGUE_FILE_STATUSES) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Maps an open catalogue into memory, either privately or shared with other
+// processes (MAP_PRIVATE or MAP_SHARED); returns false if the catalogue
+// can't be read, was written with another version of the format, or has
+// sections outside the file, unknown statuses, names outside the string pool
+// or perfect hash slots outside the pets
+static inline bool pet_catalogue_file_map_descriptor(
+    struct pet_catalogue_file *catalogue, int descriptor, int flags) {
+  struct stat status;
+  void *data = MAP_FAILED;
+  if (fstat(descriptor, &status) == 0
+      && (size_t) status.st_size >= sizeof(struct pet_catalogue_file_header)) {
+    data = mmap(NULL, (size_t) status.st_size, PROT_READ | PROT_WRITE, flags,
+                descriptor, 0);
+  }
+  if (data == MAP_FAILED) {
+    return false;
+  }
+  const struct pet_catalogue_file_header *header = data;
+  const uint64_t count = header->count;
+  const bool valid =
+    memcmp(header->magic, PET_CATALOGUE_FILE_MAGIC, sizeof(header->magic)) == 0
+    && header->version == PET_CATALOGUE_FILE_VERSION
+    && header->byte_order == PET_CATALOGUE_FILE_BYTE_ORDER
+    && header->size == (uint64_t) status.st_size
+    && count > 0 && count <= UINT32_MAX && header->buckets > 0
+    && header->buckets <= header->size / sizeof(uint32_t)
+    && header->mask < header->size / sizeof(uint32_t)
+    && (header->mask & (header->mask + 1)) == 0
+    && pet_catalogue_file_fits(header, header->ids, count * sizeof(int))
+    && pet_catalogue_file_fits(header, header->statuses, count)
+    && pet_catalogue_file_fits(header, header->names, count * sizeof(uint32_t))
+    && pet_catalogue_file_fits(header, header->strings, header->strings_size)
+    && header->strings_size > 0
+    && ((const char *) data)[header->strings + header->strings_size - 1]
+       == '\0'
+    && pet_catalogue_file_fits(header, header->displacements,
+                               header->buckets * sizeof(uint32_t))
+    && pet_catalogue_file_fits(header, header->slots,
+                               (header->mask + 1) * sizeof(uint32_t))
+    && pet_catalogue_file_known((const char *) data + header->statuses, count)
+    && pet_catalogue_file_below((const char *) data + header->names, count,
+                                header->strings_size)
+    && pet_catalogue_file_below((const char *) data + header->slots,
+                                header->mask + 1, count);
+  if (!valid) {
+    (void) munmap(data, (size_t) status.st_size);
+    return false;
+  }
+  char *base = data;
+  *catalogue = (struct pet_catalogue_file) {
+    .data = data,
+    .size = (size_t) status.st_size,
+    .count = (size_t) count,
+    .ids = (int *) (base + header->ids),
+    .statuses = (uint8_t *) (base + header->statuses),
+    .names = (uint32_t *) (base + header->names),
+    .strings = base + header->strings,
+    .strings_size = (size_t) header->strings_size,
+    .hash = {
+      .buckets = (size_t) header->buckets,
+      .mask = (size_t) header->mask,
+      .displacements = (uint32_t *) (base + header->displacements),
+      .slots = (uint32_t *) (base + header->slots)
+    }
+  };
+  return true;
+}
+
+// Maps a catalogue file into memory (statuses can be written, but the
+// changes are private to the process)
+static inline bool pet_catalogue_file_map(struct pet_catalogue_file *catalogue,
+                                          const char *path) {
+  const int descriptor = open(path, O_RDONLY);
+  if (descriptor < 0) {
+    return false;
+  }
+  const bool mapped = pet_catalogue_file_map_descriptor(catalogue, descriptor,
+                                                        MAP_PRIVATE);
+  (void) close(descriptor);
+  return mapped;
+}
+
+static inline void pet_catalogue_file_unmap(
+    struct pet_catalogue_file *catalogue) {
+  if (catalogue->data != NULL) {
+    (void) munmap(catalogue->data, catalogue->size);
+  }
+  catalogue->data = NULL;
+}
+
+#endif
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "perfect-hash.h"
+
+// Ids of the pets known at compile time
+static const int pet_ids[] = {
+#define PET(id, name, status) id,
+#include "pet-catalogue.def"
+#undef PET
+};
+
+// Sizes of the names of the pets known at compile time (null-terminated)
+static const size_t pet_name_sizes[] = {
+#define PET(id, name, status) sizeof(name),
+#include "pet-catalogue.def"
+#undef PET
+};
+
+// Prints a table of unsigned integers as a C array
+static void print_table(const char *name, const uint32_t *table, size_t size) {
+  printf("static const uint32_t %s[%zu] = {", name, size);
+  for (size_t index = 0; index < size; index++) {
+    printf("%s%s%u", index == 0 ? "" : ",", index % 8 == 0 ? "\n  " : " ",
+           (unsigned int) table[index]);
+  }
+  printf("\n};\n\n");
+}
+
+/**
+ * Generates the perfect hash index of the static pet catalogue.
+ */
+int main() {
+  struct perfect_hash table;
+  const size_t count = sizeof(pet_ids) / sizeof(pet_ids[0]);
+  if (!perfect_hash_build(&table, pet_ids, count)) {
+    fprintf(stderr, "Error: Could not build a perfect hash of the pet catalogue"
+                    " (are pet ids unique?)\n");
+    return EXIT_FAILURE;
+  }
+  printf("// Generated from pet-catalogue.def; do not edit\n\n");
+  printf("#define PET_CATALOGUE_BUCKETS %zu\n", table.buckets);
+  printf("#define PET_CATALOGUE_MASK %zu\n\n", table.mask);
+  print_table("pet_catalogue_displacements", table.displacements,
+              table.buckets);
+  print_table("pet_catalogue_slots", table.slots, table.mask + 1);
+  // Names are laid out one after another, in the same order as the pets
+  uint32_t name_offsets[sizeof(pet_ids) / sizeof(pet_ids[0])];
+  for (size_t index = 0, offset = 0; index < count; index++) {
+    name_offsets[index] = (uint32_t) offset;
+    offset += pet_name_sizes[index];
+  }
+  print_table("pet_catalogue_name_offsets", name_offsets, count);
+  perfect_hash_free(&table);
+  return EXIT_SUCCESS;
+}
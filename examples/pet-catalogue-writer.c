@@ -0,0 +1,131 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pet-catalogue-file.h"
+
+// Longest line of a dump
+#define LINE_SIZE 4096
+
+// Pets read from a dump
+struct dump {
+  size_t count;
+  size_t capacity;
+  int *ids;
+  uint8_t *statuses;
+  char **names;
+};
+
+// Parses a status by name (AVAILABLE, PENDING or SOLD) or number
+static bool parse_status(const char *text, uint8_t *status) {
+  static const char *names[] = {"AVAILABLE", "PENDING", "SOLD"};
+  for (uint8_t index = 0; index < 3; index++) {
+    if (strcmp(text, names[index]) == 0
+        || (text[0] == '0' + index && text[1] == '\0')) {
+      *status = index;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Appends a pet to the dump
+static bool append(struct dump *dump, int id, const char *name,
+                   uint8_t status) {
+  if (dump->count == dump->capacity) {
+    const size_t capacity = dump->capacity == 0 ? 1024 : 2 * dump->capacity;
+    int *ids = realloc(dump->ids, capacity * sizeof(int));
+    dump->ids = ids != NULL ? ids : dump->ids;
+    uint8_t *statuses = realloc(dump->statuses, capacity);
+    dump->statuses = statuses != NULL ? statuses : dump->statuses;
+    char **names = realloc(dump->names, capacity * sizeof(char *));
+    dump->names = names != NULL ? names : dump->names;
+    if (ids == NULL || statuses == NULL || names == NULL) {
+      return false;
+    }
+    dump->capacity = capacity;
+  }
+  char *copy = malloc(strlen(name) + 1);
+  if (copy == NULL) {
+    return false;
+  }
+  strcpy(copy, name);
+  dump->ids[dump->count] = id;
+  dump->statuses[dump->count] = status;
+  dump->names[dump->count++] = copy;
+  return true;
+}
+
+static void free_dump(struct dump *dump) {
+  for (size_t index = 0; index < dump->count; index++) {
+    free(dump->names[index]);
+  }
+  free(dump->ids);
+  free(dump->statuses);
+  free(dump->names);
+}
+
+/**
+ * Writes a binary pet catalogue from a dump with one pet per line
+ * (id, name and status separated by tabs).
+ */
+int main(int argc, char *argv[]) {
+  if (argc != 3) {
+    fprintf(stderr, "Usage: %s DUMP CATALOGUE\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  FILE *input = fopen(argv[1], "r");
+  if (input == NULL) {
+    fprintf(stderr, "Error: Could not open %s\n", argv[1]);
+    return EXIT_FAILURE;
+  }
+  struct dump dump = {.count = 0};
+  char line[LINE_SIZE];
+  bool parsed = true;
+  for (size_t number = 1; parsed && fgets(line, sizeof(line), input) != NULL;
+       number++) {
+    line[strcspn(line, "\r\n")] = '\0';
+    char *name = strchr(line, '\t');
+    char *status = name != NULL ? strchr(name + 1, '\t') : NULL;
+    char *end = NULL;
+    uint8_t value = 0;
+    if (name != NULL && status != NULL) {
+      *name++ = '\0';
+      *status++ = '\0';
+    }
+    const long id = status != NULL ? strtol(line, &end, 10) : 0;
+    parsed = status != NULL && end != line && *end == '\0'
+          && id >= INT32_MIN && id <= INT32_MAX && parse_status(status, &value)
+          && append(&dump, (int) id, name, value);
+    if (!parsed) {
+      fprintf(stderr, "Error: Invalid pet at %s:%zu\n", argv[1], number);
+    }
+  }
+  (void) fclose(input);
+  if (parsed
+      && !pet_catalogue_file_write(argv[2], dump.ids, dump.statuses,
+                                   (const char *const *) dump.names,
+                                   dump.count)) {
+    fprintf(stderr, "Error: Could not write %s (are pet ids unique?)\n",
+            argv[2]);
+    parsed = false;
+  }
+  free_dump(&dump);
+  return parsed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
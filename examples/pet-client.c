@@ -0,0 +1,136 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "bench.h"
+#include "pet-protocol.h"
+
+// Largest number of requests sent before reading the responses
+#define MAX_PIPELINE 512
+
+// Latency histogram buckets: [0, 1) us, [1, 2) us, [2, 4) us...
+#define BUCKETS 24
+
+// Returns the histogram bucket of a latency
+static size_t bucket_of(double nanoseconds) {
+  size_t bucket = 0;
+  for (double limit = 1000; nanoseconds >= limit && bucket < BUCKETS - 1;
+       limit *= 2) {
+    bucket++;
+  }
+  return bucket;
+}
+
+// Sends or receives exactly `size` bytes
+static bool transfer(int socket, void *data, size_t size, bool sending) {
+  char *bytes = data;
+  while (size > 0) {
+    const ssize_t done = sending ? send(socket, bytes, size, MSG_NOSIGNAL)
+                                 : recv(socket, bytes, size, 0);
+    if (done < 0 && errno == EINTR) {
+      continue;
+    }
+    if (done <= 0) {
+      return false;
+    }
+    bytes += done;
+    size -= (size_t) done;
+  }
+  return true;
+}
+
+/**
+ * Sends pipelined batches of find and buy requests to a pet store server
+ * and reports the throughput and a histogram of the latency of the batches.
+ */
+int main(int argc, char *argv[]) {
+  if (argc < 2 || argc > 5) {
+    fprintf(stderr, "Usage: %s SOCKET [REQUESTS [PIPELINE [PETS]]]\n",
+            argv[0]);
+    return EXIT_FAILURE;
+  }
+  const size_t requests = argc > 2 ? strtoul(argv[2], NULL, 10) : 1000000;
+  const size_t pipeline = argc > 3 ? strtoul(argv[3], NULL, 10) : 64;
+  const size_t pets = argc > 4 ? strtoul(argv[4], NULL, 10) : 100000;
+  struct sockaddr_un address = {.sun_family = AF_UNIX};
+  if (pipeline == 0 || pipeline > MAX_PIPELINE || pets == 0
+      || strlen(argv[1]) >= sizeof(address.sun_path)) {
+    fprintf(stderr, "Error: Invalid arguments\n");
+    return EXIT_FAILURE;
+  }
+  strcpy(address.sun_path, argv[1]);
+  const int server = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (server < 0
+      || connect(server, (struct sockaddr *) &address, sizeof(address))
+         != 0) {
+    fprintf(stderr, "Error: Could not connect to %s\n", argv[1]);
+    return EXIT_FAILURE;
+  }
+  static struct pet_request batch[MAX_PIPELINE];
+  static struct pet_response responses[MAX_PIPELINE];
+  size_t histogram[BUCKETS] = {0};
+  size_t found = 0;
+  size_t sent = 0;
+  uint64_t seed = 0x9e3779b97f4a7c15;
+  const double start = bench_now();
+  while (sent < requests) {
+    const size_t count = requests - sent < pipeline ? requests - sent
+                                                    : pipeline;
+    // One in four requests buys a pet; one in ten asks for a missing pet
+    for (size_t index = 0; index < count; index++) {
+      const uint64_t random = bench_random(&seed);
+      batch[index] = (struct pet_request) {
+        .operation = random % 4 == 0 ? PET_REQUEST_BUY : PET_REQUEST_FIND,
+        .pet_id = 1000 + (int32_t) ((random >> 8) % (pets + pets / 10))
+      };
+    }
+    const double batch_start = bench_now();
+    if (!transfer(server, batch, count * sizeof(batch[0]), true)
+        || !transfer(server, responses, count * sizeof(responses[0]), false)) {
+      fprintf(stderr, "Error: Lost the connection to the server\n");
+      return EXIT_FAILURE;
+    }
+    histogram[bucket_of(bench_now() - batch_start)] += count;
+    for (size_t index = 0; index < count; index++) {
+      if (responses[index].present
+          && responses[index].pet_id != batch[index].pet_id) {
+        fprintf(stderr, "Error: Got pet %d instead of %d\n",
+                (int) responses[index].pet_id, (int) batch[index].pet_id);
+        return EXIT_FAILURE;
+      }
+      found += responses[index].present;
+    }
+    sent += count;
+  }
+  const double elapsed = bench_now() - start;
+  (void) close(server);
+  printf("%zu requests (%zu present) in %.3f s: %.0f requests/s\n", sent,
+         found, elapsed / 1e9, (double) sent / elapsed * 1e9);
+  printf("Latency of batches of %zu requests:\n", pipeline);
+  for (size_t bucket = 0; bucket < BUCKETS; bucket++) {
+    if (histogram[bucket] > 0) {
+      printf("  < %8lu us %10zu\n", 1lu << bucket, histogram[bucket]);
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,214 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef PET_COLUMNS_H
+#define PET_COLUMNS_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <optional.h>
+#include "hash-map.h"
+
+// Pets stored column by column (struct of arrays).
+//
+// Ids, statuses and names live in separate arrays, so a scan that only checks
+// ids or statuses doesn't drag the other fields through the cache. Statuses
+// take one byte each, and names are interned into a contiguous arena and
+// referenced by 32-bit offsets.
+//
+// Columns can start out borrowing static arrays (such as the pet catalogue
+// known at compile time); they are copied to the heap the first time they
+// need to grow.
+
+// Offset of a name that could not be interned
+#define PET_COLUMNS_NO_NAME UINT32_MAX
+
+// Interned names are indexed by hash (which is already well mixed)
+#define pet_columns_hash_name(hash) (hash)
+
+OPTIONAL_STRUCT(uint32_t);
+HASH_MAP(pet_name_map, uint64_t, uint32_t, pet_columns_hash_name,
+         hash_map_equals_int)
+
+struct pet_columns {
+  size_t count;
+  size_t capacity;
+  int *ids;
+  _Atomic uint8_t *statuses;
+  uint32_t *names;
+  // Interned names, one after another (each of them null-terminated)
+  char *strings;
+  size_t strings_size;
+  size_t strings_capacity;
+  // Offsets of interned names by hash
+  struct pet_name_map interned;
+  // Whether the arrays are static (and must not be freed or resized)
+  bool borrowed;
+};
+
+// Returns the name at the supplied row
+static inline const char *pet_columns_name(const struct pet_columns *columns,
+                                           size_t row) {
+  return columns->strings + columns->names[row];
+}
+
+static inline void pet_columns_free(struct pet_columns *columns) {
+  if (!columns->borrowed) {
+    free(columns->ids);
+    free(columns->statuses);
+    free(columns->names);
+    free(columns->strings);
+  }
+  pet_name_map_free(&columns->interned);
+  *columns = (struct pet_columns) {.count = 0};
+}
+
+// Remembers a name that is already in the arena
+static inline bool pet_columns_remember(struct pet_columns *columns,
+                                        uint32_t offset) {
+  const uint64_t hash = hash_map_hash_string(columns->strings + offset);
+  // On a collision, the first name keeps the slot and the rest aren't shared
+  return OPTIONAL_IS_PRESENT(pet_name_map_get(&columns->interned, hash))
+      || pet_name_map_put(&columns->interned, hash, offset);
+}
+
+// Copies borrowed arrays to the heap, so that they can grow
+static inline bool pet_columns_own(struct pet_columns *columns) {
+  if (!columns->borrowed) {
+    return true;
+  }
+  struct pet_columns owned = {
+    .count = columns->count,
+    .capacity = columns->count,
+    .ids = malloc(columns->count * sizeof(int) + 1),
+    .statuses = malloc(columns->count * sizeof(uint8_t) + 1),
+    .names = malloc(columns->count * sizeof(uint32_t) + 1),
+    .strings = malloc(columns->strings_size + 1),
+    .strings_size = columns->strings_size,
+    .strings_capacity = columns->strings_size + 1,
+    .borrowed = false
+  };
+  if (owned.ids == NULL || owned.statuses == NULL || owned.names == NULL
+      || owned.strings == NULL || !pet_name_map_init(&owned.interned, 0)) {
+    pet_columns_free(&owned);
+    return false;
+  }
+  memcpy(owned.ids, columns->ids, columns->count * sizeof(int));
+  for (size_t row = 0; row < columns->count; row++) {
+    atomic_init(&owned.statuses[row], atomic_load(&columns->statuses[row]));
+  }
+  memcpy(owned.names, columns->names, columns->count * sizeof(uint32_t));
+  memcpy(owned.strings, columns->strings, columns->strings_size);
+  for (size_t row = 0; row < owned.count; row++) {
+    if (!pet_columns_remember(&owned, owned.names[row])) {
+      pet_columns_free(&owned);
+      return false;
+    }
+  }
+  *columns = owned;
+  return true;
+}
+
+// Makes room for at least `capacity` rows
+static inline bool pet_columns_reserve(struct pet_columns *columns,
+                                       size_t capacity) {
+  if (capacity <= columns->capacity) {
+    return true;
+  }
+  if (!pet_columns_own(columns)) {
+    return false;
+  }
+  size_t new_capacity = columns->capacity < 16 ? 16 : columns->capacity * 2;
+  while (new_capacity < capacity) {
+    new_capacity *= 2;
+  }
+  int *ids = realloc(columns->ids, new_capacity * sizeof(int));
+  if (ids != NULL) {
+    columns->ids = ids;
+  }
+  _Atomic uint8_t *statuses = realloc(columns->statuses,
+                                      new_capacity * sizeof(uint8_t));
+  if (statuses != NULL) {
+    columns->statuses = statuses;
+  }
+  uint32_t *names = realloc(columns->names, new_capacity * sizeof(uint32_t));
+  if (names != NULL) {
+    columns->names = names;
+  }
+  if (ids == NULL || statuses == NULL || names == NULL) {
+    return false;
+  }
+  columns->capacity = new_capacity;
+  return true;
+}
+
+// Returns the offset of a name in the arena, adding it if needed
+// (or PET_COLUMNS_NO_NAME if out of memory)
+static inline uint32_t pet_columns_intern(struct pet_columns *columns,
+                                          const char *name) {
+  if (!pet_columns_own(columns)
+      || (columns->interned.slots == NULL
+          && !pet_name_map_init(&columns->interned, 0))) {
+    return PET_COLUMNS_NO_NAME;
+  }
+  const uint64_t hash = hash_map_hash_string(name);
+  const OPTIONAL(uint32_t) interned = pet_name_map_get(&columns->interned,
+                                                       hash);
+  if (OPTIONAL_IS_PRESENT(interned)
+      && strcmp(columns->strings + OPTIONAL_USE_VALUE(interned), name) == 0) {
+    return OPTIONAL_USE_VALUE(interned);
+  }
+  const size_t size = strlen(name) + 1;
+  if (columns->strings_size + size >= PET_COLUMNS_NO_NAME) {
+    return PET_COLUMNS_NO_NAME;
+  }
+  if (columns->strings_size + size > columns->strings_capacity) {
+    size_t capacity = 2 * columns->strings_capacity + size;
+    char *strings = realloc(columns->strings, capacity);
+    if (strings == NULL) {
+      return PET_COLUMNS_NO_NAME;
+    }
+    columns->strings = strings;
+    columns->strings_capacity = capacity;
+  }
+  const uint32_t offset = (uint32_t) columns->strings_size;
+  memcpy(columns->strings + offset, name, size);
+  columns->strings_size += size;
+  if (!pet_columns_remember(columns, offset)) {
+    return PET_COLUMNS_NO_NAME;
+  }
+  return offset;
+}
+
+// Appends a pet; returns its row (or SIZE_MAX if out of memory)
+static inline size_t pet_columns_append(struct pet_columns *columns, int id,
+                                        const char *name, uint8_t status) {
+  const uint32_t offset = pet_columns_intern(columns, name);
+  if (offset == PET_COLUMNS_NO_NAME
+      || !pet_columns_reserve(columns, columns->count + 1)) {
+    return SIZE_MAX;
+  }
+  const size_t row = columns->count++;
+  columns->ids[row] = id;
+  atomic_init(&columns->statuses[row], status);
+  columns->names[row] = offset;
+  return row;
+}
+
+#endif
@@ -0,0 +1,149 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef PET_INDEX_H
+#define PET_INDEX_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "pet-store.h"
+
+// Sorted index of pets by id, laid out in Eytzinger (BFS) order.
+//
+// Node k has children 2k and 2k+1, so the top levels of the tree share a few
+// cache lines, and the nodes four levels below k are contiguous and can be
+// prefetched in a single cache line while the search goes on.
+
+// Number of ids per cache line
+#define PET_INDEX_BLOCK (64 / sizeof(int))
+
+struct pet_index {
+  size_t size;
+  // Ids and pets in Eytzinger order (one-based; slot zero is unused)
+  int *ids;
+  Pet *pets;
+};
+
+// Iterates over the pets whose ids fall within a range
+struct pet_range {
+  const struct pet_index *index;
+  size_t node;
+  int to;
+};
+
+// Returns the node holding the smallest id not less than the supplied one
+static inline size_t pet_index_lower_bound(const struct pet_index *index,
+                                           int id) {
+  size_t node = 1;
+  while (node <= index->size) {
+    __builtin_prefetch(index->ids + node * PET_INDEX_BLOCK);
+    node = 2 * node + (index->ids[node] < id);
+  }
+  // Go back up to the last node where the search turned left
+  return node >> __builtin_ffsll((long long) ~node);
+}
+
+// Returns the node that follows the supplied one in id order (or zero)
+static inline size_t pet_index_successor(const struct pet_index *index,
+                                         size_t node) {
+  if (2 * node + 1 <= index->size) {
+    // Leftmost node of the right subtree
+    node = 2 * node + 1;
+    while (2 * node <= index->size) {
+      node *= 2;
+    }
+    return node;
+  }
+  return node >> __builtin_ffsll((long long) ~node);
+}
+
+// Returns a pet by id
+static inline OPTIONAL(Pet) pet_index_find(const struct pet_index *index,
+                                           int id) {
+  const size_t node = pet_index_lower_bound(index, id);
+  if (node == 0 || index->ids[node] != id) {
+    return (OPTIONAL(Pet)) OPTIONAL_EMPTY;
+  }
+  return (OPTIONAL(Pet)) OPTIONAL_PRESENT(index->pets[node]);
+}
+
+// Returns an iterator over the pets with ids in [from, to)
+static inline struct pet_range pet_index_range(const struct pet_index *index,
+                                               int from, int to) {
+  return (struct pet_range) {
+    .index = index,
+    .node = pet_index_lower_bound(index, from),
+    .to = to
+  };
+}
+
+// Returns the next pet in the range, or empty when exhausted
+static inline OPTIONAL(Pet) pet_range_next(struct pet_range *range) {
+  if (range->node == 0 || range->index->ids[range->node] >= range->to) {
+    return (OPTIONAL(Pet)) OPTIONAL_EMPTY;
+  }
+  Pet pet = range->index->pets[range->node];
+  range->node = pet_index_successor(range->index, range->node);
+  return (OPTIONAL(Pet)) OPTIONAL_PRESENT(pet);
+}
+
+static inline void pet_index_free(struct pet_index *index) {
+  free(index->ids);
+  free(index->pets);
+  index->ids = NULL;
+  index->pets = NULL;
+  index->size = 0;
+}
+
+// Sorts pets by id
+static inline int pet_index_compare(const void *a, const void *b) {
+  const int x = PET_ID(*(const Pet *) a);
+  const int y = PET_ID(*(const Pet *) b);
+  return (x > y) - (x < y);
+}
+
+// Copies sorted pets into Eytzinger order; returns the next pet to copy
+static inline size_t pet_index_fill(struct pet_index *index,
+                                    const Pet *sorted, size_t next,
+                                    size_t node) {
+  if (node <= index->size) {
+    next = pet_index_fill(index, sorted, next, 2 * node);
+    index->ids[node] = PET_ID(sorted[next]);
+    index->pets[node] = sorted[next++];
+    next = pet_index_fill(index, sorted, next, 2 * node + 1);
+  }
+  return next;
+}
+
+// Builds an index of the supplied pets (which are sorted in place)
+static inline bool pet_index_build(struct pet_index *index, Pet *pets,
+                                   size_t count) {
+  // Cache-line aligned, so that the nodes prefetched at once share a line
+  const size_t blocks = (count + PET_INDEX_BLOCK) / PET_INDEX_BLOCK;
+  index->size = count;
+  index->ids = aligned_alloc(64, blocks * 64);
+  index->pets = malloc((count + 1) * sizeof(Pet));
+  if (index->ids == NULL || index->pets == NULL) {
+    pet_index_free(index);
+    return false;
+  }
+  qsort(pets, count, sizeof(Pet), pet_index_compare);
+  (void) pet_index_fill(index, pets, 0, 1);
+  return true;
+}
+
+#endif
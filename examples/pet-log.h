@@ -0,0 +1,257 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef PET_LOG_H
+#define PET_LOG_H
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+// Write-ahead log of pet status transitions, with group commit.
+//
+// Appending threads queue their records in a pending batch. The first one
+// to find no flush in progress becomes the leader: it waits for the batch
+// to fill up (for max_latency_ns at most), then writes the whole batch with
+// one write and one fdatasync while the next batch builds up. Every thread
+// returns once its own record is durable. A batch of one disables group
+// commit. If a flush fails, the tail of the log is unknown and every later
+// append fails too.
+
+// Records per read when replaying the log
+#define PET_LOG_READ_BATCH 256
+
+// Status transition of a pet
+struct pet_log_record {
+  uint32_t sequence;
+  int32_t pet_id;
+  uint8_t status;
+  uint8_t reserved[3];
+  uint32_t checksum;
+};
+
+struct pet_log {
+  int file;
+  size_t max_batch;
+  long max_latency_ns;
+  pthread_mutex_t lock;
+  // Signaled when the pending batch is full
+  pthread_cond_t filled;
+  // Broadcast when a flush starts (there is room again) and when it ends
+  pthread_cond_t changed;
+  struct pet_log_record *pending;
+  struct pet_log_record *flushed;
+  size_t pending_count;
+  // Sequence numbers of the last appended and the last durable records
+  uint64_t appended;
+  uint64_t durable;
+  bool flushing;
+  bool broken;
+};
+
+// Checksums everything but the checksum itself (FNV-1a), so that torn or
+// stale records are told apart from valid ones
+static inline uint32_t pet_log_checksum(const struct pet_log_record *record) {
+  const unsigned char *bytes = (const unsigned char *) record;
+  uint32_t hash = UINT32_C(2166136261);
+  for (size_t index = 0; index < offsetof(struct pet_log_record, checksum);
+       index++) {
+    hash = (hash ^ bytes[index]) * UINT32_C(16777619);
+  }
+  return hash;
+}
+
+// Applies the valid prefix of the log and truncates whatever follows it;
+// returns the number of records applied, or -1
+static inline long pet_log_replay(int file,
+                                  void (*apply)(const struct pet_log_record *,
+                                                void *),
+                                  void *context) {
+  struct pet_log_record records[PET_LOG_READ_BATCH];
+  long count = 0;
+  for (;;) {
+    const ssize_t bytes = read(file, records, sizeof(records));
+    if (bytes < 0 && errno == EINTR) {
+      continue;
+    }
+    if (bytes < 0) {
+      return -1;
+    }
+    const size_t available = (size_t) bytes / sizeof(records[0]);
+    size_t valid = 0;
+    while (valid < available
+           && records[valid].sequence == (uint32_t) (count + 1)
+           && records[valid].checksum == pet_log_checksum(&records[valid])) {
+      apply(&records[valid++], context);
+      count++;
+    }
+    if (valid < available || (size_t) bytes < sizeof(records)) {
+      break;
+    }
+  }
+  struct stat status;
+  const off_t end = (off_t) count * (off_t) sizeof(struct pet_log_record);
+  if (fstat(file, &status) != 0
+      || (S_ISREG(status.st_mode) && status.st_size > end
+          && (ftruncate(file, end) != 0 || fdatasync(file) != 0))) {
+    return -1;
+  }
+  return count;
+}
+
+// Opens (or creates) a log and replays it; records are appended in batches
+// of up to max_batch, waiting up to max_latency_ns for a batch to fill up
+static inline bool pet_log_open(struct pet_log *log, const char *path,
+                                size_t max_batch, long max_latency_ns,
+                                void (*apply)(const struct pet_log_record *,
+                                              void *),
+                                void *context) {
+  *log = (struct pet_log) {
+    .max_batch = max_batch > 0 ? max_batch : 1,
+    .max_latency_ns = max_latency_ns
+  };
+  log->file = open(path, O_RDWR | O_CREAT | O_APPEND, 0644);
+  if (log->file < 0) {
+    return false;
+  }
+  const long count = pet_log_replay(log->file, apply, context);
+  log->pending = malloc(log->max_batch * sizeof(struct pet_log_record));
+  log->flushed = malloc(log->max_batch * sizeof(struct pet_log_record));
+  if (count < 0 || log->pending == NULL || log->flushed == NULL
+      || pthread_mutex_init(&log->lock, NULL) != 0) {
+    free(log->pending);
+    free(log->flushed);
+    (void) close(log->file);
+    return false;
+  }
+  (void) pthread_cond_init(&log->filled, NULL);
+  (void) pthread_cond_init(&log->changed, NULL);
+  log->appended = log->durable = (uint64_t) count;
+  return true;
+}
+
+// Closes a log (no appends may be in progress)
+static inline void pet_log_close(struct pet_log *log) {
+  (void) close(log->file);
+  free(log->pending);
+  free(log->flushed);
+  (void) pthread_cond_destroy(&log->filled);
+  (void) pthread_cond_destroy(&log->changed);
+  (void) pthread_mutex_destroy(&log->lock);
+}
+
+// Writes all the supplied bytes, resuming partial writes
+static inline bool pet_log_write(int file, const void *data, size_t size) {
+  const char *bytes = data;
+  while (size > 0) {
+    const ssize_t written = write(file, bytes, size);
+    if (written < 0 && errno == EINTR) {
+      continue;
+    }
+    if (written <= 0) {
+      return false;
+    }
+    bytes += written;
+    size -= (size_t) written;
+  }
+  return true;
+}
+
+// Flushes the pending batch as its leader (the lock must be held, and the
+// caller must have set the flushing flag)
+static inline void pet_log_flush(struct pet_log *log) {
+  if (log->max_latency_ns > 0 && log->pending_count < log->max_batch) {
+    struct timespec deadline;
+    (void) clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_nsec += log->max_latency_ns;
+    deadline.tv_sec += deadline.tv_nsec / 1000000000;
+    deadline.tv_nsec %= 1000000000;
+    while (log->pending_count < log->max_batch
+           && pthread_cond_timedwait(&log->filled, &log->lock,
+                                     &deadline) != ETIMEDOUT) {
+    }
+  }
+  struct pet_log_record *batch = log->pending;
+  const size_t count = log->pending_count;
+  const uint64_t last = log->appended;
+  log->pending = log->flushed;
+  log->flushed = batch;
+  log->pending_count = 0;
+  (void) pthread_cond_broadcast(&log->changed);
+  (void) pthread_mutex_unlock(&log->lock);
+  const bool written = pet_log_write(log->file, batch,
+                                     count * sizeof(struct pet_log_record))
+                       && fdatasync(log->file) == 0;
+  (void) pthread_mutex_lock(&log->lock);
+  if (written) {
+    log->durable = last;
+  } else {
+    log->broken = true;
+  }
+  log->flushing = false;
+  (void) pthread_cond_broadcast(&log->changed);
+}
+
+// Appends a record and waits until it is durable; returns false if it
+// could not be written
+static inline bool pet_log_append(struct pet_log *log, int pet_id,
+                                  uint8_t status) {
+  (void) pthread_mutex_lock(&log->lock);
+  while (!log->broken && log->pending_count == log->max_batch) {
+    if (log->flushing) {
+      (void) pthread_cond_wait(&log->changed, &log->lock);
+    } else {
+      log->flushing = true;
+      pet_log_flush(log);
+    }
+  }
+  if (log->broken) {
+    (void) pthread_mutex_unlock(&log->lock);
+    return false;
+  }
+  const uint64_t sequence = ++log->appended;
+  struct pet_log_record *record = &log->pending[log->pending_count++];
+  *record = (struct pet_log_record) {
+    .sequence = (uint32_t) sequence,
+    .pet_id = pet_id,
+    .status = status
+  };
+  record->checksum = pet_log_checksum(record);
+  if (log->pending_count == log->max_batch) {
+    (void) pthread_cond_signal(&log->filled);
+  }
+  while (log->durable < sequence && !log->broken) {
+    if (log->flushing) {
+      (void) pthread_cond_wait(&log->changed, &log->lock);
+    } else {
+      log->flushing = true;
+      pet_log_flush(log);
+    }
+  }
+  const bool durable = log->durable >= sequence;
+  (void) pthread_mutex_unlock(&log->lock);
+  return durable;
+}
+
+#endif
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef PET_PROTOCOL_H
+#define PET_PROTOCOL_H
+
+#include <stdint.h>
+#include <string.h>
+#include <optional.h>
+#include "pet-store.h"
+
+// Binary protocol of the pet store server.
+//
+// Clients send fixed-size requests and get one fixed-size response per
+// request, in the same order. Requests can be pipelined: a client may send
+// any number of them before reading the responses, and the server answers
+// every complete request it reads at once. Integers are sent in the byte
+// order of the host, since both ends run on the same machine.
+//
+// A response tells whether the optional pet is present in its own field;
+// the rest of the response only means something if it is.
+
+// Operations
+#define PET_REQUEST_FIND 1
+#define PET_REQUEST_BUY 2
+
+// Longest name sent in a response (longer ones are truncated)
+#define PET_RESPONSE_NAME_SIZE 23
+
+struct pet_request {
+  uint8_t operation;
+  uint8_t reserved[3];
+  int32_t pet_id;
+};
+
+struct pet_response {
+  uint8_t present;
+  uint8_t status;
+  uint8_t reserved[2];
+  int32_t pet_id;
+  char name[PET_RESPONSE_NAME_SIZE + 1];
+};
+
+// Encodes an optional pet
+static inline struct pet_response pet_response_of(OPTIONAL(Pet) pet) {
+  struct pet_response response = {.present = OPTIONAL_IS_PRESENT(pet)};
+  if (response.present) {
+    const Pet value = OPTIONAL_USE_VALUE(pet);
+    response.status = (uint8_t) PET_STATUS(value);
+    response.pet_id = PET_ID(value);
+    strncpy(response.name, PET_NAME(value), PET_RESPONSE_NAME_SIZE);
+  }
+  return response;
+}
+
+// Executes a request against the store
+static inline struct pet_response pet_request_execute(
+    struct pet_request request) {
+  RESULT(Pet, pet_error) pet = find_pet(request.pet_id);
+  switch (request.operation) {
+    case PET_REQUEST_FIND:
+      return pet_response_of(RESULT_TO_OPTIONAL(pet, OPTIONAL(Pet)));
+    case PET_REQUEST_BUY:
+      pet = RESULT_FLAT_MAP(pet, buy_pet);
+      return pet_response_of(RESULT_TO_OPTIONAL(pet, OPTIONAL(Pet)));
+    default:
+      return pet_response_of((OPTIONAL(Pet)) OPTIONAL_EMPTY);
+  }
+}
+
+// Executes every complete request in a buffer, writing up to `capacity`
+// responses; returns the number of bytes consumed (a partial request at
+// the end is left for the next read)
+static inline size_t pet_requests_execute(const char *input, size_t size,
+                                          struct pet_response *responses,
+                                          size_t capacity, size_t *count) {
+  size_t consumed = 0;
+  *count = 0;
+  while (*count < capacity && size - consumed >= sizeof(struct pet_request)) {
+    struct pet_request request;
+    memcpy(&request, input + consumed, sizeof(request));
+    responses[(*count)++] = pet_request_execute(request);
+    consumed += sizeof(request);
+  }
+  return consumed;
+}
+
+#endif
@@ -0,0 +1,248 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "pet-protocol.h"
+#include "pet-store.h"
+
+// Most events handled per wakeup
+#define MAX_EVENTS 64
+
+// Bytes of requests read at once (and responses they can produce)
+#define INPUT_SIZE 4096
+#define MAX_RESPONSES (INPUT_SIZE / sizeof(struct pet_request))
+
+// How often event loops check whether they have to stop
+#define STOP_CHECK_MS 200
+
+// Connection to a client; responses that could not be sent yet are kept
+// until the socket becomes writable, and no more requests are read until
+// then, so a client that doesn't read can't make the server buffer more
+struct connection {
+  int socket;
+  size_t input_size;
+  size_t output_start;
+  size_t output_size;
+  char input[INPUT_SIZE];
+  struct pet_response output[MAX_RESPONSES];
+};
+
+// Event loop of a thread (every loop has its own epoll instance and serves
+// the connections it accepted)
+struct event_loop {
+  pthread_t thread;
+  int epoll;
+  int listener;
+};
+
+static volatile sig_atomic_t stopping;
+
+static void stop(int signal) {
+  (void) signal;
+  stopping = 1;
+}
+
+static void close_connection(struct event_loop *loop,
+                             struct connection *connection) {
+  (void) epoll_ctl(loop->epoll, EPOLL_CTL_DEL, connection->socket, NULL);
+  (void) close(connection->socket);
+  free(connection);
+}
+
+// Accepts every pending connection
+static void accept_connections(struct event_loop *loop) {
+  for (;;) {
+    const int socket = accept(loop->listener, NULL, NULL);
+    if (socket < 0) {
+      return;
+    }
+    struct connection *connection = malloc(sizeof(*connection));
+    struct epoll_event event = {.events = EPOLLIN, .data.ptr = connection};
+    if (connection == NULL
+        || fcntl(socket, F_SETFL, O_NONBLOCK) != 0
+        || epoll_ctl(loop->epoll, EPOLL_CTL_ADD, socket, &event) != 0) {
+      free(connection);
+      (void) close(socket);
+      continue;
+    }
+    connection->socket = socket;
+    connection->input_size = 0;
+    connection->output_start = 0;
+    connection->output_size = 0;
+  }
+}
+
+// Sends pending responses; returns false if the connection is broken
+static bool send_responses(struct event_loop *loop,
+                           struct connection *connection) {
+  const char *output = (const char *) connection->output;
+  while (connection->output_start < connection->output_size) {
+    const ssize_t sent = send(connection->socket,
+                              output + connection->output_start,
+                              connection->output_size
+                              - connection->output_start, MSG_NOSIGNAL);
+    if (sent < 0 && errno == EINTR) {
+      continue;
+    }
+    if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      struct epoll_event event = {.events = EPOLLOUT, .data.ptr = connection};
+      return epoll_ctl(loop->epoll, EPOLL_CTL_MOD, connection->socket,
+                       &event) == 0;
+    }
+    if (sent < 0) {
+      return false;
+    }
+    connection->output_start += (size_t) sent;
+  }
+  connection->output_start = connection->output_size = 0;
+  struct epoll_event event = {.events = EPOLLIN, .data.ptr = connection};
+  return epoll_ctl(loop->epoll, EPOLL_CTL_MOD, connection->socket,
+                   &event) == 0;
+}
+
+// Reads a batch of requests and answers all of them with one send;
+// returns false if the connection is closed or broken
+static bool serve_requests(struct event_loop *loop,
+                           struct connection *connection) {
+  const ssize_t received = recv(connection->socket,
+                                connection->input + connection->input_size,
+                                INPUT_SIZE - connection->input_size, 0);
+  if (received < 0) {
+    return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+  }
+  if (received == 0) {
+    return false;
+  }
+  connection->input_size += (size_t) received;
+  size_t count;
+  const size_t consumed = pet_requests_execute(connection->input,
+                                               connection->input_size,
+                                               connection->output,
+                                               MAX_RESPONSES, &count);
+  connection->input_size -= consumed;
+  memmove(connection->input, connection->input + consumed,
+          connection->input_size);
+  connection->output_size = count * sizeof(struct pet_response);
+  return send_responses(loop, connection);
+}
+
+static void *run_event_loop(void *argument) {
+  struct event_loop *loop = argument;
+  struct epoll_event events[MAX_EVENTS];
+  while (!stopping) {
+    const int count = epoll_wait(loop->epoll, events, MAX_EVENTS,
+                                 STOP_CHECK_MS);
+    for (int index = 0; index < count; index++) {
+      struct connection *connection = events[index].data.ptr;
+      if (connection == NULL) {
+        accept_connections(loop);
+      } else if (!((events[index].events & EPOLLOUT)
+                   ? send_responses(loop, connection)
+                   : serve_requests(loop, connection))) {
+        close_connection(loop, connection);
+      }
+    }
+  }
+  return NULL;
+}
+
+// Adds pets with consecutive ids, starting at 1000
+static bool add_pets(struct pet *pets, size_t count) {
+  for (size_t index = 0; index < count; index++) {
+    pets[index] = (struct pet) {.id = 1000 + (int) index, .name = "Pet"};
+    if (OPTIONAL_IS_EMPTY(add_pet(&pets[index]))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Serves the pet store on a Unix domain socket with one event loop per
+ * thread; the loops share the listening socket and each of them serves the
+ * connections it accepts.
+ */
+int main(int argc, char *argv[]) {
+  if (argc < 2 || argc > 4) {
+    fprintf(stderr, "Usage: %s SOCKET [THREADS [PETS]]\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  const long processors = sysconf(_SC_NPROCESSORS_ONLN);
+  const size_t threads = argc > 2 ? strtoul(argv[2], NULL, 10)
+                       : processors > 0 ? (size_t) processors : 1;
+  const size_t count = argc > 3 ? strtoul(argv[3], NULL, 10) : 0;
+  struct sockaddr_un address = {.sun_family = AF_UNIX};
+  if (threads == 0 || strlen(argv[1]) >= sizeof(address.sun_path)) {
+    fprintf(stderr, "Error: Invalid arguments\n");
+    return EXIT_FAILURE;
+  }
+  strcpy(address.sun_path, argv[1]);
+  struct pet *pets = malloc(count * sizeof(struct pet) + 1);
+  struct event_loop *loops = calloc(threads, sizeof(struct event_loop));
+  if (pets == NULL || loops == NULL || !add_pets(pets, count)) {
+    fprintf(stderr, "Error: Could not add %zu pets\n", count);
+    return EXIT_FAILURE;
+  }
+  const int listener = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+  (void) unlink(argv[1]);
+  if (listener < 0
+      || bind(listener, (struct sockaddr *) &address, sizeof(address)) != 0
+      || listen(listener, SOMAXCONN) != 0) {
+    fprintf(stderr, "Error: Could not listen on %s\n", argv[1]);
+    return EXIT_FAILURE;
+  }
+  (void) signal(SIGINT, stop);
+  (void) signal(SIGTERM, stop);
+  size_t started = 0;
+  for (; started < threads; started++) {
+    struct event_loop *loop = &loops[started];
+    // Only one of the loops is woken up for each new connection
+    struct epoll_event event = {.events = EPOLLIN | EPOLLEXCLUSIVE,
+                                .data.ptr = NULL};
+    loop->listener = listener;
+    loop->epoll = epoll_create1(0);
+    if (loop->epoll < 0
+        || epoll_ctl(loop->epoll, EPOLL_CTL_ADD, listener, &event) != 0
+        || pthread_create(&loop->thread, NULL, run_event_loop, loop) != 0) {
+      fprintf(stderr, "Error: Could not start event loop %zu\n", started);
+      stopping = 1;
+      break;
+    }
+  }
+  printf("Serving %zu pets on %s with %zu threads\n", count, argv[1],
+         started);
+  (void) fflush(stdout);
+  for (size_t index = 0; index < started; index++) {
+    (void) pthread_join(loops[index].thread, NULL);
+    (void) close(loops[index].epoll);
+  }
+  (void) close(listener);
+  (void) unlink(argv[1]);
+  free(loops);
+  free(pets);
+  return started == threads ? EXIT_SUCCESS : EXIT_FAILURE;
+}
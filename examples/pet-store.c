@@ -15,18 +15,399 @@
  */
 
 //! [source]
+#include <pthread.h>
+#include <stdatomic.h>
 #include <stddef.h>
+#include <stdlib.h>
 #include "pet-store.h"
+#include "bloom-filter.h"
+#include "hash-map.h"
+#include "name-index.h"
+#include "perfect-hash.h"
+#include "pet-index.h"
+#include "status-bitmap.h"
+#include "pet-catalogue-index.h"
+#ifdef PET_STORE_SOA
+#include "pet-catalogue-file.h"
+#include "shared-pet-catalogue.h"
+#endif
+#ifdef PET_STORE_LOG
+#include "pet-log.h"
+#endif
 
+#ifndef PET_STORE_SOA
 //! [array]
 // Available pets in the store
 static struct pet pets[] = {
-  {.id = 0, .name = "Rocky", .status = AVAILABLE},
-  {.id = 1, .name = "Garfield", .status = PENDING},
-  {.id = 2, .name = "Rantanplan", .status = SOLD}
+#define PET(pet_id, pet_name, pet_status) \
+  {.id = pet_id, .name = pet_name, .status = pet_status},
+#include "pet-catalogue.def"
+#undef PET
 };
 //! [array]
 
+#define PET_CATALOGUE_SIZE (sizeof(pets) / sizeof(pets[0]))
+#define CATALOGUE_PET(index) (&pets[index])
+
+// Perfect hash of the catalogue
+#define CATALOGUE_BUCKETS PET_CATALOGUE_BUCKETS
+#define CATALOGUE_MASK PET_CATALOGUE_MASK
+#define CATALOGUE_DISPLACEMENTS pet_catalogue_displacements
+#define CATALOGUE_SLOTS pet_catalogue_slots
+
+// Type of the status of a pet
+typedef pet_status pet_status_value;
+#else
+// Available pets in the store, column by column
+static int catalogue_ids[] = {
+#define PET(pet_id, pet_name, pet_status) pet_id,
+#include "pet-catalogue.def"
+#undef PET
+};
+static _Atomic uint8_t catalogue_statuses[] = {
+#define PET(pet_id, pet_name, pet_status) pet_status,
+#include "pet-catalogue.def"
+#undef PET
+};
+static char catalogue_names[] =
+#define PET(pet_id, pet_name, pet_status) pet_name "\0"
+#include "pet-catalogue.def"
+#undef PET
+;
+
+#define CATALOGUE_PET(index) PET_HANDLE(index)
+
+// Type of the status of a pet
+typedef uint8_t pet_status_value;
+
+// The catalogue takes the first rows; offsets are never written through
+struct pet_columns pet_store_columns = {
+  .count = sizeof(catalogue_ids) / sizeof(catalogue_ids[0]),
+  .capacity = sizeof(catalogue_ids) / sizeof(catalogue_ids[0]),
+  .ids = catalogue_ids,
+  .statuses = catalogue_statuses,
+  .names = (uint32_t *) pet_catalogue_name_offsets,
+  .strings = catalogue_names,
+  .strings_size = sizeof(catalogue_names) - 1,
+  .strings_capacity = sizeof(catalogue_names),
+  .borrowed = true
+};
+
+// Size and perfect hash of the catalogue (replaced by the ones of a mapped
+// catalogue file, if one is opened)
+static size_t catalogue_size = sizeof(catalogue_ids) / sizeof(catalogue_ids[0]);
+static struct perfect_hash catalogue_hash = {
+  .buckets = PET_CATALOGUE_BUCKETS,
+  .mask = PET_CATALOGUE_MASK,
+  .displacements = (uint32_t *) pet_catalogue_displacements,
+  .slots = (uint32_t *) pet_catalogue_slots
+};
+static struct pet_catalogue_file catalogue_file;
+
+// Whether the catalogue is shared with other processes (then its columns
+// can't be copied to grow them, as that would stop sharing the statuses)
+static bool catalogue_shared;
+
+#define PET_CATALOGUE_SIZE catalogue_size
+#define CATALOGUE_BUCKETS catalogue_hash.buckets
+#define CATALOGUE_MASK catalogue_hash.mask
+#define CATALOGUE_DISPLACEMENTS catalogue_hash.displacements
+#define CATALOGUE_SLOTS catalogue_hash.slots
+#endif
+
+// Number of lookups whose cache misses are overlapped by find_pets
+#define PET_BATCH_SIZE 16
+
+// Pets added at runtime, indexed by id
+HASH_MAP(pet_map, int, Pet, hash_map_hash_int, hash_map_equals_int)
+static struct pet_map added_pets;
+
+// Default tunables of the filter of pets added at runtime; the filter costs
+// one extra cache miss per hit, so it is disabled unless misses are frequent
+#ifndef PET_FILTER_FALSE_POSITIVE_RATE
+#define PET_FILTER_FALSE_POSITIVE_RATE 0.01
+#endif
+#ifndef PET_FILTER_MAX_BYTES
+#define PET_FILTER_MAX_BYTES 0
+#endif
+
+// Number of pets the filter makes room for, at least
+#define PET_FILTER_MIN_CAPACITY 1024
+
+// Filter of the ids of pets added at runtime (rebuilt as more pets are added)
+static struct bloom_filter added_ids;
+static size_t added_ids_capacity;
+static double filter_false_positive_rate = PET_FILTER_FALSE_POSITIVE_RATE;
+static size_t filter_max_bytes = PET_FILTER_MAX_BYTES;
+
+// Size of the per-thread cache of lookups; it only pays off when the hash
+// map of added pets is slower than the cache, so it is disabled by default
+#ifndef PET_CACHE_SETS
+#define PET_CACHE_SETS 64
+#endif
+#ifndef PET_CACHE_WAYS
+#define PET_CACHE_WAYS 0
+#endif
+
+// Incremented whenever a pet is added, so stale cached lookups can be told
+static atomic_ulong pet_generation = 1;
+
+#if PET_CACHE_WAYS > 0
+// Result of a lookup, valid as long as the generation does not change
+struct pet_cache_entry {
+  unsigned long generation;
+  int pet_id;
+  OPTIONAL(Pet) result;
+};
+
+// Per-thread cache of lookups; the ways of a set go from most to least
+// recently used
+static _Thread_local struct pet_cache_entry
+  pet_cache[PET_CACHE_SETS][PET_CACHE_WAYS];
+#endif
+
+static _Thread_local pet_cache_stats pet_cache_counters;
+
+// Positions of the pets added at runtime in the status bitmaps
+OPTIONAL_STRUCT(size_t);
+HASH_MAP(pet_position_map, int, size_t, hash_map_hash_int, hash_map_equals_int)
+static struct pet_position_map added_positions;
+
+// Pets by status, built on the first query and kept up to date afterwards;
+// the bitmaps are built and updated under the lock, so that a sale racing
+// with the first query is seen either by the buyer or by the query
+static struct status_bitmap pets_by_status;
+static atomic_bool pets_by_status_built;
+static pthread_mutex_t pets_by_status_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Index of all pets by name, rebuilt on demand after new pets are added
+static struct name_index pets_by_name;
+static bool pets_by_name_stale = true;
+
+// Sorted index of all pets, rebuilt on demand after new pets are added
+static struct pet_index pets_in_order;
+static bool pets_in_order_stale = true;
+
+#ifdef PET_STORE_LOG
+// Write-ahead log of sales, once opened
+static struct pet_log sales_log;
+static bool sales_log_open;
+#endif
+
+// Returns the position of the static pet that may have the supplied id
+// (perfect hash)
+static size_t find_catalogue_index(uint64_t hash) {
+  const size_t bucket = perfect_hash_bucket(hash, CATALOGUE_BUCKETS);
+  const size_t slot = perfect_hash_slot(
+    hash, CATALOGUE_DISPLACEMENTS[bucket], CATALOGUE_MASK);
+  return CATALOGUE_SLOTS[slot];
+}
+
+// Returns the static pet that may have the supplied id
+static Pet find_catalogue_pet(uint64_t hash) {
+  return CATALOGUE_PET(find_catalogue_index(hash));
+}
+
+// Returns false if no pet with the supplied id was definitely ever added
+static bool may_have_been_added(uint64_t hash) {
+  return added_pets.count != 0
+      && (added_ids.data == NULL || bloom_filter_may_contain(&added_ids, hash));
+}
+
+// Returns a pet added at runtime by id
+static OPTIONAL(Pet) find_added_pet(int pet_id, uint64_t hash) {
+  if (!may_have_been_added(hash)) {
+    return (OPTIONAL(Pet)) OPTIONAL_EMPTY;
+  }
+  return pet_map_get(&added_pets, pet_id);
+}
+
+// Returns a pet added at runtime by id, remembering recent lookups
+static OPTIONAL(Pet) find_added_pet_cached(int pet_id, uint64_t hash) {
+#if PET_CACHE_WAYS > 0
+  const unsigned long generation = atomic_load_explicit(&pet_generation,
+                                                        memory_order_acquire);
+  struct pet_cache_entry *set = pet_cache[(hash >> 40) % PET_CACHE_SETS];
+  for (int way = 0; way < PET_CACHE_WAYS; way++) {
+    if (set[way].generation == generation && set[way].pet_id == pet_id) {
+      const struct pet_cache_entry hit = set[way];
+      for (; way > 0; way--) {
+        set[way] = set[way - 1];
+      }
+      set[0] = hit;
+      pet_cache_counters.hits++;
+      return hit.result;
+    }
+  }
+  pet_cache_counters.misses++;
+  const OPTIONAL(Pet) result = find_added_pet(pet_id, hash);
+  // Evict the least recently used way
+  for (int way = PET_CACHE_WAYS - 1; way > 0; way--) {
+    set[way] = set[way - 1];
+  }
+  set[0] = (struct pet_cache_entry) {
+    .generation = generation,
+    .pet_id = pet_id,
+    .result = result
+  };
+  return result;
+#else
+  pet_cache_counters.misses++;
+  return find_added_pet(pet_id, hash);
+#endif
+}
+
+// Rebuilds the filter of added pets, making room for the supplied capacity
+static bool filter_added_pets(size_t capacity) {
+  bloom_filter_free(&added_ids);
+  added_ids_capacity = capacity;
+  if (filter_max_bytes == 0) {
+    return true;
+  }
+  Pet *added = malloc((added_pets.count + 1) * sizeof(Pet));
+  if (added == NULL
+      || !bloom_filter_init(&added_ids, capacity, filter_false_positive_rate,
+                            filter_max_bytes)) {
+    free(added);
+    return false;
+  }
+  const size_t count = pet_map_values(&added_pets, added);
+  for (size_t index = 0; index < count; index++) {
+    bloom_filter_add(&added_ids, hash_map_hash_int(PET_ID(added[index])));
+  }
+  free(added);
+  return true;
+}
+
+// Returns all pets (the static ones first), or NULL if out of memory
+static Pet *collect_pets(size_t *count) {
+  const size_t catalogue = PET_CATALOGUE_SIZE;
+  Pet *all = malloc((catalogue + added_pets.count) * sizeof(Pet));
+  if (all == NULL) {
+    return NULL;
+  }
+  for (size_t index = 0; index < catalogue; index++) {
+    all[index] = CATALOGUE_PET(index);
+  }
+  *count = catalogue + pet_map_values(&added_pets, &all[catalogue]);
+  return all;
+}
+
+// Rebuilds the sorted index of all pets if needed
+static bool sort_pets(void) {
+  if (!pets_in_order_stale) {
+    return true;
+  }
+  size_t count;
+  Pet *all = collect_pets(&count);
+  if (all == NULL) {
+    return false;
+  }
+  pet_index_free(&pets_in_order);
+  pets_in_order_stale = !pet_index_build(&pets_in_order, all, count);
+  free(all);
+  return !pets_in_order_stale;
+}
+
+// Rebuilds the index of all pets by name if needed
+static bool index_pet_names(void) {
+  if (!pets_by_name_stale) {
+    return true;
+  }
+  size_t count;
+  Pet *all = collect_pets(&count);
+  if (all == NULL) {
+    return false;
+  }
+  name_index_free(&pets_by_name);
+  pets_by_name_stale = !name_index_build(&pets_by_name, all, count);
+  free(all);
+  return !pets_by_name_stale;
+}
+
+// Gives the supplied pet a position in the status bitmaps
+static bool index_pet_status(Pet pet) {
+  const size_t position = status_bitmap_append(&pets_by_status, pet);
+  return position != SIZE_MAX
+      && (find_catalogue_pet(hash_map_hash_int(PET_ID(pet))) == pet
+          || pet_position_map_put(&added_positions, PET_ID(pet), position));
+}
+
+// Returns the position of a pet of the store in the status bitmaps
+static OPTIONAL(size_t) find_pet_position(Pet pet) {
+  const uint64_t hash = hash_map_hash_int(PET_ID(pet));
+  const size_t index = find_catalogue_index(hash);
+  if (CATALOGUE_PET(index) == pet) {
+    return (OPTIONAL(size_t)) OPTIONAL_PRESENT(index);
+  }
+  // The pet may have the id of a pet of the store without being in it
+  OPTIONAL(size_t) position = pet_position_map_get(&added_positions,
+                                                   PET_ID(pet));
+  if (OPTIONAL_IS_PRESENT(position)
+      && pets_by_status.pets[OPTIONAL_USE_VALUE(position)] != pet) {
+    return (OPTIONAL(size_t)) OPTIONAL_EMPTY;
+  }
+  return position;
+}
+
+// Leaves the supplied pet of the store with its current status in the
+// status bitmaps (with the lock held)
+static void reindex_pet_status(Pet pet) {
+  const OPTIONAL(size_t) position = find_pet_position(pet);
+  if (OPTIONAL_IS_PRESENT(position)) {
+    status_bitmap_set(&pets_by_status, OPTIONAL_USE_VALUE(position),
+                      (pet_status) atomic_load_explicit(&PET_STATUS(pet),
+                                                        memory_order_acquire));
+  }
+}
+
+// Builds the status bitmaps if needed
+static bool index_pet_statuses(void) {
+  if (atomic_load_explicit(&pets_by_status_built, memory_order_acquire)) {
+    return true;
+  }
+  (void) pthread_mutex_lock(&pets_by_status_lock);
+  bool built = atomic_load_explicit(&pets_by_status_built,
+                                    memory_order_relaxed);
+  size_t count = 0;
+  Pet *all = built ? NULL : collect_pets(&count);
+  if (!built) {
+    built = all != NULL
+      && pet_position_map_init(&added_positions, added_pets.count)
+      && status_bitmap_reserve(&pets_by_status, count);
+    for (size_t index = 0; built && index < count; index++) {
+      built = index_pet_status(all[index]);
+    }
+    if (!built) {
+      status_bitmap_free(&pets_by_status);
+      pet_position_map_free(&added_positions);
+    } else {
+      atomic_store_explicit(&pets_by_status_built, true, memory_order_release);
+      // Pairs with the fence in update_pet_status_index: buyers that didn't
+      // see the bitmaps published changed statuses that are seen from here
+      atomic_thread_fence(memory_order_seq_cst);
+      for (size_t index = 0; index < count; index++) {
+        reindex_pet_status(all[index]);
+      }
+    }
+  }
+  free(all);
+  (void) pthread_mutex_unlock(&pets_by_status_lock);
+  return built;
+}
+
+// Updates the status bitmaps after the status of a pet has changed, unless
+// they are yet to be built
+static void update_pet_status_index(Pet pet) {
+  // Pairs with the fence in index_pet_statuses
+  atomic_thread_fence(memory_order_seq_cst);
+  if (atomic_load_explicit(&pets_by_status_built, memory_order_acquire)) {
+    (void) pthread_mutex_lock(&pets_by_status_lock);
+    reindex_pet_status(pet);
+    (void) pthread_mutex_unlock(&pets_by_status_lock);
+  }
+}
+
 // Returns a textual description of the supplied error code
 const char *pet_error_message(pet_error code) {
   switch (code) {
@@ -48,24 +429,316 @@ const char *pet_status_name(pet_status status) {
   }
 }
 
-// Returns a pet by id
-OPTIONAL(Pet) find_pet(int pet_id) {
-  for (int index = 0; index < sizeof(pets) / sizeof(pets[0]); index++) {
-    Pet pet = &pets[index];
-    if (PET_ID(pet) == pet_id) {
-      return (OPTIONAL(Pet)) OPTIONAL_PRESENT(pet);
+// Returns a pet by id (or PET_NOT_FOUND)
+RESULT(Pet, pet_error) find_pet(int pet_id) {
+  const uint64_t hash = hash_map_hash_int(pet_id);
+  Pet pet = find_catalogue_pet(hash);
+  if (PET_ID(pet) == pet_id) {
+    return (RESULT(Pet, pet_error)) RESULT_SUCCESS(pet);
+  }
+  if (added_pets.count == 0) {
+    return (RESULT(Pet, pet_error)) RESULT_FAILURE(PET_NOT_FOUND);
+  }
+  const OPTIONAL(Pet) added = find_added_pet_cached(pet_id, hash);
+  return RESULT_FROM_OPTIONAL(added, PET_NOT_FOUND, RESULT(Pet, pet_error));
+}
+
+// Returns the lookup cache counters of the calling thread
+pet_cache_stats get_pet_cache_stats(void) {
+  return pet_cache_counters;
+}
+
+// Returns many pets by id, overlapping the cache misses of a group of lookups
+void find_pets(const int *pet_ids, size_t count, OPTIONAL(Pet) *found) {
+  uint64_t hashes[PET_BATCH_SIZE];
+  size_t slots[PET_BATCH_SIZE];
+  for (size_t first = 0; first < count; first += PET_BATCH_SIZE) {
+    const size_t size = count - first < PET_BATCH_SIZE
+                      ? count - first : PET_BATCH_SIZE;
+    const int *ids = &pet_ids[first];
+    // Each stage prefetches what the next one is going to read
+    for (size_t index = 0; index < size; index++) {
+      hashes[index] = hash_map_hash_int(ids[index]);
+      __builtin_prefetch(&CATALOGUE_DISPLACEMENTS[
+        perfect_hash_bucket(hashes[index], CATALOGUE_BUCKETS)]);
+    }
+    for (size_t index = 0; index < size; index++) {
+      const size_t bucket = perfect_hash_bucket(hashes[index],
+                                                CATALOGUE_BUCKETS);
+      slots[index] = perfect_hash_slot(
+        hashes[index], CATALOGUE_DISPLACEMENTS[bucket], CATALOGUE_MASK);
+      __builtin_prefetch(&CATALOGUE_SLOTS[slots[index]]);
+    }
+    for (size_t index = 0; index < size; index++) {
+      __builtin_prefetch(
+        &PET_ID(CATALOGUE_PET(CATALOGUE_SLOTS[slots[index]])));
+    }
+    for (size_t index = 0; index < size; index++) {
+      Pet pet = CATALOGUE_PET(CATALOGUE_SLOTS[slots[index]]);
+      found[first + index] = PET_ID(pet) == ids[index]
+                           ? (OPTIONAL(Pet)) OPTIONAL_PRESENT(pet)
+                           : (OPTIONAL(Pet)) OPTIONAL_EMPTY;
+    }
+    // Look up the rest among the pets added at runtime
+    size_t misses = 0;
+    size_t positions[PET_BATCH_SIZE];
+    int missing[PET_BATCH_SIZE];
+    OPTIONAL(Pet) added[PET_BATCH_SIZE];
+    for (size_t index = 0; index < size; index++) {
+      if (OPTIONAL_IS_EMPTY(found[first + index])
+          && may_have_been_added(hashes[index])) {
+        positions[misses] = first + index;
+        missing[misses++] = ids[index];
+      }
+    }
+    pet_map_get_batch(&added_pets, missing, misses, added);
+    for (size_t miss = 0; miss < misses; miss++) {
+      found[positions[miss]] = added[miss];
     }
   }
-  return (OPTIONAL(Pet)) OPTIONAL_EMPTY;
 }
 
-// Sets the status of the supplied pet to SOLD (if available)
-OPTIONAL(Pet) buy_pet(Pet pet) {
-  if (PET_STATUS(pet) != AVAILABLE) {
+// Adds a new pet to the store (unless its id is already taken)
+OPTIONAL(Pet) add_pet(Pet pet) {
+  if (RESULT_IS_SUCCESS(find_pet(PET_ID(pet)))
+      || (added_pets.slots == NULL && !pet_map_init(&added_pets, 0))
+      || !pet_map_put(&added_pets, PET_ID(pet), pet)) {
     return (OPTIONAL(Pet)) OPTIONAL_EMPTY;
   }
-  PET_STATUS(pet) = SOLD;
+  if (added_pets.count > added_ids_capacity) {
+    (void) filter_added_pets(2 * added_pets.count + PET_FILTER_MIN_CAPACITY);
+  } else if (added_ids.data != NULL) {
+    bloom_filter_add(&added_ids, hash_map_hash_int(PET_ID(pet)));
+  }
+  pets_in_order_stale = true;
+  pets_by_name_stale = true;
+  if (atomic_load_explicit(&pets_by_status_built, memory_order_relaxed)
+      && !index_pet_status(pet)) {
+    // Start over on the next query
+    status_bitmap_free(&pets_by_status);
+    pet_position_map_free(&added_positions);
+    atomic_store_explicit(&pets_by_status_built, false, memory_order_relaxed);
+  }
+  atomic_fetch_add_explicit(&pet_generation, 1, memory_order_release);
   return (OPTIONAL(Pet)) OPTIONAL_PRESENT(pet);
 }
 
+// Tunes the filter of pets added at runtime (zero max_bytes disables it);
+// fails unless the false-positive rate is strictly between zero and one
+bool set_pet_filter(double false_positive_rate, size_t max_bytes) {
+  if (!bloom_filter_valid_fpp(false_positive_rate)) {
+    return false;
+  }
+  filter_false_positive_rate = false_positive_rate;
+  filter_max_bytes = max_bytes;
+  return filter_added_pets(2 * added_pets.count + PET_FILTER_MIN_CAPACITY);
+}
+
+// Returns an iterator over the pets with ids in [from, to)
+// (adding new pets invalidates the iterators returned so far)
+struct pet_range find_pets_in_range(int from, int to) {
+  if (!sort_pets()) {
+    return (struct pet_range) {.node = 0};
+  }
+  return pet_index_range(&pets_in_order, from, to);
+}
+
+// Returns a pet by name (one of them, catalogue pets first, if several share
+// it)
+OPTIONAL(Pet) find_pet_by_name(const char *name) {
+  if (!index_pet_names()) {
+    return (OPTIONAL(Pet)) OPTIONAL_EMPTY;
+  }
+  return name_index_find(&pets_by_name, name);
+}
+
+// Returns an iterator over the pets with the supplied name, ignoring case
+// (adding new pets invalidates the iterators returned so far)
+struct pet_name_range find_pets_by_name_ignoring_case(const char *name) {
+  if (!index_pet_names()) {
+    return (struct pet_name_range) {.next = 0, .end = 0};
+  }
+  return name_index_ignoring_case(&pets_by_name, name);
+}
+
+// Returns an iterator over the pets whose names start with `prefix`
+// (adding new pets invalidates the iterators returned so far)
+struct pet_name_range find_pets_by_name_prefix(const char *prefix) {
+  if (!index_pet_names()) {
+    return (struct pet_name_range) {.next = 0, .end = 0};
+  }
+  return name_index_prefix(&pets_by_name, prefix);
+}
+
+// Returns an iterator over the pets whose status is in `any_of` and in
+// `all_of` (sets of PET_STATUS_MASK; an empty set matches every pet)
+// (adding new pets invalidates the iterators returned so far)
+struct status_bitmap_iterator find_pets_by_status(unsigned any_of,
+                                                  unsigned all_of) {
+  if (!index_pet_statuses()) {
+    return (struct status_bitmap_iterator) {.bitmap = NULL};
+  }
+  return status_bitmap_query(&pets_by_status, any_of, all_of);
+}
+
+// Sets the status of the supplied pet to SOLD (if available), or fails with
+// PET_ALREADY_SOLD or PET_NOT_AVAILABLE
+// (when many threads buy the same pet, only one of them succeeds)
+RESULT(Pet, pet_error) buy_pet(Pet pet) {
+#ifdef PET_STORE_LOG
+  // A logged sale keeps the pet PENDING until the record is durable
+  const pet_status_value claimed = sales_log_open ? PENDING : SOLD;
+#else
+  const pet_status_value claimed = SOLD;
+#endif
+  // Plain load first, so that losers don't take the cache line exclusively
+  pet_status_value expected = atomic_load_explicit(&PET_STATUS(pet),
+                                                   memory_order_acquire);
+  if (expected != AVAILABLE
+      || !atomic_compare_exchange_strong_explicit(&PET_STATUS(pet), &expected,
+                                                  claimed,
+                                                  memory_order_acq_rel,
+                                                  memory_order_acquire)) {
+    // Either way, `expected` now holds the status that beat us
+    return (RESULT(Pet, pet_error)) RESULT_FAILURE(
+      expected == SOLD ? PET_ALREADY_SOLD : PET_NOT_AVAILABLE);
+  }
+#ifdef PET_STORE_LOG
+  if (claimed == PENDING) {
+    const bool logged = pet_log_append(&sales_log, PET_ID(pet), SOLD);
+    atomic_store_explicit(&PET_STATUS(pet), logged ? SOLD : AVAILABLE,
+                          memory_order_release);
+    if (!logged) {
+      update_pet_status_index(pet);
+      // The pet is available again, but this sale didn't go through
+      return (RESULT(Pet, pet_error)) RESULT_FAILURE(PET_NOT_AVAILABLE);
+    }
+  }
+#endif
+  update_pet_status_index(pet);
+  return (RESULT(Pet, pet_error)) RESULT_SUCCESS(pet);
+}
+
+#ifdef PET_STORE_LOG
+// Restores the status of a pet from the log (skipping unknown statuses)
+static void replay_sale(const struct pet_log_record *record, void *context) {
+  (void) context;
+  if (record->status > SOLD) {
+    return;
+  }
+  const RESULT(Pet, pet_error) pet = find_pet(record->pet_id);
+  if (RESULT_IS_SUCCESS(pet)) {
+    atomic_store_explicit(&PET_STATUS(RESULT_USE_VALUE(pet)),
+                          record->status, memory_order_release);
+  }
+}
+
+// Replays a log of sales and appends to it from then on; concurrent sales
+// are written in batches of up to max_batch, waiting up to max_latency_ns
+// for a batch to fill up (a batch of one disables group commit)
+bool open_pet_log(const char *path, size_t max_batch, long max_latency_ns) {
+  if (sales_log_open
+      || !pet_log_open(&sales_log, path, max_batch, max_latency_ns,
+                       replay_sale, NULL)) {
+    return false;
+  }
+  // Statuses may have changed under the status bitmaps
+  status_bitmap_free(&pets_by_status);
+  pet_position_map_free(&added_positions);
+  atomic_store_explicit(&pets_by_status_built, false, memory_order_relaxed);
+  sales_log_open = true;
+  return true;
+}
+
+// Stops logging sales (no pets may be being bought)
+void close_pet_log(void) {
+  if (sales_log_open) {
+    pet_log_close(&sales_log);
+    sales_log_open = false;
+  }
+}
+#endif
+
+#ifdef PET_STORE_SOA
+// Stores a new pet and returns its handle (the pet still has to be added)
+OPTIONAL(Pet) new_pet(int id, const char *name, pet_status status) {
+  if (catalogue_shared) {
+    return (OPTIONAL(Pet)) OPTIONAL_EMPTY;
+  }
+  const size_t row = pet_columns_append(&pet_store_columns, id, name,
+                                        (uint8_t) status);
+  if (row == SIZE_MAX) {
+    return (OPTIONAL(Pet)) OPTIONAL_EMPTY;
+  }
+  return (OPTIONAL(Pet)) OPTIONAL_PRESENT(PET_HANDLE(row));
+}
+
+// Uses a mapped catalogue in place of the current one
+static void use_catalogue_file(struct pet_catalogue_file file, bool shared) {
+  pet_columns_free(&pet_store_columns);
+  pet_store_columns = (struct pet_columns) {
+    .count = file.count,
+    .capacity = file.count,
+    .ids = file.ids,
+    .statuses = (_Atomic uint8_t *) file.statuses,
+    .names = file.names,
+    .strings = file.strings,
+    .strings_size = file.strings_size,
+    .strings_capacity = file.strings_size,
+    .borrowed = true
+  };
+  catalogue_size = file.count;
+  catalogue_hash = file.hash;
+  catalogue_shared = shared;
+  pet_catalogue_file_unmap(&catalogue_file);
+  catalogue_file = file;
+  // Whatever was built from the previous catalogue is stale now
+  pets_in_order_stale = true;
+  pets_by_name_stale = true;
+  status_bitmap_free(&pets_by_status);
+  atomic_store_explicit(&pets_by_status_built, false, memory_order_relaxed);
+  atomic_fetch_add_explicit(&pet_generation, 1, memory_order_release);
+}
+
+// Replaces the static catalogue with a catalogue file, which is mapped into
+// memory and used in place (only before any pets are created or added)
+bool open_pet_catalogue(const char *path) {
+  struct pet_catalogue_file file;
+  if (added_pets.count != 0 || pet_store_columns.count != catalogue_size
+      || !pet_catalogue_file_map(&file, path)) {
+    return false;
+  }
+  use_catalogue_file(file, false);
+  return true;
+}
+
+// Shares the catalogue with the other processes that open the same shared
+// memory object (a name starting with a slash); the first one to open it
+// copies its own catalogue into it. Pets bought by any of the processes are
+// sold for all of them, but no more pets can be created afterwards (and
+// find_pets_by_status only keeps track of the sales of this process)
+bool open_shared_pet_catalogue(const char *name) {
+  if (added_pets.count != 0 || pet_store_columns.count != catalogue_size) {
+    return false;
+  }
+  int *ids = pet_store_columns.ids;
+  uint8_t *statuses = malloc(catalogue_size);
+  const char **names = malloc(catalogue_size * sizeof(char *));
+  struct pet_catalogue_file file;
+  bool opened = statuses != NULL && names != NULL;
+  for (size_t row = 0; opened && row < catalogue_size; row++) {
+    statuses[row] = atomic_load(&pet_store_columns.statuses[row]);
+    names[row] = pet_columns_name(&pet_store_columns, row);
+  }
+  opened = opened && shared_pet_catalogue_open(&file, name, ids, statuses,
+                                               names, catalogue_size);
+  free(statuses);
+  free(names);
+  if (opened) {
+    use_catalogue_file(file, true);
+  }
+  return opened;
+}
+#endif
+
 //! [source]
@@ -19,13 +19,14 @@
 #define PET_STORE_H
 
 #include <optional.h>
+#include "result.h"
 
 //! [types]
 // Pet status in the store
 typedef enum pet_status {AVAILABLE, PENDING, SOLD} pet_status;
 
-// Represents a pet
-typedef struct pet {int id; const char *name; pet_status status;} *Pet;
+// Represents a pet (its status may be changed concurrently)
+typedef struct pet {int id; const char *name; _Atomic pet_status status;} *Pet;
 
 // Convenience macros
 #define PET_ID(pet) (pet)->id
@@ -36,14 +37,52 @@ typedef struct pet {int id; const char *name; pet_status status;} *Pet;
 typedef enum pet_error {OK, PET_NOT_FOUND, PET_NOT_AVAILABLE, PET_ALREADY_SOLD} pet_error;
 //! [types]
 
-// Optional type used by the pet store
+#ifdef PET_STORE_SOA
+// Struct-of-arrays mode: pets are stored column by column, and a Pet is a
+// handle to a row that can only be accessed through the convenience macros
+#include <stdint.h>
+#include "pet-columns.h"
+extern struct pet_columns pet_store_columns;
+#define PET_HANDLE(row) ((Pet) (uintptr_t) ((row) + 1))
+#define PET_ROW(pet) ((size_t) (uintptr_t) (pet) - 1)
+#undef PET_ID
+#undef PET_NAME
+#undef PET_STATUS
+#define PET_ID(pet) pet_store_columns.ids[PET_ROW(pet)]
+#define PET_NAME(pet) pet_columns_name(&pet_store_columns, PET_ROW(pet))
+#define PET_STATUS(pet) pet_store_columns.statuses[PET_ROW(pet)]
+#endif
+
+// Optional and result types used by the pet store
 OPTIONAL_STRUCT(Pet);
+RESULT_STRUCT(Pet, pet_error);
+
+// Lookup cache counters
+typedef struct pet_cache_stats {unsigned long hits; unsigned long misses;} pet_cache_stats;
 
 // Pet store API
 const char *pet_error_message(pet_error code);
 const char *pet_status_name(pet_status status);
-OPTIONAL(Pet) find_pet(int pet_id);
-OPTIONAL(Pet) buy_pet(Pet pet);
+RESULT(Pet, pet_error) find_pet(int pet_id);
+OPTIONAL(Pet) find_pet_by_name(const char *name);
+struct pet_name_range find_pets_by_name_ignoring_case(const char *name);
+struct pet_name_range find_pets_by_name_prefix(const char *prefix);
+void find_pets(const int *pet_ids, size_t count, OPTIONAL(Pet) *found);
+pet_cache_stats get_pet_cache_stats(void);
+RESULT(Pet, pet_error) buy_pet(Pet pet);
+OPTIONAL(Pet) add_pet(Pet pet);
+#ifdef PET_STORE_SOA
+OPTIONAL(Pet) new_pet(int id, const char *name, pet_status status);
+bool open_pet_catalogue(const char *path);
+bool open_shared_pet_catalogue(const char *name);
+#endif
+#ifdef PET_STORE_LOG
+bool open_pet_log(const char *path, size_t max_batch, long max_latency_ns);
+void close_pet_log(void);
+#endif
+bool set_pet_filter(double false_positive_rate, size_t max_bytes);
+struct pet_range find_pets_in_range(int from, int to);
+struct status_bitmap_iterator find_pets_by_status(unsigned any_of, unsigned all_of);
 
 #endif
 //! [header]
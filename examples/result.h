@@ -0,0 +1,140 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef RESULT_H
+#define RESULT_H
+
+#include <stdbool.h>
+#include <optional.h>
+
+// Results: like an Optional, but a failed result tells why it failed.
+//
+//   RESULT_STRUCT(type, error_type)   declares RESULT(type, error_type)
+//   RESULT(type, error_type)          a value or an error code
+//
+// A result has the layout of an Optional, with the error code taking the
+// place of the `_empty` flag; zero means success, so error_type should be
+// an enum (or an integer type) whose first constant is a success code. A
+// result costs no more than an Optional of the same type whenever the error
+// code fits in the padding that follows the flag, which is the case of an
+// enum and a pointer- or int-sized value:
+//
+//   RESULT(Pet, pet_error) result = RESULT_FAILURE(PET_NOT_FOUND);
+//   OPTIONAL(Pet) optional = RESULT_TO_OPTIONAL(result, OPTIONAL(Pet));
+//
+// Like the OPTIONAL_* macros, the macros that take a result as an argument
+// expect an lvalue (or evaluate it more than once).
+
+#define RESULT_TAG(type_name, error_name)                                     \
+  result_ ## type_name ## _ ## error_name
+
+#define RESULT(type_name, error_name)                                         \
+  struct RESULT_TAG(type_name, error_name)
+
+#define RESULT_STRUCT(type, error_type)                                       \
+  RESULT(type, error_type) {                                                  \
+    error_type _error;                                                        \
+    type _value;                                                              \
+  }
+
+// Initializes a successful result (with a value)
+#define RESULT_SUCCESS(value)                                                 \
+  {                                                                           \
+    ._error = 0,                                                              \
+    ._value = (value)                                                         \
+  }
+
+// Initializes a failed result (with a non-zero error code)
+#define RESULT_FAILURE(error)                                                 \
+  {                                                                           \
+    ._error = (error),                                                        \
+  }
+
+#define RESULT_IS_SUCCESS(result)                                             \
+  ((result)._error == 0)
+
+#define RESULT_IS_FAILURE(result)                                             \
+  ((result)._error != 0)
+
+// Returns the value of a result (which must be successful)
+#define RESULT_USE_VALUE(result)                                              \
+  ((result)._value)
+
+// Returns the error code of a result (zero if successful)
+#define RESULT_USE_ERROR(result)                                              \
+  ((result)._error)
+
+// Returns the value of a result, or `other` if it failed
+#define RESULT_OR_ELSE(result, other)                                         \
+  (                                                                           \
+    (void) &(result),                                                         \
+    RESULT_IS_FAILURE(result)                                                 \
+    ? (other)                                                                 \
+    : RESULT_USE_VALUE(result)                                                \
+  )
+
+// Performs `success_action` with the value of a result, or `failure_action`
+// with its error code
+#define RESULT_IF_SUCCESS_OR_ELSE(result, success_action, failure_action)     \
+  do {                                                                        \
+    typeof(result) _result = (result);                                        \
+    if (RESULT_IS_FAILURE(_result)) {                                         \
+      (void) (failure_action(RESULT_USE_ERROR(_result)));                     \
+    } else {                                                                  \
+      (void) (success_action(RESULT_USE_VALUE(_result)));                     \
+    }                                                                         \
+  } while(false)
+
+// Transforms the value of a successful result; a failed one keeps its error
+#define RESULT_MAP(result, mapper, result_type)                               \
+  (                                                                           \
+    (void) &(result),                                                         \
+    RESULT_IS_FAILURE(result)                                                 \
+    ? (result_type) RESULT_FAILURE(RESULT_USE_ERROR(result))                  \
+    : (result_type) RESULT_SUCCESS(mapper(RESULT_USE_VALUE(result)))          \
+  )
+
+// Transforms a successful result into the one returned by `mapper`, which
+// must use the same error type; a failed one keeps its error
+#define RESULT_FLAT_MAP(result, mapper)                                       \
+  (                                                                           \
+    (void) &(result),                                                         \
+    RESULT_IS_FAILURE(result)                                                 \
+    ? (typeof(mapper(RESULT_USE_VALUE(result))))                              \
+      RESULT_FAILURE(RESULT_USE_ERROR(result))                                \
+    : (mapper(RESULT_USE_VALUE(result)))                                      \
+  )
+
+// Converts a result into an Optional, dropping the error code
+#define RESULT_TO_OPTIONAL(result, optional_type)                             \
+  (                                                                           \
+    (void) &(result),                                                         \
+    RESULT_IS_FAILURE(result)                                                 \
+    ? (optional_type) OPTIONAL_EMPTY                                          \
+    : (optional_type) OPTIONAL_PRESENT(RESULT_USE_VALUE(result))              \
+  )
+
+// Converts an Optional into a result, failing with `error` if it is empty
+#define RESULT_FROM_OPTIONAL(optional, error, result_type)                    \
+  (                                                                           \
+    (void) &(optional),                                                       \
+    OPTIONAL_IS_EMPTY(optional)                                               \
+    ? (result_type) RESULT_FAILURE(error)                                     \
+    : (result_type) RESULT_SUCCESS(OPTIONAL_USE_VALUE(optional))              \
+  )
+
+#endif
@@ -0,0 +1,177 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SHARDED_PET_STORE_H
+#define SHARDED_PET_STORE_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <optional.h>
+#include "epoch-reclamation.h"
+#include "hash-map.h"
+#include "pet-store.h"
+
+// Pet store for read-mostly workloads.
+//
+// Pets are spread across shards by id. Every shard publishes an immutable
+// snapshot (an open-addressing table of pets) that readers look up without
+// locks; writers of a shard serialize on its mutex, copy the snapshot with
+// their change and publish the copy. Old snapshots are freed through
+// epoch-based reclamation once no reader can be using them.
+//
+// Status changes need no new snapshot: buy_pet already updates the status
+// of a pet atomically.
+
+// Number of shards of a store
+#define PET_SHARDS 64
+
+// Immutable table of the pets of a shard (at most half full)
+struct pet_shard_snapshot {
+  struct epoch_node retired;
+  size_t count;
+  size_t mask;
+  Pet slots[];
+};
+
+struct pet_shard {
+  _Alignas(64) _Atomic(struct pet_shard_snapshot *) snapshot;
+  pthread_mutex_t lock;
+};
+
+struct sharded_pet_store {
+  struct epoch_domain epochs;
+  struct pet_shard shards[PET_SHARDS];
+};
+
+static inline struct pet_shard *sharded_pet_store_shard(
+    struct sharded_pet_store *store, uint64_t hash) {
+  return &store->shards[(hash >> 32) % PET_SHARDS];
+}
+
+static inline bool sharded_pet_store_init(struct sharded_pet_store *store) {
+  if (!epoch_init(&store->epochs)) {
+    return false;
+  }
+  for (size_t index = 0; index < PET_SHARDS; index++) {
+    atomic_init(&store->shards[index].snapshot, NULL);
+    if (pthread_mutex_init(&store->shards[index].lock, NULL) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Frees the store (no reader or writer may be active)
+static inline void sharded_pet_store_free(struct sharded_pet_store *store) {
+  for (size_t index = 0; index < PET_SHARDS; index++) {
+    free(atomic_load(&store->shards[index].snapshot));
+    (void) pthread_mutex_destroy(&store->shards[index].lock);
+  }
+  epoch_free(&store->epochs);
+}
+
+// Returns the announcement slot of a new reader thread, or NULL
+static inline struct epoch_reader *sharded_pet_store_register(
+    struct sharded_pet_store *store) {
+  return epoch_register(&store->epochs);
+}
+
+// Returns the pet with the supplied id in a snapshot, or NULL
+static inline Pet pet_shard_snapshot_find(
+    const struct pet_shard_snapshot *snapshot, int pet_id, uint64_t hash) {
+  if (snapshot == NULL) {
+    return NULL;
+  }
+  for (size_t index = hash & snapshot->mask; snapshot->slots[index] != NULL;
+       index = (index + 1) & snapshot->mask) {
+    if (PET_ID(snapshot->slots[index]) == pet_id) {
+      return snapshot->slots[index];
+    }
+  }
+  return NULL;
+}
+
+// Finds a pet by id; the reader must belong to the calling thread
+static inline OPTIONAL(Pet) sharded_pet_store_find(
+    struct sharded_pet_store *store, struct epoch_reader *reader,
+    int pet_id) {
+  const uint64_t hash = hash_map_hash_int(pet_id);
+  const struct pet_shard *shard = sharded_pet_store_shard(store, hash);
+  epoch_enter(&store->epochs, reader);
+  // Pets outlive the snapshots, so they can be used after leaving
+  Pet pet = pet_shard_snapshot_find(
+    atomic_load_explicit(&shard->snapshot, memory_order_acquire),
+    pet_id, hash);
+  epoch_exit(reader);
+  return (OPTIONAL(Pet)) OPTIONAL_OF_NULLABLE(pet);
+}
+
+// Places a pet in a snapshot that has room for it
+static inline void pet_shard_snapshot_place(
+    struct pet_shard_snapshot *snapshot, Pet pet) {
+  size_t index = hash_map_hash_int(PET_ID(pet)) & snapshot->mask;
+  while (snapshot->slots[index] != NULL) {
+    index = (index + 1) & snapshot->mask;
+  }
+  snapshot->slots[index] = pet;
+}
+
+// Adds a new pet to the store (unless its id is already taken);
+// the caller owns the pet, which must outlive the store
+static inline OPTIONAL(Pet) sharded_pet_store_add(
+    struct sharded_pet_store *store, Pet pet) {
+  const uint64_t hash = hash_map_hash_int(PET_ID(pet));
+  struct pet_shard *shard = sharded_pet_store_shard(store, hash);
+  (void) pthread_mutex_lock(&shard->lock);
+  // Only writers holding the lock replace the snapshot
+  struct pet_shard_snapshot *old = atomic_load_explicit(
+    &shard->snapshot, memory_order_relaxed);
+  const size_t count = old != NULL ? old->count : 0;
+  size_t slots = HASH_MAP_MIN_CAPACITY;
+  while (slots / 2 < count + 1) {
+    slots *= 2;
+  }
+  struct pet_shard_snapshot *new = NULL;
+  if (pet_shard_snapshot_find(old, PET_ID(pet), hash) != NULL
+      || (new = calloc(1, sizeof(*new) + slots * sizeof(Pet))) == NULL) {
+    (void) pthread_mutex_unlock(&shard->lock);
+    return (OPTIONAL(Pet)) OPTIONAL_EMPTY;
+  }
+  new->count = count + 1;
+  new->mask = slots - 1;
+  if (old != NULL && old->mask == new->mask) {
+    memcpy(new->slots, old->slots, slots * sizeof(Pet));
+  } else {
+    for (size_t index = 0; old != NULL && index <= old->mask; index++) {
+      if (old->slots[index] != NULL) {
+        pet_shard_snapshot_place(new, old->slots[index]);
+      }
+    }
+  }
+  pet_shard_snapshot_place(new, pet);
+  atomic_store_explicit(&shard->snapshot, new, memory_order_release);
+  (void) pthread_mutex_unlock(&shard->lock);
+  if (old != NULL) {
+    epoch_retire(&store->epochs, &old->retired, old);
+  }
+  return (OPTIONAL(Pet)) OPTIONAL_PRESENT(pet);
+}
+
+#endif
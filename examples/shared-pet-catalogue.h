@@ -0,0 +1,162 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SHARED_PET_CATALOGUE_H
+#define SHARED_PET_CATALOGUE_H
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "pet-catalogue-file.h"
+
+// Pet catalogue shared by the processes of a host.
+//
+// The catalogue lives in a POSIX shared memory object, laid out exactly as
+// a catalogue file: every reference in it is an offset, so each process can
+// map it at a different address. The first process to open the object
+// fills it in under a temporary name and then links it to the real one, so
+// the others only ever see complete catalogues, and a process that dies
+// while filling one in leaves nothing behind under the real name. Processes
+// change statuses with atomic operations on the shared mapping and never
+// take locks on it, so a process that dies at any point leaves the catalogue
+// consistent.
+
+// Where the shared memory objects can be linked (as on Linux)
+#define SHARED_PET_CATALOGUE_DIRECTORY "/dev/shm"
+
+// How many temporary names to try when creating a catalogue
+#define SHARED_PET_CATALOGUE_ATTEMPTS 100
+
+// Counts the catalogues created by this process, to name them apart
+static atomic_uint shared_pet_catalogue_serial;
+
+// Fills in a new shared catalogue with the supplied pets
+static inline bool shared_pet_catalogue_fill(int descriptor, const int *ids,
+                                             const uint8_t *statuses,
+                                             const char *const *names,
+                                             size_t count) {
+  size_t size = 0;
+  char *image = pet_catalogue_file_image(ids, statuses, names, count, &size);
+  void *data = MAP_FAILED;
+  if (image != NULL && ftruncate(descriptor, (off_t) size) == 0) {
+    data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+  }
+  if (data == MAP_FAILED) {
+    free(image);
+    return false;
+  }
+  // Publish the magic only once everything else is in place
+  uint64_t magic;
+  memcpy(&magic, image, sizeof(magic));
+  memcpy((char *) data + sizeof(magic), image + sizeof(magic),
+         size - sizeof(magic));
+  atomic_store_explicit((_Atomic uint64_t *) data, magic,
+                        memory_order_release);
+  free(image);
+  (void) munmap(data, size);
+  return true;
+}
+
+// Returns true if a shared catalogue has been filled in
+static inline bool shared_pet_catalogue_ready(int descriptor) {
+  const size_t size = sizeof(struct pet_catalogue_file_header);
+  struct stat status;
+  if (fstat(descriptor, &status) != 0 || (size_t) status.st_size < size) {
+    return false;
+  }
+  void *header = mmap(NULL, size, PROT_READ, MAP_SHARED, descriptor, 0);
+  if (header == MAP_FAILED) {
+    return false;
+  }
+  const uint64_t magic = atomic_load_explicit((_Atomic uint64_t *) header,
+                                              memory_order_acquire);
+  (void) munmap(header, size);
+  return memcmp(&magic, PET_CATALOGUE_FILE_MAGIC, sizeof(magic)) == 0;
+}
+
+// Creates a shared catalogue with the supplied pets under a temporary name
+// and links it to the supplied one; returns a descriptor of the catalogue
+// linked to that name (maybe by another process) or -1
+static inline int shared_pet_catalogue_publish(const char *name,
+                                               const int *ids,
+                                               const uint8_t *statuses,
+                                               const char *const *names,
+                                               size_t count) {
+  char temporary[NAME_MAX + 1];
+  char from[sizeof(SHARED_PET_CATALOGUE_DIRECTORY) + NAME_MAX];
+  char to[sizeof(SHARED_PET_CATALOGUE_DIRECTORY) + NAME_MAX];
+  int descriptor = -1;
+  // Skips the names left behind by dead processes with the same id
+  for (int attempt = 0; descriptor < 0
+                        && attempt < SHARED_PET_CATALOGUE_ATTEMPTS; attempt++) {
+    const int length = snprintf(
+      temporary, sizeof(temporary), "%s.%ld.%u", name, (long) getpid(),
+      atomic_fetch_add(&shared_pet_catalogue_serial, 1));
+    if (length < 0 || (size_t) length >= sizeof(temporary)) {
+      return -1;
+    }
+    descriptor = shm_open(temporary, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (descriptor < 0 && errno != EEXIST) {
+      return -1;
+    }
+  }
+  if (descriptor < 0) {
+    return -1;
+  }
+  (void) snprintf(from, sizeof(from), "%s%s", SHARED_PET_CATALOGUE_DIRECTORY,
+                  temporary);
+  (void) snprintf(to, sizeof(to), "%s%s", SHARED_PET_CATALOGUE_DIRECTORY,
+                  name);
+  const bool filled = shared_pet_catalogue_fill(descriptor, ids, statuses,
+                                                names, count);
+  const bool linked = filled && link(from, to) == 0;
+  const bool existed = filled && !linked && errno == EEXIST;
+  (void) shm_unlink(temporary);
+  if (!linked) {
+    (void) close(descriptor);
+    descriptor = existed ? shm_open(name, O_RDWR, 0) : -1;
+  }
+  return descriptor;
+}
+
+// Maps the shared catalogue with the supplied name (which must start with a
+// slash), creating it with the supplied pets if it does not exist yet
+static inline bool shared_pet_catalogue_open(
+    struct pet_catalogue_file *catalogue, const char *name, const int *ids,
+    const uint8_t *statuses, const char *const *names, size_t count) {
+  int descriptor = shm_open(name, O_RDWR, 0);
+  if (descriptor < 0 && errno == ENOENT) {
+    descriptor = shared_pet_catalogue_publish(name, ids, statuses, names,
+                                              count);
+  }
+  if (descriptor < 0) {
+    return false;
+  }
+  const bool mapped = shared_pet_catalogue_ready(descriptor)
+    && pet_catalogue_file_map_descriptor(catalogue, descriptor, MAP_SHARED);
+  (void) close(descriptor);
+  return mapped;
+}
+
+#endif
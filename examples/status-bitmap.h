@@ -0,0 +1,194 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef STATUS_BITMAP_H
+#define STATUS_BITMAP_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "pet-store.h"
+
+// Pets indexed by status, with one bitmap per status.
+//
+// Every pet gets a position when it is indexed, and bit n of the bitmap of a
+// status is set if the pet at position n has that status. Queries combine
+// bitmaps a 64-bit word at a time and walk the set bits of the result with
+// count-trailing-zeros, so they skip 64 non-matching pets per step.
+
+// Number of pet statuses
+#define PET_STATUSES (SOLD + 1)
+
+// Set of pet statuses (used to combine bitmaps)
+#define PET_STATUS_MASK(status) (1u << (status))
+
+struct status_bitmap {
+  size_t count;
+  size_t capacity;
+  // Pet at each position
+  Pet *pets;
+  // Bitmap of each status (updated concurrently by buy_pet)
+  _Atomic uint64_t *bits[PET_STATUSES];
+};
+
+// Iterates over the pets whose status is in every bitmap of `all_of` and in
+// any bitmap of `any_of` (an empty set puts no constraint)
+struct status_bitmap_iterator {
+  const struct status_bitmap *bitmap;
+  unsigned any_of;
+  unsigned all_of;
+  size_t word;
+  uint64_t bits;
+};
+
+static inline void status_bitmap_free(struct status_bitmap *bitmap) {
+  free(bitmap->pets);
+  for (int status = 0; status < PET_STATUSES; status++) {
+    free(bitmap->bits[status]);
+    bitmap->bits[status] = NULL;
+  }
+  bitmap->pets = NULL;
+  bitmap->count = 0;
+  bitmap->capacity = 0;
+}
+
+// Makes room for at least `capacity` pets
+static inline bool status_bitmap_reserve(struct status_bitmap *bitmap,
+                                         size_t capacity) {
+  if (capacity <= bitmap->capacity) {
+    return true;
+  }
+  // Whole words, and at least doubling so that appending is amortized
+  size_t new_capacity = bitmap->capacity < 64 ? 64 : bitmap->capacity * 2;
+  while (new_capacity < capacity) {
+    new_capacity *= 2;
+  }
+  Pet *pets = realloc(bitmap->pets, new_capacity * sizeof(Pet));
+  if (pets == NULL) {
+    return false;
+  }
+  bitmap->pets = pets;
+  for (int status = 0; status < PET_STATUSES; status++) {
+    _Atomic uint64_t *bits = realloc(bitmap->bits[status],
+                                     new_capacity / 64 * sizeof(uint64_t));
+    if (bits == NULL) {
+      return false;
+    }
+    for (size_t word = bitmap->capacity / 64; word < new_capacity / 64;
+         word++) {
+      atomic_init(&bits[word], 0);
+    }
+    bitmap->bits[status] = bits;
+  }
+  bitmap->capacity = new_capacity;
+  return true;
+}
+
+// Appends a pet; returns its position (or SIZE_MAX if out of memory)
+static inline size_t status_bitmap_append(struct status_bitmap *bitmap,
+                                          Pet pet) {
+  if (!status_bitmap_reserve(bitmap, bitmap->count + 1)) {
+    return SIZE_MAX;
+  }
+  const size_t position = bitmap->count++;
+  bitmap->pets[position] = pet;
+  const pet_status status = atomic_load_explicit(&PET_STATUS(pet),
+                                                 memory_order_acquire);
+  atomic_fetch_or_explicit(&bitmap->bits[status][position / 64],
+                           UINT64_C(1) << (position % 64),
+                           memory_order_relaxed);
+  return position;
+}
+
+// Moves the pet at a position from one status to another
+static inline void status_bitmap_move(struct status_bitmap *bitmap,
+                                      size_t position, pet_status from,
+                                      pet_status to) {
+  const uint64_t bit = UINT64_C(1) << (position % 64);
+  atomic_fetch_or_explicit(&bitmap->bits[to][position / 64], bit,
+                           memory_order_relaxed);
+  atomic_fetch_and_explicit(&bitmap->bits[from][position / 64], ~bit,
+                            memory_order_relaxed);
+}
+
+// Leaves the pet at a position with only the supplied status
+static inline void status_bitmap_set(struct status_bitmap *bitmap,
+                                     size_t position, pet_status status) {
+  const uint64_t bit = UINT64_C(1) << (position % 64);
+  for (int other = 0; other < PET_STATUSES; other++) {
+    if (other == (int) status) {
+      atomic_fetch_or_explicit(&bitmap->bits[other][position / 64], bit,
+                               memory_order_relaxed);
+    } else {
+      atomic_fetch_and_explicit(&bitmap->bits[other][position / 64], ~bit,
+                                memory_order_relaxed);
+    }
+  }
+}
+
+// Returns the word of the query result at the supplied index
+static inline uint64_t status_bitmap_word(
+    const struct status_bitmap *bitmap, unsigned any_of, unsigned all_of,
+    size_t word) {
+  uint64_t any = any_of == 0 ? UINT64_MAX : 0;
+  uint64_t all = UINT64_MAX;
+  for (int status = 0; status < PET_STATUSES; status++) {
+    if (any_of & PET_STATUS_MASK(status)) {
+      any |= atomic_load_explicit(&bitmap->bits[status][word],
+                                  memory_order_relaxed);
+    }
+    if (all_of & PET_STATUS_MASK(status)) {
+      all &= atomic_load_explicit(&bitmap->bits[status][word],
+                                  memory_order_relaxed);
+    }
+  }
+  const uint64_t used = bitmap->count - word * 64 < 64
+    ? (UINT64_C(1) << (bitmap->count - word * 64)) - 1 : UINT64_MAX;
+  return any & all & used;
+}
+
+static inline struct status_bitmap_iterator status_bitmap_query(
+    const struct status_bitmap *bitmap, unsigned any_of, unsigned all_of) {
+  return (struct status_bitmap_iterator) {
+    .bitmap = bitmap,
+    .any_of = any_of,
+    .all_of = all_of,
+    .word = 0,
+    .bits = bitmap->count > 0
+      ? status_bitmap_word(bitmap, any_of, all_of, 0) : 0
+  };
+}
+
+// Returns the next matching pet (or empty, once all of them have been seen)
+static inline OPTIONAL(Pet) status_bitmap_next(
+    struct status_bitmap_iterator *iterator) {
+  const struct status_bitmap *bitmap = iterator->bitmap;
+  while (iterator->bits == 0) {
+    if (bitmap == NULL || ++iterator->word * 64 >= bitmap->count) {
+      return (OPTIONAL(Pet)) OPTIONAL_EMPTY;
+    }
+    iterator->bits = status_bitmap_word(bitmap, iterator->any_of,
+                                        iterator->all_of, iterator->word);
+  }
+  const size_t position = iterator->word * 64
+                        + (size_t) __builtin_ctzll(iterator->bits);
+  // Clear the lowest set bit
+  iterator->bits &= iterator->bits - 1;
+  return (OPTIONAL(Pet)) OPTIONAL_PRESENT(bitmap->pets[position]);
+}
+
+#endif
@@ -0,0 +1,173 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef STRVIEW_H
+#define STRVIEW_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <optional.h>
+
+// Zero-copy string views.
+//
+// A view is a pointer to characters plus a length; it doesn't own them and
+// needs no null terminator. Searches return optional views into the same
+// characters instead of copies or sentinel pointers, so tokenizing a line
+// never allocates. Scanning for a character is left to memchr, which the C
+// library vectorizes.
+
+typedef struct strview {
+  const char *data;
+  size_t length;
+} strview;
+
+OPTIONAL_STRUCT(strview);
+
+// A key and its value
+typedef struct strview_key_value {
+  strview key;
+  strview value;
+} strview_key_value;
+
+OPTIONAL_STRUCT(strview_key_value);
+
+// Splits a view into the tokens between delimiters
+struct strview_splitter {
+  strview rest;
+  char delimiter;
+  bool done;
+};
+
+// Returns a view of a null-terminated string
+static inline strview strview_of(const char *text) {
+  return (strview) {.data = text, .length = strlen(text)};
+}
+
+// Returns a view of characters [from, to) of a view
+static inline strview strview_slice(strview view, size_t from, size_t to) {
+  return (strview) {.data = view.data + from, .length = to - from};
+}
+
+static inline bool strview_equals(strview view, strview other) {
+  return view.length == other.length
+      && (view.length == 0 || memcmp(view.data, other.data, view.length) == 0);
+}
+
+// Returns the rest of a view from the first occurrence of a character
+static inline OPTIONAL(strview) strview_find_char(strview view, char c) {
+  const char *found = view.length > 0 ? memchr(view.data, c, view.length)
+                                      : NULL;
+  if (found == NULL) {
+    return (OPTIONAL(strview)) OPTIONAL_EMPTY;
+  }
+  const size_t from = (size_t) (found - view.data);
+  return (OPTIONAL(strview)) OPTIONAL_PRESENT(
+    strview_slice(view, from, view.length));
+}
+
+// Returns the rest of a view from the first occurrence of a substring
+// (memchr finds candidates for its first character)
+static inline OPTIONAL(strview) strview_find_substr(strview view,
+                                                    strview substr) {
+  if (substr.length == 0) {
+    return (OPTIONAL(strview)) OPTIONAL_PRESENT(view);
+  }
+  for (size_t from = 0; substr.length <= view.length - from;) {
+    const char *found = memchr(view.data + from, substr.data[0],
+                               view.length - from - substr.length + 1);
+    if (found == NULL) {
+      break;
+    }
+    from = (size_t) (found - view.data);
+    if (memcmp(found, substr.data, substr.length) == 0) {
+      return (OPTIONAL(strview)) OPTIONAL_PRESENT(
+        strview_slice(view, from, view.length));
+    }
+    from++;
+  }
+  return (OPTIONAL(strview)) OPTIONAL_EMPTY;
+}
+
+// Returns true for the whitespace of the "C" locale
+static inline bool strview_is_space(char c) {
+  return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// Returns a view without leading and trailing whitespace
+static inline strview strview_trim(strview view) {
+  size_t from = 0;
+  size_t to = view.length;
+  while (from < to && strview_is_space(view.data[from])) {
+    from++;
+  }
+  while (to > from && strview_is_space(view.data[to - 1])) {
+    to--;
+  }
+  return strview_slice(view, from, to);
+}
+
+// Prepares to split a view (a view with no delimiters is one token, and
+// an empty view is one empty token)
+static inline struct strview_splitter strview_split(strview view,
+                                                    char delimiter) {
+  return (struct strview_splitter) {
+    .rest = view,
+    .delimiter = delimiter,
+    .done = false
+  };
+}
+
+// Returns the next token, or an empty optional once the view is exhausted
+static inline OPTIONAL(strview) strview_split_next(
+    struct strview_splitter *splitter) {
+  if (splitter->done) {
+    return (OPTIONAL(strview)) OPTIONAL_EMPTY;
+  }
+  const strview rest = splitter->rest;
+  const char *found = rest.length > 0
+                    ? memchr(rest.data, splitter->delimiter, rest.length)
+                    : NULL;
+  if (found == NULL) {
+    splitter->done = true;
+    return (OPTIONAL(strview)) OPTIONAL_PRESENT(rest);
+  }
+  const size_t end = (size_t) (found - rest.data);
+  splitter->rest = strview_slice(rest, end + 1, rest.length);
+  return (OPTIONAL(strview)) OPTIONAL_PRESENT(strview_slice(rest, 0, end));
+}
+
+// Splits `key <separator> value` at the first separator, trimming both
+// sides; returns an empty optional if there is no separator or no key
+static inline OPTIONAL(strview_key_value) strview_parse_key_value(
+    strview view, char separator) {
+  const OPTIONAL(strview) found = strview_find_char(view, separator);
+  if (OPTIONAL_IS_EMPTY(found)) {
+    return (OPTIONAL(strview_key_value)) OPTIONAL_EMPTY;
+  }
+  const strview rest = OPTIONAL_USE_VALUE(found);
+  const strview_key_value pair = {
+    .key = strview_trim(strview_slice(view, 0, view.length - rest.length)),
+    .value = strview_trim(strview_slice(rest, 1, rest.length))
+  };
+  if (pair.key.length == 0) {
+    return (OPTIONAL(strview_key_value)) OPTIONAL_EMPTY;
+  }
+  return (OPTIONAL(strview_key_value)) OPTIONAL_PRESENT(pair);
+}
+
+#endif
@@ -0,0 +1,304 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef WORK_POOL_H
+#define WORK_POOL_H
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// Work-stealing thread pool for data-parallel loops.
+//
+// work_pool_run(pool, body, context, count, grain) calls body(context,
+// begin, end) on disjoint chunks covering [0, count), using the calling
+// thread plus the pool's own threads, and returns once all of them are done.
+// Every worker owns a Chase-Lev deque of ranges: it pops from the bottom of
+// its own deque, and steals from the top of a random victim's when it runs
+// out. Ranges are split lazily: a worker running a range only pushes the
+// upper half of it when its own deque is empty, so splitting happens when
+// (and as often as) other workers are hungry. Chunks start at multiples of
+// the grain, so the same count and grain always produce the same chunks.
+
+// Maximum number of ranges waiting in a worker's deque
+#define WORK_DEQUE_CAPACITY 64
+
+struct work_range {
+  atomic_size_t begin;
+  atomic_size_t end;
+};
+
+// Chase-Lev deque; the owner pushes and pops at the bottom, thieves steal
+// at the top (top and bottom live on cache lines of their own)
+struct work_deque {
+  _Alignas(64) atomic_size_t top;
+  _Alignas(64) atomic_size_t bottom;
+  struct work_range ranges[WORK_DEQUE_CAPACITY];
+};
+
+struct work_job {
+  void (*body)(void *context, size_t begin, size_t end);
+  void *context;
+  size_t grain;
+  atomic_size_t remaining;
+};
+
+struct work_pool;
+
+struct work_worker {
+  struct work_deque deque;
+  struct work_pool *pool;
+  pthread_t thread;
+  uint64_t seed;
+};
+
+struct work_pool {
+  size_t threads;
+  struct work_worker *workers;
+  pthread_mutex_t lock;
+  pthread_cond_t wake;
+  pthread_cond_t idle;
+  struct work_job *job;
+  unsigned long generation;
+  size_t busy;
+  bool stopping;
+};
+
+static inline bool work_deque_is_empty(struct work_deque *deque) {
+  return atomic_load_explicit(&deque->bottom, memory_order_relaxed)
+      <= atomic_load_explicit(&deque->top, memory_order_relaxed);
+}
+
+// Pushes a range onto the bottom of the owner's deque, unless it is full
+static inline bool work_deque_push(struct work_deque *deque, size_t begin,
+                                   size_t end) {
+  const size_t bottom = atomic_load_explicit(&deque->bottom,
+                                             memory_order_relaxed);
+  const size_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+  if (bottom - top >= WORK_DEQUE_CAPACITY) {
+    return false;
+  }
+  struct work_range *range = &deque->ranges[bottom % WORK_DEQUE_CAPACITY];
+  atomic_store_explicit(&range->begin, begin, memory_order_relaxed);
+  atomic_store_explicit(&range->end, end, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+  atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+  return true;
+}
+
+// Pops a range from the bottom of the owner's deque
+static inline bool work_deque_pop(struct work_deque *deque, size_t *begin,
+                                  size_t *end) {
+  if (work_deque_is_empty(deque)) {
+    return false;
+  }
+  const size_t bottom = atomic_load_explicit(&deque->bottom,
+                                             memory_order_relaxed) - 1;
+  atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+  atomic_thread_fence(memory_order_seq_cst);
+  size_t top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+  if (top > bottom) {
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    return false;
+  }
+  struct work_range *range = &deque->ranges[bottom % WORK_DEQUE_CAPACITY];
+  *begin = atomic_load_explicit(&range->begin, memory_order_relaxed);
+  *end = atomic_load_explicit(&range->end, memory_order_relaxed);
+  if (top < bottom) {
+    return true;
+  }
+  // Last range: race the thieves for it
+  const bool won = atomic_compare_exchange_strong_explicit(
+    &deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed);
+  atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+  return won;
+}
+
+// Steals a range from the top of somebody else's deque
+static inline bool work_deque_steal(struct work_deque *deque, size_t *begin,
+                                    size_t *end) {
+  size_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+  atomic_thread_fence(memory_order_seq_cst);
+  const size_t bottom = atomic_load_explicit(&deque->bottom,
+                                             memory_order_acquire);
+  if (top >= bottom) {
+    return false;
+  }
+  struct work_range *range = &deque->ranges[top % WORK_DEQUE_CAPACITY];
+  *begin = atomic_load_explicit(&range->begin, memory_order_relaxed);
+  *end = atomic_load_explicit(&range->end, memory_order_relaxed);
+  return atomic_compare_exchange_strong_explicit(
+    &deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed);
+}
+
+// Runs a range one grain at a time, handing out its upper half whenever the
+// worker's own deque runs dry
+static inline void work_pool_run_range(struct work_worker *worker,
+                                       struct work_job *job, size_t begin,
+                                       size_t end) {
+  while (begin < end) {
+    if (end - begin > 2 * job->grain
+        && work_deque_is_empty(&worker->deque)) {
+      size_t middle = begin + (end - begin) / 2;
+      middle -= middle % job->grain;
+      if (middle > begin
+          && work_deque_push(&worker->deque, middle, end)) {
+        end = middle;
+      }
+    }
+    const size_t stop = end - begin > job->grain ? begin + job->grain : end;
+    job->body(job->context, begin, stop);
+    atomic_fetch_sub_explicit(&job->remaining, stop - begin,
+                              memory_order_acq_rel);
+    begin = stop;
+  }
+}
+
+// Runs ranges from the worker's own deque, or stolen ones, until the job is
+// done
+static inline void work_pool_work(struct work_worker *worker,
+                                  struct work_job *job) {
+  struct work_pool *pool = worker->pool;
+  size_t begin;
+  size_t end;
+  while (atomic_load_explicit(&job->remaining, memory_order_acquire) > 0) {
+    bool found = work_deque_pop(&worker->deque, &begin, &end);
+    // xorshift64
+    worker->seed ^= worker->seed << 13;
+    worker->seed ^= worker->seed >> 7;
+    worker->seed ^= worker->seed << 17;
+    for (size_t attempt = 0; !found && attempt < pool->threads; attempt++) {
+      struct work_worker *victim =
+        &pool->workers[(worker->seed + attempt) % pool->threads];
+      found = victim != worker
+           && work_deque_steal(&victim->deque, &begin, &end);
+    }
+    if (found) {
+      work_pool_run_range(worker, job, begin, end);
+    } else {
+      (void) sched_yield();
+    }
+  }
+}
+
+static inline void *work_pool_thread(void *argument) {
+  struct work_worker *worker = argument;
+  struct work_pool *pool = worker->pool;
+  unsigned long generation = 0;
+  (void) pthread_mutex_lock(&pool->lock);
+  for (;;) {
+    while (!pool->stopping && pool->generation == generation) {
+      (void) pthread_cond_wait(&pool->wake, &pool->lock);
+    }
+    if (pool->stopping) {
+      break;
+    }
+    generation = pool->generation;
+    struct work_job *job = pool->job;
+    (void) pthread_mutex_unlock(&pool->lock);
+    work_pool_work(worker, job);
+    (void) pthread_mutex_lock(&pool->lock);
+    if (--pool->busy == 0) {
+      (void) pthread_cond_signal(&pool->idle);
+    }
+  }
+  (void) pthread_mutex_unlock(&pool->lock);
+  return NULL;
+}
+
+static inline void work_pool_free(struct work_pool *pool) {
+  (void) pthread_mutex_lock(&pool->lock);
+  pool->stopping = true;
+  (void) pthread_cond_broadcast(&pool->wake);
+  (void) pthread_mutex_unlock(&pool->lock);
+  for (size_t index = 1; index < pool->threads; index++) {
+    (void) pthread_join(pool->workers[index].thread, NULL);
+  }
+  (void) pthread_cond_destroy(&pool->idle);
+  (void) pthread_cond_destroy(&pool->wake);
+  (void) pthread_mutex_destroy(&pool->lock);
+  free(pool->workers);
+  pool->workers = NULL;
+  pool->threads = 0;
+}
+
+// Starts a pool of the supplied number of threads (including the caller's)
+static inline bool work_pool_init(struct work_pool *pool, size_t threads) {
+  *pool = (struct work_pool) {.threads = threads < 1 ? 1 : threads};
+  pool->workers = aligned_alloc(_Alignof(struct work_worker),
+                                pool->threads * sizeof(struct work_worker));
+  if (pool->workers == NULL) {
+    return false;
+  }
+  if (pthread_mutex_init(&pool->lock, NULL) != 0
+      || pthread_cond_init(&pool->wake, NULL) != 0
+      || pthread_cond_init(&pool->idle, NULL) != 0) {
+    free(pool->workers);
+    return false;
+  }
+  for (size_t index = 0; index < pool->threads; index++) {
+    struct work_worker *worker = &pool->workers[index];
+    atomic_init(&worker->deque.top, 0);
+    atomic_init(&worker->deque.bottom, 0);
+    worker->pool = pool;
+    worker->seed = UINT64_C(0x9e3779b97f4a7c15) * (index + 1);
+  }
+  for (size_t index = 1; index < pool->threads; index++) {
+    if (pthread_create(&pool->workers[index].thread, NULL, work_pool_thread,
+                       &pool->workers[index]) != 0) {
+      pool->threads = index;
+      work_pool_free(pool);
+      return false;
+    }
+  }
+  return true;
+}
+
+static inline void work_pool_run(struct work_pool *pool,
+                                 void (*body)(void *, size_t, size_t),
+                                 void *context, size_t count, size_t grain) {
+  if (grain == 0) {
+    grain = 1;
+  }
+  if (pool->threads == 1 || count <= grain) {
+    for (size_t begin = 0; begin < count; begin += grain) {
+      body(context, begin, count - begin > grain ? begin + grain : count);
+    }
+    return;
+  }
+  struct work_job job = {.body = body, .context = context, .grain = grain};
+  atomic_init(&job.remaining, count);
+  (void) pthread_mutex_lock(&pool->lock);
+  pool->job = &job;
+  pool->generation++;
+  pool->busy = pool->threads - 1;
+  (void) pthread_cond_broadcast(&pool->wake);
+  (void) pthread_mutex_unlock(&pool->lock);
+  work_pool_run_range(&pool->workers[0], &job, 0, count);
+  work_pool_work(&pool->workers[0], &job);
+  (void) pthread_mutex_lock(&pool->lock);
+  while (pool->busy > 0) {
+    (void) pthread_cond_wait(&pool->idle, &pool->lock);
+  }
+  pool->job = NULL;
+  (void) pthread_mutex_unlock(&pool->lock);
+}
+
+#endif
@@ -54,6 +54,7 @@
 #define OPTIONAL_VERSION 0
 
 #include <stddef.h> /* NULL */
+#include <string.h> /* memcpy */
 
 #ifndef __bool_true_false_are_defined
 #include <stdbool.h>
@@ -451,6 +452,67 @@
     : (mapper(OPTIONAL_USE_VALUE(optional)))                                \
   )
 
+/**
+ * Transforms the value of an Optional using an allocation context.
+ *
+ * This macro works like #OPTIONAL_MAP, except that @b mapper also receives
+ * the supplied @b arena as its first argument, so that it can allocate the
+ * new value from it instead of calling @p malloc.
+ *
+ * @pre @b optional MUST be an @e lvalue.
+ *
+ * @b Example:
+ * @snippet example.c optional_map_in
+ *
+ * @param optional The Optional whose value will be transformed.
+ * @param arena The allocation context passed on to @b mapper.
+ * @param mapper The mapping function or macro that produces the new value.
+ * @param optional_type The type of the transformed Optional type.
+ * @return If @b optional is present, a new Optional holding the value produced
+ *   by @b mapper; otherwise, the supplied @b optional.
+ *
+ * @see OPTIONAL_FLAT_MAP_IN
+ */
+#define OPTIONAL_MAP_IN(optional, arena, mapper, optional_type)             \
+  (                                                                         \
+    (void) &(optional),                                                     \
+    OPTIONAL_IS_EMPTY(optional)                                             \
+    ? (optional_type) OPTIONAL_EMPTY                                        \
+    : (optional_type) OPTIONAL_PRESENT(                                     \
+        mapper((arena), OPTIONAL_USE_VALUE(optional)))                      \
+  )
+
+/**
+ * Transforms the value of an Optional into a different Optional using an
+ * allocation context.
+ *
+ * This macro works like #OPTIONAL_FLAT_MAP, except that @b mapper also
+ * receives the supplied @b arena as its first argument, so that it can
+ * allocate the new Optional's value from it instead of calling @p malloc.
+ *
+ * @pre @b optional MUST be an @e lvalue.
+ *
+ * @b Example:
+ * @snippet example.c optional_flat_map_in
+ *
+ * @param optional The Optional that will be transformed.
+ * @param arena The allocation context passed on to @b mapper.
+ * @param mapper The mapping function or macro that produces the new Optional if
+ *   the given @b optional is present.
+ * @return If @b optional is present, a new Optional produced by @b mapper;
+ *   otherwise, an empty Optional.
+ *
+ * @see OPTIONAL_MAP_IN
+ */
+#define OPTIONAL_FLAT_MAP_IN(optional, arena, mapper)                       \
+  (                                                                         \
+    (void) &(optional),                                                     \
+    OPTIONAL_IS_EMPTY(optional)                                             \
+    ? (typeof(mapper((arena), OPTIONAL_USE_VALUE(optional))))               \
+      OPTIONAL_EMPTY                                                        \
+    : (mapper((arena), OPTIONAL_USE_VALUE(optional)))                       \
+  )
+
 /**
  * Transforms an empty Optional into a different one.
  *
@@ -475,6 +537,131 @@
     : (typeof(supplier)) OPTIONAL_PRESENT(OPTIONAL_USE_VALUE(optional))     \
   )
 
+/**
+ * Moves the value out of an Optional, leaving it empty.
+ *
+ * The source Optional is only flagged as empty, so the value is copied once:
+ * straight into the returned Optional.
+ *
+ * @pre @b optional MUST be a modifiable @e lvalue.
+ *
+ * @b Example:
+ * @snippet example.c optional_take
+ *
+ * @param optional The Optional whose value will be taken.
+ * @return A new Optional holding @b optional's value if present; otherwise,
+ *   an empty Optional.
+ *
+ * @see OPTIONAL_REPLACE
+ */
+#define OPTIONAL_TAKE(optional)                                             \
+  (                                                                         \
+    (typeof(optional)) {                                                    \
+      ._empty = OPTIONAL_IS_EMPTY(optional)                                 \
+                || ((optional)._empty = true, false),                       \
+      ._value = OPTIONAL_USE_VALUE(optional)                                \
+    }                                                                       \
+  )
+
+/**
+ * Stores a value in an Optional, and returns the Optional it replaced.
+ *
+ * The previous value is taken out of @b optional via #OPTIONAL_TAKE, and then
+ * the new value is assigned to it. Each value goes through a temporary, so a
+ * large value may be copied twice on its way in or out.
+ *
+ * @pre @b optional MUST be a modifiable @e lvalue.
+ *
+ * @b Example:
+ * @snippet example.c optional_replace
+ *
+ * @param optional The Optional that will hold the new value.
+ * @param value The new value.
+ * @return A new Optional holding @b optional's previous value if it was
+ *   present; otherwise, an empty Optional.
+ *
+ * @see OPTIONAL_TAKE
+ * @see OPTIONAL_SWAP
+ */
+#define OPTIONAL_REPLACE(optional, value)                                   \
+  (                                                                         \
+    *(typeof(optional) *) optional_assign_bytes(                            \
+      &OPTIONAL_TAKE(optional),                                             \
+      &(optional),                                                          \
+      &(typeof(optional)) OPTIONAL_PRESENT(value),                          \
+      sizeof(optional)                                                      \
+    )                                                                       \
+  )
+
+/**
+ * Exchanges the contents of two Optionals of the same type.
+ *
+ * The Optionals are swapped in small blocks, so no temporary copy of a whole
+ * value is made.
+ *
+ * @pre @b optional1 and @b optional2 MUST be modifiable @e lvalues.
+ *
+ * @b Example:
+ * @snippet example.c optional_swap
+ *
+ * @param optional1 The first Optional.
+ * @param optional2 The second Optional.
+ *
+ * @see OPTIONAL_REPLACE
+ */
+#define OPTIONAL_SWAP(optional1, optional2)                                 \
+  do {                                                                      \
+    (void) sizeof((optional1) = (optional2));                               \
+    optional_swap_bytes(&(optional1), &(optional2), sizeof(optional1));     \
+  } while(false)
+
+/**
+ * Constructs the value of an Optional in place.
+ *
+ * The supplied @b constructor receives a pointer to the Optional's value and
+ * returns whether it could be initialized; the Optional will be present if it
+ * could, and empty otherwise. The value is never copied.
+ *
+ * @pre @b optional MUST be a modifiable @e lvalue.
+ *
+ * @b Example:
+ * @snippet example.c optional_emplace
+ *
+ * @param optional The Optional whose value will be constructed.
+ * @param constructor The function or macro that initializes the value.
+ * @return @p true if @b optional is now present; otherwise @p false.
+ */
+#define OPTIONAL_EMPLACE(optional, constructor)                             \
+  (                                                                         \
+    !((optional)._empty = !(constructor(&OPTIONAL_USE_VALUE(optional))))    \
+  )
+
+/// @cond INTERNAL
+/* Copies the source object over the target one; returns the taken one */
+static inline void *optional_assign_bytes(void *taken, void *target,
+                                          const void *source, size_t size) {
+  memcpy(target, source, size);
+  return taken;
+}
+
+/* Swaps two objects 64 bytes at a time */
+static inline void optional_swap_bytes(void *object1, void *object2,
+                                       size_t size) {
+  unsigned char *bytes1 = object1;
+  unsigned char *bytes2 = object2;
+  unsigned char block[64];
+  while (size > 0) {
+    const size_t length = size < sizeof(block) ? size : sizeof(block);
+    memcpy(block, bytes1, length);
+    memcpy(bytes1, bytes2, length);
+    memcpy(bytes2, block, length);
+    bytes1 += length;
+    bytes2 += length;
+    size -= length;
+  }
+}
+/// @endcond
+
 /**
  * Returns the struct tag for Optionals with the supplied type name.
  *
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdint.h>
+#include <arena.h>
+#include "test.h"
+
+#define CHUNK_SIZE 1024
+
+/**
+ * Tests arena allocation, marks, rewinding and resetting.
+ */
+int main() {
+    // Given
+    struct arena arena;
+    arena_init(&arena, CHUNK_SIZE);
+    // When
+    char *first = arena_alloc(&arena, 1);
+    char *second = arena_alloc(&arena, 3);
+    const struct arena_mark mark = arena_mark(&arena);
+    char *marked = arena_alloc(&arena, 100);
+    for (int index = 0; index < 20; index++) {
+        (void) arena_alloc(&arena, 100);
+    }
+    struct arena_chunk *second_chunk = arena.current;
+    char *huge = arena_alloc(&arena, 10 * CHUNK_SIZE);
+    huge[10 * CHUNK_SIZE - 1] = 'x';
+    arena_rewind(&arena, mark);
+    char *rewound = arena_alloc(&arena, 100);
+    for (int index = 0; index < 20; index++) {
+        (void) arena_alloc(&arena, 100);
+    }
+    struct arena_chunk *reused_chunk = arena.current;
+    arena_reset(&arena);
+    char *reset = arena_alloc(&arena, 1);
+    const bool aligned = (uintptr_t) second % _Alignof(max_align_t) == 0;
+    // Then
+    TEST_ASSERT(first != NULL && second != NULL && marked != NULL);
+    TEST_ASSERT(aligned);
+    TEST_ASSERT(second - first == _Alignof(max_align_t));
+    TEST_ASSERT(second_chunk != arena.first);
+    TEST_ASSERT(rewound == marked);
+    TEST_ASSERT(reused_chunk == second_chunk);
+    TEST_ASSERT(reset == first);
+    arena_free(&arena);
+    TEST_ASSERT(arena.first == NULL);
+    TEST_PASS;
+}
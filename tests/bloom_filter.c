@@ -0,0 +1,52 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <bloom-filter.h>
+#include <hash-map.h>
+#include "test.h"
+
+#define KEYS 100000
+
+/**
+ * Tests `bloom_filter_may_contain`.
+ */
+int main() {
+    // Given
+    struct bloom_filter filter;
+    struct bloom_filter rejected;
+    size_t false_positives = 0;
+    const double invalid_rates[] = {0.0, -0.5, 1.0, 2.0, NAN};
+    for (int index = 0; index < 5; index++) {
+        TEST_ASSERT(bloom_filter_bytes(KEYS, invalid_rates[index]) == 0);
+        TEST_ASSERT(!bloom_filter_init(&rejected, KEYS, invalid_rates[index], SIZE_MAX));
+        TEST_ASSERT(rejected.data == NULL);
+    }
+    TEST_ASSERT(bloom_filter_bytes(SIZE_MAX, 1e-300) == SIZE_MAX);
+    TEST_ASSERT(bloom_filter_init(&filter, KEYS, 0.01, SIZE_MAX));
+    // When
+    for (int key = 0; key < KEYS; key++) {
+        bloom_filter_add(&filter, hash_map_hash_int(key));
+    }
+    // Then
+    for (int key = 0; key < KEYS; key++) {
+        TEST_ASSERT(bloom_filter_may_contain(&filter, hash_map_hash_int(key)));
+        false_positives += bloom_filter_may_contain(&filter, hash_map_hash_int(KEYS + key));
+    }
+    TEST_ASSERT(false_positives < KEYS / 50);
+    bloom_filter_free(&filter);
+    TEST_PASS;
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <pthread.h>
+#include <optional-boxed.h>
+#include "test.h"
+
+#define SWITCHES 100000
+
+#define BOXES 1000
+
+bool box_pool_init_elsewhere(struct box_pool *pool);
+void *box_pool_alloc_elsewhere(struct box_pool *pool, size_t size);
+
+static struct box_pool shared;
+
+// Takes some boxes and exits without releasing the ones left in its cache
+static void *take_boxes(void *argument) {
+    for (int index = 0; index < BOXES; index++) {
+        box_pool_release(&shared, box_pool_alloc(&shared, 32), 32);
+    }
+    return argument;
+}
+
+/**
+ * Tests that box pool free lists go back to their pool when a thread switches
+ * pools or exits, and that they follow pools across translation units.
+ */
+int main() {
+    // Given
+    struct box_pool first;
+    struct box_pool second;
+    struct box_pool other;
+    TEST_ASSERT(box_pool_init(&first));
+    TEST_ASSERT(box_pool_init(&second));
+    TEST_ASSERT(box_pool_init_elsewhere(&other));
+    TEST_ASSERT(box_pool_init(&shared));
+    pthread_t thread;
+    // When
+    for (int index = 0; index < SWITCHES; index++) {
+        box_pool_release(&first, box_pool_alloc(&first, 32), 32);
+        box_pool_release(&second, box_pool_alloc(&second, 32), 32);
+    }
+    void *released = box_pool_alloc(&first, 32);
+    box_pool_release(&first, released, 32);
+    void *elsewhere = box_pool_alloc_elsewhere(&other, 32);
+    TEST_ASSERT(pthread_create(&thread, NULL, take_boxes, NULL) == 0);
+    TEST_ASSERT(pthread_join(thread, NULL) == 0);
+    const struct box_free *handed_back = shared.classes[box_pool_class(32)].free;
+    // Then
+    TEST_ASSERT(first.reserved <= BOX_POOL_SLAB_SIZE);
+    TEST_ASSERT(second.reserved <= BOX_POOL_SLAB_SIZE);
+    TEST_ASSERT(elsewhere != released);
+    TEST_ASSERT(other.reserved > 0 && other.reserved <= BOX_POOL_SLAB_SIZE);
+    TEST_ASSERT(handed_back != NULL);
+    box_pool_free(&first);
+    box_pool_free(&second);
+    box_pool_free(&other);
+    box_pool_free(&shared);
+    TEST_PASS;
+}
@@ -0,0 +1,27 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <optional-boxed.h>
+
+// Uses a pool from a second translation unit (with its own free lists)
+
+bool box_pool_init_elsewhere(struct box_pool *pool) {
+    return box_pool_init(pool);
+}
+
+void *box_pool_alloc_elsewhere(struct box_pool *pool, size_t size) {
+    return box_pool_alloc(pool, size);
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <optional.h>
+#include <hash-map.h>
+#include "test.h"
+
+OPTIONAL_STRUCT(int);
+
+// Every key collides with every other one
+#define constant_hash(key) ((void) (key), UINT64_C(42))
+
+HASH_MAP(int_map, int, int, hash_map_hash_int, hash_map_equals_int)
+
+HASH_MAP(colliding_map, int, int, constant_hash, hash_map_equals_int)
+
+/**
+ * Tests `HASH_MAP`.
+ */
+int main() {
+    // Given
+    struct int_map map;
+    struct colliding_map colliding;
+    TEST_ASSERT(int_map_init(&map, 0));
+    TEST_ASSERT(colliding_map_init(&colliding, 0));
+    // When
+    for (int key = 0; key < 10000; key++) {
+        TEST_ASSERT(int_map_put(&map, key * 3, key));
+    }
+    for (int key = 0; key < 100; key++) {
+        TEST_ASSERT(colliding_map_put(&colliding, key, -key));
+    }
+    const OPTIONAL(int) removed = int_map_remove(&map, 300);
+    const OPTIONAL(int) not_removed = int_map_remove(&map, 301);
+    TEST_ASSERT(int_map_put(&map, 3, 123));
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(colliding_map_remove(&colliding, 50)));
+    // Then
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(removed));
+    TEST_ASSERT_INT_EQUALS(OPTIONAL_USE_VALUE(removed), 100);
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(not_removed));
+    TEST_ASSERT_INT_EQUALS((int) map.count, 9999);
+    for (int key = 0; key < 10000; key++) {
+        const OPTIONAL(int) hit = int_map_get(&map, key * 3);
+        const OPTIONAL(int) miss = int_map_get(&map, key * 3 + 1);
+        TEST_ASSERT(OPTIONAL_IS_EMPTY(miss));
+        if (key == 100) {
+            TEST_ASSERT(OPTIONAL_IS_EMPTY(hit));
+        } else {
+            TEST_ASSERT(OPTIONAL_IS_PRESENT(hit));
+            const int expected = key == 1 ? 123 : key;
+            TEST_ASSERT_INT_EQUALS(OPTIONAL_USE_VALUE(hit), expected);
+        }
+    }
+    for (int key = 0; key < 100; key++) {
+        const OPTIONAL(int) found = colliding_map_get(&colliding, key);
+        TEST_ASSERT_BOOL_EQUALS(OPTIONAL_IS_PRESENT(found), key != 50);
+        const int expected = key == 50 ? 50 : -key;
+        TEST_ASSERT_INT_EQUALS(OPTIONAL_OR_ELSE(found, 50), expected);
+    }
+    int_map_free(&map);
+    colliding_map_free(&colliding);
+    TEST_PASS;
+}
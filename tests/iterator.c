@@ -0,0 +1,87 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <optional.h>
+#include <iterator.h>
+#include "test.h"
+
+typedef struct pair { int first; strview second; } pair;
+
+OPTIONAL_STRUCT(int);
+OPTIONAL_STRUCT(pair);
+
+#define square(x) ((x) * (x))
+#define is_even(x) ((x) % 2 == 0)
+#define is_not_empty(line) ((line).length > 0)
+
+ITERATOR_ARRAY(ints, int)
+ITERATOR_OPTIONAL_ARRAY(present_ints, int)
+ITERATOR_CHAIN(all_ints, ints, present_ints, int)
+ITERATOR_SKIP(later_ints, all_ints, int)
+ITERATOR_MAP(squares, later_ints, int, int, square)
+ITERATOR_FILTER(even_squares, squares, int, is_even)
+ITERATOR_TAKE(first_even_squares, even_squares, int)
+ITERATOR_FILTER(lines, line_iterator, strview, is_not_empty)
+ITERATOR_ZIP(numbered_lines, ints, int, lines, strview, pair)
+
+/**
+ * Tests fused iterator chains over arrays, optional arrays and file lines.
+ */
+int main() {
+    // Given
+    const int numbers[] = {1, 2, 3, 4};
+    const OPTIONAL(int) optionals[] = {OPTIONAL_PRESENT(5), OPTIONAL_EMPTY, OPTIONAL_PRESENT(6), OPTIONAL_EMPTY, OPTIONAL_PRESENT(8), OPTIONAL_PRESENT(10)};
+    struct first_even_squares iterator = first_even_squares_of(even_squares_of(squares_of(later_ints_of(all_ints_of(ints_of(numbers, 4), present_ints_of(optionals, 6)), 1))), 3);
+    struct later_ints skipped_all = later_ints_of(all_ints_of(ints_of(numbers, 4), present_ints_of(optionals, 0)), 10);
+    FILE *file = tmpfile();
+    TEST_ASSERT(file != NULL);
+    fputs("Snoopy\n\nGarfield\r\nNemo", file);
+    rewind(file);
+    struct numbered_lines numbered = numbered_lines_of(ints_of(numbers, 4), lines_of(line_iterator_of(file)));
+    int values[8];
+    const strview expected[] = {strview_of("Snoopy"), strview_of("Garfield"), strview_of("Nemo")};
+    int line_numbers[8];
+    bool line_matches[8];
+    int count = 0;
+    int pair_count = 0;
+    // When
+    for (OPTIONAL(int) value = first_even_squares_next(&iterator); OPTIONAL_IS_PRESENT(value); value = first_even_squares_next(&iterator)) {
+        values[count++] = OPTIONAL_USE_VALUE(value);
+    }
+    const OPTIONAL(int) exhausted = first_even_squares_next(&iterator);
+    const OPTIONAL(int) nothing = later_ints_next(&skipped_all);
+    for (OPTIONAL(pair) value = numbered_lines_next(&numbered); OPTIONAL_IS_PRESENT(value); value = numbered_lines_next(&numbered)) {
+        line_numbers[pair_count] = OPTIONAL_USE_VALUE(value).first;
+        line_matches[pair_count] = strview_equals(OPTIONAL_USE_VALUE(value).second, expected[pair_count]);
+        pair_count++;
+    }
+    line_iterator_free(&numbered.second.source);
+    fclose(file);
+    // Then
+    TEST_ASSERT_INT_EQUALS(count, 3);
+    TEST_ASSERT_INT_EQUALS(values[0], 4);
+    TEST_ASSERT_INT_EQUALS(values[1], 16);
+    TEST_ASSERT_INT_EQUALS(values[2], 36);
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(exhausted));
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(nothing));
+    TEST_ASSERT_INT_EQUALS(pair_count, 3);
+    TEST_ASSERT_INT_EQUALS(line_numbers[0], 1);
+    TEST_ASSERT_INT_EQUALS(line_numbers[2], 3);
+    TEST_ASSERT(line_matches[0] && line_matches[1] && line_matches[2]);
+    TEST_PASS;
+}
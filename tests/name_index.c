@@ -0,0 +1,85 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <optional.h>
+#include <name-index.h>
+#include "test.h"
+
+#define PETS 8
+
+/**
+ * Tests `name_index`.
+ */
+int main() {
+    // Given
+    struct pet pets[PETS] = {
+        {.id = 0, .name = "Snoopy"},
+        {.id = 1, .name = "snoopy"},
+        {.id = 2, .name = "SNOOPY"},
+        {.id = 3, .name = "Snoop Dogg"},
+        {.id = 4, .name = "A rather long name for a pet"},
+        {.id = 5, .name = "A rather long name for a cat"},
+        {.id = 6, .name = "Snoopy"},
+        {.id = 7, .name = ""}
+    };
+    Pet all[PETS];
+    for (int index = 0; index < PETS; index++) {
+        all[index] = &pets[index];
+    }
+    struct name_index index;
+    TEST_ASSERT(name_index_build(&index, all, PETS));
+    // When
+    const OPTIONAL(Pet) snoopy = name_index_find(&index, "Snoopy");
+    const OPTIONAL(Pet) cat = name_index_find(&index, "A rather long name for a cat");
+    const OPTIONAL(Pet) dog = name_index_find(&index, "A rather long name for a dog");
+    const OPTIONAL(Pet) empty = name_index_find(&index, "");
+    const OPTIONAL(Pet) missing = name_index_find(&index, "Snoopy!");
+    struct pet_name_range ignoring_case = name_index_ignoring_case(&index, "sNoOpY");
+    struct pet_name_range prefix = name_index_prefix(&index, "Snoop");
+    struct pet_name_range long_prefix = name_index_prefix(&index, "A rather long name for a ");
+    // Then
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(snoopy));
+    TEST_ASSERT_INT_EQUALS(PET_ID(OPTIONAL_USE_VALUE(snoopy)), 0);
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(cat));
+    TEST_ASSERT_INT_EQUALS(PET_ID(OPTIONAL_USE_VALUE(cat)), 5);
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(dog));
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(empty));
+    TEST_ASSERT_INT_EQUALS(PET_ID(OPTIONAL_USE_VALUE(empty)), 7);
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(missing));
+    int count = 0;
+    for (OPTIONAL(Pet) pet = pet_name_range_next(&ignoring_case); OPTIONAL_IS_PRESENT(pet); pet = pet_name_range_next(&ignoring_case)) {
+        TEST_ASSERT(PET_ID(OPTIONAL_USE_VALUE(pet)) <= 2 || PET_ID(OPTIONAL_USE_VALUE(pet)) == 6);
+        count++;
+    }
+    TEST_ASSERT_INT_EQUALS(count, 4);
+    count = 0;
+    for (OPTIONAL(Pet) pet = pet_name_range_next(&prefix); OPTIONAL_IS_PRESENT(pet); pet = pet_name_range_next(&prefix)) {
+        TEST_ASSERT(PET_NAME(OPTIONAL_USE_VALUE(pet))[0] == 'S');
+        TEST_ASSERT(PET_NAME(OPTIONAL_USE_VALUE(pet))[1] == 'n');
+        count++;
+    }
+    TEST_ASSERT_INT_EQUALS(count, 3);
+    const OPTIONAL(Pet) first = pet_name_range_next(&long_prefix);
+    const OPTIONAL(Pet) second = pet_name_range_next(&long_prefix);
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(first));
+    TEST_ASSERT_INT_EQUALS(PET_ID(OPTIONAL_USE_VALUE(first)), 5);
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(second));
+    TEST_ASSERT_INT_EQUALS(PET_ID(OPTIONAL_USE_VALUE(second)), 4);
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(pet_name_range_next(&long_prefix)));
+    name_index_free(&index);
+    TEST_PASS;
+}
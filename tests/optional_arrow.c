@@ -0,0 +1,159 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>
+#include <optional.h>
+#include <optional-arrow.h>
+#include "test.h"
+
+#define COUNT 37
+
+OPTIONAL_STRUCT(int32_t);
+OPTIONAL_STRUCT(double);
+OPTIONAL_STRUCT(int16_t);
+
+OPTIONAL_ARROW_COLUMN(int_column, int32_t, "i")
+OPTIONAL_ARROW_COLUMN(double_column, double, "g")
+OPTIONAL_ARROW_COLUMN(short_column, int16_t, "s")
+
+static bool released = false;
+
+static void release_foreign_array(struct ArrowArray *array) {
+    released = true;
+    array->release = NULL;
+}
+
+/**
+ * Tests exporting optional columns as Arrow arrays and importing them back.
+ */
+int main() {
+    // Given
+    OPTIONAL(int32_t) ints[COUNT];
+    OPTIONAL(double) doubles[COUNT];
+    OPTIONAL(int16_t) shorts[COUNT];
+    for (int index = 0; index < COUNT; index++) {
+        const bool empty = index % 3 == 0 || index == 35;
+        ints[index] = empty ? (OPTIONAL(int32_t)) OPTIONAL_EMPTY : (OPTIONAL(int32_t)) OPTIONAL_PRESENT(index * 10);
+        doubles[index] = empty ? (OPTIONAL(double)) OPTIONAL_EMPTY : (OPTIONAL(double)) OPTIONAL_PRESENT(index / 4.0);
+        shorts[index] = empty ? (OPTIONAL(int16_t)) OPTIONAL_EMPTY : (OPTIONAL(int16_t)) OPTIONAL_PRESENT((int16_t) -index);
+        // Empty optionals may carry garbage in their padding and value
+        memset((char *) &ints[index] + 1, empty ? 0x5a : 0, 3);
+        if (empty) {
+            ints[index]._value = -1;
+            doubles[index]._value = -1;
+        }
+    }
+    struct int_column int_column;
+    struct double_column double_column;
+    struct short_column short_column;
+    struct int_column imported_ints;
+    struct double_column imported_doubles;
+    struct short_column imported_shorts;
+    struct ArrowArray array;
+    struct ArrowSchema schema;
+    OPTIONAL(int32_t) round_trip[COUNT];
+    // When
+    TEST_ASSERT(int_column_from_optionals(&int_column, ints, COUNT));
+    TEST_ASSERT(double_column_from_optionals(&double_column, doubles, COUNT));
+    TEST_ASSERT(short_column_from_optionals(&short_column, shorts, COUNT));
+    const void *values = int_column.values;
+    TEST_ASSERT(int_column_export(&int_column, &array, &schema));
+    // Then
+    TEST_ASSERT(int_column.values == NULL);
+    TEST_ASSERT_STR_EQUALS(schema.format, "i");
+    TEST_ASSERT(schema.flags == ARROW_FLAG_NULLABLE);
+    TEST_ASSERT(array.length == COUNT);
+    TEST_ASSERT(array.null_count == 14);
+    TEST_ASSERT(array.offset == 0);
+    TEST_ASSERT(array.n_buffers == 2);
+    TEST_ASSERT(array.buffers[1] == values);
+    const uintptr_t address = (uintptr_t) values;
+    TEST_ASSERT(address / OPTIONAL_ARROW_ALIGNMENT * OPTIONAL_ARROW_ALIGNMENT == address);
+    const uint8_t *bitmap = array.buffers[0];
+    const int32_t *exported = array.buffers[1];
+    TEST_ASSERT_INT_EQUALS(bitmap[0], 0xb6);
+    TEST_ASSERT_INT_EQUALS(bitmap[4], 0x05);
+    TEST_ASSERT_INT_EQUALS(exported[1], 10);
+    TEST_ASSERT_INT_EQUALS(exported[3], 0);
+    TEST_ASSERT_INT_EQUALS(exported[34], 340);
+    TEST_ASSERT_INT_EQUALS(exported[35], 0);
+
+    // When
+    TEST_ASSERT(!double_column_import(&imported_doubles, &array, &schema));
+    TEST_ASSERT(int_column_import(&imported_ints, &array, &schema));
+    schema.release(&schema);
+    int_column_to_optionals(&imported_ints, round_trip);
+    // Then
+    TEST_ASSERT(array.release == NULL);
+    TEST_ASSERT(schema.release == NULL);
+    TEST_ASSERT(imported_ints.values == values);
+    TEST_ASSERT(imported_ints.null_count == 14);
+    for (int index = 0; index < COUNT; index++) {
+        TEST_ASSERT_BOOL_EQUALS(OPTIONAL_IS_PRESENT(round_trip[index]), OPTIONAL_IS_PRESENT(ints[index]));
+        if (OPTIONAL_IS_PRESENT(ints[index])) {
+            TEST_ASSERT_INT_EQUALS(OPTIONAL_USE_VALUE(round_trip[index]), OPTIONAL_USE_VALUE(ints[index]));
+        }
+    }
+    int_column_free(&imported_ints);
+
+    // When
+    TEST_ASSERT(double_column_export(&double_column, &array, &schema));
+    TEST_ASSERT(double_column_import(&imported_doubles, &array, &schema));
+    TEST_ASSERT(short_column_export(&short_column, &array, &schema));
+    TEST_ASSERT(short_column_import(&imported_shorts, &array, &schema));
+    // Then
+    TEST_ASSERT(imported_doubles.null_count == 14);
+    TEST_ASSERT(imported_shorts.null_count == 14);
+    for (int index = 0; index < COUNT; index++) {
+        const OPTIONAL(double) real = double_column_get(&imported_doubles, index);
+        const OPTIONAL(int16_t) small = short_column_get(&imported_shorts, index);
+        TEST_ASSERT_BOOL_EQUALS(OPTIONAL_IS_PRESENT(real), OPTIONAL_IS_PRESENT(doubles[index]));
+        TEST_ASSERT_BOOL_EQUALS(OPTIONAL_IS_PRESENT(small), OPTIONAL_IS_PRESENT(shorts[index]));
+        if (OPTIONAL_IS_PRESENT(real)) {
+            TEST_ASSERT(OPTIONAL_USE_VALUE(real) == index / 4.0);
+            TEST_ASSERT_INT_EQUALS(OPTIONAL_USE_VALUE(small), -index);
+        }
+    }
+    double_column_free(&imported_doubles);
+    short_column_free(&imported_shorts);
+
+    // Given
+    const int32_t foreign_values[] = {1, 2, 3, 4, 5};
+    const uint8_t foreign_validity[] = {0x15};
+    const void *foreign_buffers[] = {foreign_validity, foreign_values};
+    struct ArrowArray foreign = {
+        .length = 3, .null_count = -1, .offset = 2, .n_buffers = 2,
+        .buffers = foreign_buffers, .release = release_foreign_array
+    };
+    struct ArrowSchema foreign_schema = optional_arrow_schema("i");
+    // When
+    TEST_ASSERT(int_column_import(&imported_ints, &foreign, &foreign_schema));
+    const OPTIONAL(int32_t) third = int_column_get(&imported_ints, 0);
+    const OPTIONAL(int32_t) fourth = int_column_get(&imported_ints, 1);
+    const size_t foreign_nulls = imported_ints.null_count;
+    TEST_ASSERT(int_column_export(&imported_ints, &array, &schema));
+    const bool kept = !released;
+    array.release(&array);
+    // Then
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(third));
+    TEST_ASSERT_INT_EQUALS(OPTIONAL_USE_VALUE(third), 3);
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(fourth));
+    TEST_ASSERT(foreign_nulls == 1);
+    TEST_ASSERT(array.offset == 2);
+    TEST_ASSERT(kept);
+    TEST_ASSERT(released);
+    TEST_PASS;
+}
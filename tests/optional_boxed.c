@@ -0,0 +1,89 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <optional.h>
+#include <optional-boxed.h>
+#include "test.h"
+
+#define SIZE 1000
+
+typedef struct record {
+    int id;
+    char payload[4092];
+} record;
+
+typedef struct huge {
+    char payload[100000];
+} huge;
+
+OPTIONAL_STRUCT(record);
+OPTIONAL_BOXED_STRUCT(record);
+OPTIONAL_BOXED_STRUCT(huge);
+OPTIONAL_STRUCT(int);
+
+#define is_odd(box) ((box)->id % 2 != 0)
+#define get_id(box) ((box)->id)
+
+/**
+ * Tests boxed optionals of a large type, and the OPTIONAL_* macros on them.
+ */
+int main() {
+    // Given
+    struct box_pool pool;
+    TEST_ASSERT(box_pool_init(&pool));
+    static OPTIONAL_BOXED(record) table[SIZE];
+    static huge big;
+    big.payload[sizeof(big.payload) - 1] = 'x';
+    int present = 0;
+    int odd = 0;
+    // When
+    for (int index = 0; index < SIZE; index++) {
+        if (index % 10 == 0) {
+            record value = {.id = index};
+            record *box = box_pool_copy(&pool, &value, sizeof(value));
+            table[index] = (OPTIONAL_BOXED(record)) OPTIONAL_OF_NULLABLE(box);
+        } else {
+            table[index] = (OPTIONAL_BOXED(record)) OPTIONAL_EMPTY;
+        }
+    }
+    const size_t reserved = pool.reserved;
+    record *first = OPTIONAL_USE_VALUE(table[10]);
+    OPTIONAL_BOXED_RELEASE(&pool, table[10]);
+    record value = {.id = 11};
+    record *reused = box_pool_copy(&pool, &value, sizeof(value));
+    table[10] = (OPTIONAL_BOXED(record)) OPTIONAL_OF_NULLABLE(reused);
+    for (int index = 0; index < SIZE; index++) {
+        const OPTIONAL(int) id = OPTIONAL_MAP(table[index], get_id, OPTIONAL(int));
+        const OPTIONAL_BOXED(record) filtered = OPTIONAL_FILTER(table[index], is_odd);
+        present += OPTIONAL_IS_PRESENT(id);
+        odd += OPTIONAL_IS_PRESENT(filtered);
+    }
+    huge *big_box = box_pool_copy(&pool, &big, sizeof(big));
+    const OPTIONAL_BOXED(huge) big_optional = OPTIONAL_OF_NULLABLE(big_box);
+    // Then
+    TEST_ASSERT(sizeof(OPTIONAL_BOXED(record)) <= 2 * sizeof(void *));
+    TEST_ASSERT_INT_EQUALS(present, SIZE / 10);
+    TEST_ASSERT_INT_EQUALS(odd, 1);
+    TEST_ASSERT(reused == first);
+    TEST_ASSERT(OPTIONAL_USE_VALUE(table[20])->id == 20);
+    TEST_ASSERT(sizeof(table) + reserved < SIZE * sizeof(OPTIONAL(record)) / 4);
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(big_optional));
+    TEST_ASSERT(OPTIONAL_USE_VALUE(big_optional)->payload[sizeof(big.payload) - 1] == 'x');
+    box_pool_free(&pool);
+    TEST_ASSERT(pool.reserved == 0);
+    TEST_PASS;
+}
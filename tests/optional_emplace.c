@@ -0,0 +1,57 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <optional.h>
+#include "test.h"
+
+typedef struct {
+    int x;
+    int y;
+} point;
+
+OPTIONAL_STRUCT(point);
+
+static bool origin(point *p) {
+    p->x = 0;
+    p->y = 0;
+    return true;
+}
+
+static bool invalid(point *p) {
+    p->x = -1;
+    return false;
+}
+
+/**
+ * Tests `OPTIONAL_EMPLACE`.
+ */
+int main() {
+    // Given
+    OPTIONAL(point) empty = OPTIONAL_EMPTY;
+    OPTIONAL(point) present = OPTIONAL_PRESENT(((point) {123, 456}));
+    // When
+    const bool emplaced = OPTIONAL_EMPLACE(empty, origin);
+    const bool failed = OPTIONAL_EMPLACE(present, invalid);
+    // Then
+    TEST_ASSERT(emplaced);
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(empty));
+    TEST_ASSERT_INT_EQUALS(OPTIONAL_USE_VALUE(empty).x, 0);
+    TEST_ASSERT_INT_EQUALS(OPTIONAL_USE_VALUE(empty).y, 0);
+    TEST_ASSERT(!failed);
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(present));
+    TEST_PASS;
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <optional.h>
+#include <arena.h>
+#include "test.h"
+
+typedef struct {
+    int x;
+    int y;
+} point;
+
+typedef int *int_pointer;
+
+OPTIONAL_STRUCT(point);
+
+OPTIONAL_STRUCT(int_pointer);
+
+static OPTIONAL(int_pointer) validate_in(struct arena *arena, point p) {
+    if (p.x == 0 && p.y == 0) {
+        return (OPTIONAL(int_pointer)) OPTIONAL_EMPTY;
+    }
+    int_pointer sum = arena_alloc(arena, sizeof(int));
+    *sum = p.x + p.y;
+    return (OPTIONAL(int_pointer)) OPTIONAL_PRESENT(sum);
+}
+
+/**
+ * Tests `OPTIONAL_FLAT_MAP_IN`.
+ */
+int main() {
+    // Given
+    struct arena arena;
+    arena_init(&arena, 0);
+    const OPTIONAL(point) present1 = OPTIONAL_PRESENT(((point) {123, 456}));
+    const OPTIONAL(point) present2 = OPTIONAL_PRESENT(((point) {0, 0}));
+    const OPTIONAL(point) empty = OPTIONAL_EMPTY;
+    // When
+    const OPTIONAL(int_pointer) mapped_present1 = OPTIONAL_FLAT_MAP_IN(present1, &arena, validate_in);
+    const OPTIONAL(int_pointer) mapped_present2 = OPTIONAL_FLAT_MAP_IN(present2, &arena, validate_in);
+    const OPTIONAL(int_pointer) mapped_empty = OPTIONAL_FLAT_MAP_IN(empty, &arena, validate_in);
+    // Then
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(mapped_present1));
+    TEST_ASSERT_INT_EQUALS(*OPTIONAL_USE_VALUE(mapped_present1), 579);
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(mapped_present2));
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(mapped_empty));
+    arena_free(&arena);
+    TEST_PASS;
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <optional.h>
+#include <arena.h>
+#include "test.h"
+
+typedef struct {
+    int x;
+    int y;
+} point;
+
+typedef int *int_pointer;
+
+OPTIONAL_STRUCT(point);
+
+OPTIONAL_STRUCT(int_pointer);
+
+static int_pointer point_sum_in(struct arena *arena, point p) {
+    int_pointer sum = arena_alloc(arena, sizeof(int));
+    *sum = p.x + p.y;
+    return sum;
+}
+
+/**
+ * Tests `OPTIONAL_MAP_IN`.
+ */
+int main() {
+    // Given
+    struct arena arena;
+    arena_init(&arena, 0);
+    const point p = {123, 456};
+    const OPTIONAL(point) present = OPTIONAL_PRESENT(p);
+    const OPTIONAL(point) empty = OPTIONAL_EMPTY;
+    // When
+    const OPTIONAL(int_pointer) mapped_present = OPTIONAL_MAP_IN(present, &arena, point_sum_in, OPTIONAL(int_pointer));
+    const OPTIONAL(int_pointer) mapped_empty = OPTIONAL_MAP_IN(empty, &arena, point_sum_in, OPTIONAL(int_pointer));
+    // Then
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(mapped_present));
+    TEST_ASSERT_INT_EQUALS(*OPTIONAL_USE_VALUE(mapped_present), 579);
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(mapped_empty));
+    TEST_ASSERT(arena.first != NULL && arena.first->next == NULL);
+    arena_free(&arena);
+    TEST_PASS;
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <optional.h>
+
+// A payload far larger than any register, so that the compiler copies it as a
+// block (a call to memcpy, when built with -mstringop-strategy=libcall)
+typedef struct big {
+    char data[4096];
+} big;
+
+OPTIONAL_STRUCT(big);
+
+void consume(OPTIONAL(big) *optional);
+
+bool init_big(big *value);
+
+/**
+ * Takes a value out into the return value.
+ */
+OPTIONAL(big) take_into_return(OPTIONAL(big) *source) {
+    return OPTIONAL_TAKE(*source);
+}
+
+/**
+ * Takes a value out into a new local variable.
+ */
+void take_into_local(OPTIONAL(big) *source) {
+    OPTIONAL(big) taken = OPTIONAL_TAKE(*source);
+    consume(&taken);
+}
+
+/**
+ * Replaces a value.
+ */
+OPTIONAL(big) replace_into_return(OPTIONAL(big) *optional, const big *value) {
+    return OPTIONAL_REPLACE(*optional, *value);
+}
+
+/**
+ * Swaps two values.
+ */
+void swap(OPTIONAL(big) *optional1, OPTIONAL(big) *optional2) {
+    OPTIONAL_SWAP(*optional1, *optional2);
+}
+
+/**
+ * Constructs a value in place.
+ */
+bool emplace(OPTIONAL(big) *optional) {
+    return OPTIONAL_EMPLACE(*optional, init_big);
+}
+
+/**
+ * Takes a value out by hand: the naive reference for `take_into_return`.
+ */
+OPTIONAL(big) naive_take_into_return(OPTIONAL(big) *source) {
+    OPTIONAL(big) taken = *source;
+    source->_empty = true;
+    return taken;
+}
+
+/**
+ * Replaces a value by hand: the naive reference for `replace_into_return`.
+ */
+OPTIONAL(big) naive_replace_into_return(OPTIONAL(big) *optional,
+                                        const big *value) {
+    OPTIONAL(big) old = *optional;
+    *optional = (OPTIONAL(big)) OPTIONAL_PRESENT(*value);
+    return old;
+}
+
+/**
+ * Swaps two values by hand: the naive reference for `swap`.
+ */
+void naive_swap(OPTIONAL(big) *optional1, OPTIONAL(big) *optional2) {
+    OPTIONAL(big) temporary = *optional1;
+    *optional1 = *optional2;
+    *optional2 = temporary;
+}
@@ -0,0 +1,42 @@
+#!/bin/sh
+#
+# Checks that moving large Optionals doesn't emit redundant payload copies.
+#
+# Builds tests/optional_move_codegen.c with -mstringop-strategy=libcall, so
+# that every block copy the compiler emits becomes a call instead of inline
+# moves or loops, and links it with tests/optional_move_counter.c, whose
+# memcpy, memmove and memset count the bytes they write. The moves must then
+# stay within a fixed number of payload copies, and within their naive
+# references.
+#
+
+CC=${CC:-cc}
+srcdir=${srcdir:-.}
+
+case $($CC -dumpmachine 2>/dev/null) in
+    x86_64*) ;;
+    *) echo "Skipping: the checks need -mstringop-strategy (x86-64)"; exit 77 ;;
+esac
+
+if ! $CC -mstringop-strategy=libcall -x c -c /dev/null -o /dev/null \
+        2>/dev/null; then
+    echo "Skipping: $CC doesn't accept -mstringop-strategy"
+    exit 77
+fi
+
+build=$(mktemp -d) || exit 1
+trap 'rm -rf "$build"' EXIT
+
+$CC -std=gnu17 -O1 -fno-builtin -I"$srcdir/src" -c \
+    -o "$build/counter.o" "$srcdir/tests/optional_move_counter.c" || exit 1
+
+for level in -O2 -O3; do
+    $CC -std=gnu17 $level -mstringop-strategy=libcall -I"$srcdir/src" -c \
+        -o "$build/codegen.o" "$srcdir/tests/optional_move_codegen.c" || exit 1
+    $CC -o "$build/codegen" "$build/codegen.o" "$build/counter.o" || exit 1
+    echo "Checking $level"
+    "$build/codegen" || exit 1
+done
+
+echo "No redundant payload copies"
+exit 0
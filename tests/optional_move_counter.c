@@ -0,0 +1,122 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <optional.h>
+#include "test.h"
+
+// Built with -fno-builtin and linked with tests/optional_move_codegen.c, whose
+// block copies all become calls to these counting versions
+typedef struct big {
+    char data[4096];
+} big;
+
+OPTIONAL_STRUCT(big);
+
+#define PAYLOAD sizeof(OPTIONAL(big))
+
+// Counts the bytes written by a call
+#define MOVED(call) (moved = 0, (void) (call), moved)
+
+static size_t moved;
+
+void *memcpy(void *restrict target, const void *restrict source, size_t size) {
+    volatile unsigned char *to = target;
+    const volatile unsigned char *from = source;
+    for (size_t index = 0; index < size; index++) {
+        to[index] = from[index];
+    }
+    moved += size;
+    return target;
+}
+
+void *memmove(void *target, const void *source, size_t size) {
+    volatile unsigned char *to = target;
+    const volatile unsigned char *from = source;
+    if (to < from) {
+        for (size_t index = 0; index < size; index++) {
+            to[index] = from[index];
+        }
+    } else {
+        for (size_t index = size; index > 0; index--) {
+            to[index - 1] = from[index - 1];
+        }
+    }
+    moved += size;
+    return target;
+}
+
+void *memset(void *target, int value, size_t size) {
+    volatile unsigned char *to = target;
+    for (size_t index = 0; index < size; index++) {
+        to[index] = (unsigned char) value;
+    }
+    moved += size;
+    return target;
+}
+
+void consume(OPTIONAL(big) *optional) {
+    (void) optional;
+}
+
+bool init_big(big *value) {
+    value->data[0] = 'x';
+    return true;
+}
+
+OPTIONAL(big) take_into_return(OPTIONAL(big) *source);
+void take_into_local(OPTIONAL(big) *source);
+OPTIONAL(big) replace_into_return(OPTIONAL(big) *optional, const big *value);
+void swap(OPTIONAL(big) *optional1, OPTIONAL(big) *optional2);
+bool emplace(OPTIONAL(big) *optional);
+OPTIONAL(big) naive_take_into_return(OPTIONAL(big) *source);
+OPTIONAL(big) naive_replace_into_return(OPTIONAL(big) *optional,
+                                        const big *value);
+void naive_swap(OPTIONAL(big) *optional1, OPTIONAL(big) *optional2);
+
+static OPTIONAL(big) optional1 = OPTIONAL_PRESENT((big) {{'a'}});
+static OPTIONAL(big) optional2 = OPTIONAL_PRESENT((big) {{'b'}});
+static big value = {{'c'}};
+
+/**
+ * Tests that moving large Optionals doesn't copy their payloads redundantly.
+ */
+int main() {
+
+    // Given
+    const size_t naive_take = MOVED(naive_take_into_return(&optional1));
+    const size_t naive_replace = MOVED(naive_replace_into_return(&optional1,
+                                                                 &value));
+    const size_t naive_swapped = MOVED(naive_swap(&optional1, &optional2));
+
+    // When
+    const size_t taken_into_return = MOVED(take_into_return(&optional1));
+    const size_t taken_into_local = MOVED(take_into_local(&optional2));
+    const size_t replaced = MOVED(replace_into_return(&optional1, &value));
+    const size_t swapped = MOVED(swap(&optional1, &optional2));
+    const size_t emplaced = MOVED(emplace(&optional1));
+
+    // Then
+    TEST_ASSERT(naive_take >= PAYLOAD);
+    TEST_ASSERT(taken_into_return <= PAYLOAD);
+    TEST_ASSERT(taken_into_local <= PAYLOAD);
+    TEST_ASSERT(replaced <= 4 * PAYLOAD);
+    TEST_ASSERT(replaced <= naive_replace);
+    TEST_ASSERT(swapped <= 3 * PAYLOAD);
+    TEST_ASSERT(swapped <= naive_swapped);
+    TEST_ASSERT(emplaced == 0);
+    TEST_PASS;
+}
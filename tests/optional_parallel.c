@@ -0,0 +1,82 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdlib.h>
+#include <optional.h>
+#include <optional-parallel.h>
+#include "test.h"
+
+#define SIZE 1000003
+#define THREADS 4
+
+OPTIONAL_STRUCT(int);
+OPTIONAL_STRUCT(long);
+
+#define triple_plus_one(x) ((long) (x) * 3 + 1)
+#define is_even(x) ((x) % 2 == 0)
+#define add(x, y) ((x) + (y))
+
+OPTIONAL_PARALLEL_MAP(parallel_triple, int, long, triple_plus_one)
+OPTIONAL_PARALLEL_FILTER(parallel_evens, long, is_even)
+OPTIONAL_PARALLEL_REDUCE(parallel_sum, long, add)
+
+/**
+ * Tests parallel map, filter and reduce against the sequential macros.
+ */
+int main() {
+    // Given
+    struct work_pool pool;
+    TEST_ASSERT(work_pool_init(&pool, THREADS));
+    OPTIONAL(int) *input = malloc(SIZE * sizeof(OPTIONAL(int)));
+    OPTIONAL(long) *mapped = aligned_alloc(64, (SIZE * sizeof(OPTIONAL(long)) + 63) / 64 * 64);
+    OPTIONAL(long) *filtered = aligned_alloc(64, (SIZE * sizeof(OPTIONAL(long)) + 63) / 64 * 64);
+    TEST_ASSERT(input != NULL && mapped != NULL && filtered != NULL);
+    for (int index = 0; index < SIZE; index++) {
+        input[index] = index % 7 == 0 ? (OPTIONAL(int)) OPTIONAL_EMPTY : (OPTIONAL(int)) OPTIONAL_PRESENT(index % 1000);
+    }
+    // When
+    parallel_triple(&pool, input, mapped, SIZE);
+    parallel_evens(&pool, mapped, filtered, SIZE);
+    const OPTIONAL(long) sum = parallel_sum(&pool, filtered, SIZE);
+    const OPTIONAL(long) small_sum = parallel_sum(&pool, filtered, 10);
+    const OPTIONAL(long) nothing = parallel_sum(&pool, filtered, 0);
+    const OPTIONAL(long) all_empty = parallel_sum(&pool, filtered, 1);
+    // Then
+    long expected_sum = 0;
+    int mismatches = 0;
+    for (int index = 0; index < SIZE; index++) {
+        const OPTIONAL(long) expected_mapped = OPTIONAL_MAP(input[index], triple_plus_one, OPTIONAL(long));
+        const OPTIONAL(long) expected_filtered = OPTIONAL_FILTER(expected_mapped, is_even);
+        mismatches += OPTIONAL_IS_PRESENT(mapped[index]) != OPTIONAL_IS_PRESENT(expected_mapped)
+            || (OPTIONAL_IS_PRESENT(mapped[index]) && mapped[index]._value != expected_mapped._value)
+            || OPTIONAL_IS_PRESENT(filtered[index]) != OPTIONAL_IS_PRESENT(expected_filtered)
+            || (OPTIONAL_IS_PRESENT(filtered[index]) && filtered[index]._value != expected_filtered._value);
+        expected_sum += OPTIONAL_OR_ELSE(expected_filtered, 0);
+    }
+    TEST_ASSERT_INT_EQUALS(mismatches, 0);
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(sum));
+    TEST_ASSERT(OPTIONAL_USE_VALUE(sum) == expected_sum);
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(small_sum));
+    TEST_ASSERT(OPTIONAL_USE_VALUE(small_sum) == 4 + 10 + 16 + 28);
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(nothing));
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(all_empty));
+    free(input);
+    free(mapped);
+    free(filtered);
+    work_pool_free(&pool);
+    TEST_PASS;
+}
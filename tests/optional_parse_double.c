@@ -0,0 +1,56 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <optional.h>
+#include <optional-parse.h>
+#include "test.h"
+
+#define PARSE(text) optional_parse_double(text, strlen(text))
+
+// Checks that a number is parsed exactly as strtod does
+#define TEST_ASSERT_PARSED(text) \
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(PARSE(text)) && PARSE(text)._value == strtod(text, NULL))
+
+/**
+ * Tests `optional_parse_double`.
+ */
+int main() {
+    // Given
+    const char *valid[] = {
+        "0", "-0.0", "1", "+1.5", "3.14159", ".5", "5.", "1e10", "1E-10", "-2.5e+3",
+        "0.1", "0.000001", "123456789012345678", "9007199254740993",
+        "12345678901234567890123", "1.7976931348623157e308", "4.9e-324",
+        "0.30000000000000004", "1e-400", "00000000000000000000001.5"
+    };
+    const char *invalid[] = {
+        "", "-", ".", "e5", "1e", "1e+", "1.2.3", "1,5", " 1", "1 ", "0x10", "inf", "nan", "1e400", "--1"
+    };
+    // When
+    const OPTIONAL(double) number = PARSE("-12.25");
+    // Then
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(number));
+    TEST_ASSERT(OPTIONAL_USE_VALUE(number) == -12.25);
+    for (size_t index = 0; index < sizeof(valid) / sizeof(valid[0]); index++) {
+        TEST_ASSERT_PARSED(valid[index]);
+    }
+    for (size_t index = 0; index < sizeof(invalid) / sizeof(invalid[0]); index++) {
+        TEST_ASSERT(OPTIONAL_IS_EMPTY(PARSE(invalid[index])));
+    }
+    TEST_PASS;
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <string.h>
+#include <optional.h>
+#include <optional-parse.h>
+#include "test.h"
+
+#define PARSE(text) optional_parse_int(text, strlen(text))
+
+/**
+ * Tests `optional_parse_int`.
+ */
+int main() {
+    // Given
+    const char digits[] = "12345678901";
+    // When
+    const OPTIONAL(int) zero = PARSE("0");
+    const OPTIONAL(int) positive = PARSE("+42");
+    const OPTIONAL(int) negative = PARSE("-1234567");
+    const OPTIONAL(int) eight = PARSE("87654321");
+    const OPTIONAL(int) nine = PARSE("987654321");
+    const OPTIONAL(int) padded = PARSE("00000000000000000000000123");
+    const OPTIONAL(int) max = PARSE("2147483647");
+    const OPTIONAL(int) min = PARSE("-2147483648");
+    const OPTIONAL(int) prefix = optional_parse_int(digits, 3);
+    const OPTIONAL(int) overflow = PARSE("2147483648");
+    const OPTIONAL(int) underflow = PARSE("-2147483649");
+    const OPTIONAL(int) long_overflow = PARSE("99999999999999999999");
+    const OPTIONAL(int) empty = PARSE("");
+    const OPTIONAL(int) sign = PARSE("-");
+    const OPTIONAL(int) space = PARSE(" 1");
+    const OPTIONAL(int) trailing = PARSE("1234567x");
+    const OPTIONAL(int) swar_trailing = PARSE("12345678/");
+    const OPTIONAL(int) swar_colon = PARSE("1234:678");
+    // Then
+    TEST_ASSERT_INT_EQUALS(OPTIONAL_USE_VALUE(zero), 0);
+    TEST_ASSERT_INT_EQUALS(OPTIONAL_USE_VALUE(positive), 42);
+    TEST_ASSERT_INT_EQUALS(OPTIONAL_USE_VALUE(negative), -1234567);
+    TEST_ASSERT_INT_EQUALS(OPTIONAL_USE_VALUE(eight), 87654321);
+    TEST_ASSERT_INT_EQUALS(OPTIONAL_USE_VALUE(nine), 987654321);
+    TEST_ASSERT_INT_EQUALS(OPTIONAL_USE_VALUE(padded), 123);
+    TEST_ASSERT(OPTIONAL_USE_VALUE(max) == 2147483647);
+    TEST_ASSERT(OPTIONAL_USE_VALUE(min) == -2147483647 - 1);
+    TEST_ASSERT_INT_EQUALS(OPTIONAL_USE_VALUE(prefix), 123);
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(zero));
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(min));
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(overflow));
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(underflow));
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(long_overflow));
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(empty));
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(sign));
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(space));
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(trailing));
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(swar_trailing));
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(swar_colon));
+    TEST_PASS;
+}
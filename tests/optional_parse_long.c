@@ -0,0 +1,57 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <limits.h>
+#include <string.h>
+#include <optional.h>
+#include <optional-parse.h>
+#include "test.h"
+
+#define PARSE(text) optional_parse_long(text, strlen(text))
+
+/**
+ * Tests `optional_parse_long`.
+ */
+int main() {
+    // Given
+    char max_text[32];
+    char min_text[32];
+    char overflow_text[32];
+    snprintf(max_text, sizeof(max_text), "%ld", LONG_MAX);
+    snprintf(min_text, sizeof(min_text), "%ld", LONG_MIN);
+    snprintf(overflow_text, sizeof(overflow_text), "%lu", (unsigned long) LONG_MAX + 1);
+    // When
+    const OPTIONAL(long) sixteen = PARSE("-1234567812345678");
+    const OPTIONAL(long) negative_zero = PARSE("-0");
+    const OPTIONAL(long) max = PARSE(max_text);
+    const OPTIONAL(long) min = PARSE(min_text);
+    const OPTIONAL(long) overflow = PARSE(overflow_text);
+    const OPTIONAL(long) twenty = PARSE("12345678901234567890");
+    const OPTIONAL(long) malformed = PARSE("12345678a2345678");
+    // Then
+    TEST_ASSERT(OPTIONAL_USE_VALUE(sixteen) == -1234567812345678L);
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(negative_zero));
+    TEST_ASSERT(OPTIONAL_USE_VALUE(negative_zero) == 0);
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(max));
+    TEST_ASSERT(OPTIONAL_USE_VALUE(max) == LONG_MAX);
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(min));
+    TEST_ASSERT(OPTIONAL_USE_VALUE(min) == LONG_MIN);
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(overflow));
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(twenty));
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(malformed));
+    TEST_PASS;
+}
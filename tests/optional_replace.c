@@ -0,0 +1,51 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <optional.h>
+#include "test.h"
+
+typedef struct {
+    int x;
+    int y;
+} point;
+
+OPTIONAL_STRUCT(point);
+
+#define POINT(x, y) \
+    ((point) { x, y })
+
+/**
+ * Tests `OPTIONAL_REPLACE`.
+ */
+int main() {
+    // Given
+    OPTIONAL(point) present = OPTIONAL_PRESENT(POINT(123, 456));
+    OPTIONAL(point) empty = OPTIONAL_EMPTY;
+    // When
+    const OPTIONAL(point) replaced_present = OPTIONAL_REPLACE(present, POINT(7, 8));
+    const OPTIONAL(point) replaced_empty = OPTIONAL_REPLACE(empty, POINT(9, 10));
+    // Then
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(replaced_present));
+    TEST_ASSERT_INT_EQUALS(OPTIONAL_USE_VALUE(replaced_present).x, 123);
+    TEST_ASSERT_INT_EQUALS(OPTIONAL_USE_VALUE(replaced_present).y, 456);
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(present));
+    TEST_ASSERT_INT_EQUALS(OPTIONAL_USE_VALUE(present).x, 7);
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(replaced_empty));
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(empty));
+    TEST_ASSERT_INT_EQUALS(OPTIONAL_USE_VALUE(empty).y, 10);
+    TEST_PASS;
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <optional.h>
+#include "test.h"
+
+typedef struct {
+    char text[100];
+} large;
+
+OPTIONAL_STRUCT(large);
+
+/**
+ * Tests `OPTIONAL_SWAP`.
+ */
+int main() {
+    // Given
+    OPTIONAL(large) present = OPTIONAL_PRESENT(((large) {"present"}));
+    OPTIONAL(large) empty = OPTIONAL_EMPTY;
+    OPTIONAL(large) other = OPTIONAL_PRESENT(((large) {"other"}));
+    // When
+    OPTIONAL_SWAP(present, empty);
+    OPTIONAL_SWAP(empty, other);
+    // Then
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(present));
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(empty));
+    TEST_ASSERT_STR_EQUALS(OPTIONAL_USE_VALUE(empty).text, "other");
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(other));
+    TEST_ASSERT_STR_EQUALS(OPTIONAL_USE_VALUE(other).text, "present");
+    TEST_PASS;
+}
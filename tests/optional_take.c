@@ -0,0 +1,47 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdlib.h>
+#include <optional.h>
+#include "test.h"
+
+typedef char *string;
+
+OPTIONAL_STRUCT(string);
+
+/**
+ * Tests `OPTIONAL_TAKE`.
+ */
+int main() {
+    // Given
+    string owned = malloc(1);
+    OPTIONAL(string) present = OPTIONAL_PRESENT(owned);
+    OPTIONAL(string) empty = OPTIONAL_EMPTY;
+    // When
+    OPTIONAL(string) taken_present = OPTIONAL_TAKE(present);
+    const OPTIONAL(string) taken_again = OPTIONAL_TAKE(present);
+    const OPTIONAL(string) taken_empty = OPTIONAL_TAKE(empty);
+    // Then
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(taken_present));
+    TEST_ASSERT(OPTIONAL_USE_VALUE(taken_present) == owned);
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(present));
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(taken_again));
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(taken_empty));
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(empty));
+    OPTIONAL_IF_PRESENT(taken_present, free);
+    TEST_PASS;
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <perfect-hash.h>
+#include "test.h"
+
+#define KEYS 50000
+
+/**
+ * Tests `perfect_hash_build`.
+ */
+int main() {
+    // Given
+    static int keys[KEYS];
+    struct perfect_hash table;
+    for (int index = 0; index < KEYS; index++) {
+        keys[index] = index * 7 - KEYS;
+    }
+    // When
+    const bool built = perfect_hash_build(&table, keys, KEYS);
+    // Then
+    TEST_ASSERT(built);
+    for (int index = 0; index < KEYS; index++) {
+        const int found = (int) perfect_hash_lookup(&table, keys[index]);
+        TEST_ASSERT_INT_EQUALS(found, index);
+    }
+    perfect_hash_free(&table);
+    TEST_PASS;
+}
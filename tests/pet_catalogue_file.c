@@ -0,0 +1,97 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <optional.h>
+#include <pet-catalogue-file.h>
+#include "test.h"
+
+#define PETS 1000
+
+/**
+ * Tests `pet_catalogue_file_write` and `pet_catalogue_file_map`.
+ */
+int main() {
+    // Given
+    char path[] = "/tmp/pet-catalogue-XXXXXX";
+    const int descriptor = mkstemp(path);
+    TEST_ASSERT(descriptor >= 0);
+    (void) close(descriptor);
+    static int ids[PETS];
+    static uint8_t statuses[PETS];
+    static const char *names[PETS];
+    for (int index = 0; index < PETS; index++) {
+        ids[index] = index * 7;
+        statuses[index] = (uint8_t) (index % 3);
+        names[index] = index % 2 == 0 ? "Snoopy" : "Odie";
+    }
+    struct pet_catalogue_file catalogue;
+    struct pet_catalogue_file outdated;
+    struct pet_catalogue_file corrupt;
+    // When
+    TEST_ASSERT(pet_catalogue_file_write(path, ids, statuses, names, PETS));
+    const bool mapped = pet_catalogue_file_map(&catalogue, path);
+    FILE *file = fopen(path, "r+b");
+    TEST_ASSERT(file != NULL);
+    const uint32_t version = PET_CATALOGUE_FILE_VERSION + 1;
+    TEST_ASSERT(fseek(file, offsetof(struct pet_catalogue_file_header, version), SEEK_SET) == 0);
+    TEST_ASSERT(fwrite(&version, sizeof(version), 1, file) == 1);
+    TEST_ASSERT(fclose(file) == 0);
+    const bool outdated_mapped = pet_catalogue_file_map(&outdated, path);
+    const struct pet_catalogue_file_header *header = catalogue.data;
+    const uint32_t current = PET_CATALOGUE_FILE_VERSION;
+    const uint32_t bad_name = (uint32_t) header->strings_size;
+    const uint32_t bad_slot = PETS;
+    const uint32_t name = catalogue.names[0];
+    const uint32_t slot = catalogue.hash.slots[0];
+    file = fopen(path, "r+b");
+    TEST_ASSERT(file != NULL);
+    TEST_ASSERT(fseek(file, offsetof(struct pet_catalogue_file_header, version), SEEK_SET) == 0);
+    TEST_ASSERT(fwrite(&current, sizeof(current), 1, file) == 1);
+    TEST_ASSERT(fseek(file, (long) header->names, SEEK_SET) == 0);
+    TEST_ASSERT(fwrite(&bad_name, sizeof(bad_name), 1, file) == 1);
+    TEST_ASSERT(fflush(file) == 0);
+    const bool bad_name_mapped = pet_catalogue_file_map(&corrupt, path);
+    TEST_ASSERT(fseek(file, (long) header->names, SEEK_SET) == 0);
+    TEST_ASSERT(fwrite(&name, sizeof(name), 1, file) == 1);
+    TEST_ASSERT(fseek(file, (long) header->slots, SEEK_SET) == 0);
+    TEST_ASSERT(fwrite(&bad_slot, sizeof(bad_slot), 1, file) == 1);
+    TEST_ASSERT(fflush(file) == 0);
+    const bool bad_slot_mapped = pet_catalogue_file_map(&corrupt, path);
+    TEST_ASSERT(fseek(file, (long) header->slots, SEEK_SET) == 0);
+    TEST_ASSERT(fwrite(&slot, sizeof(slot), 1, file) == 1);
+    TEST_ASSERT(fclose(file) == 0);
+    const bool restored_mapped = pet_catalogue_file_map(&corrupt, path);
+    // Then
+    TEST_ASSERT(mapped);
+    TEST_ASSERT(!outdated_mapped);
+    TEST_ASSERT(!bad_name_mapped);
+    TEST_ASSERT(!bad_slot_mapped);
+    TEST_ASSERT(restored_mapped);
+    TEST_ASSERT_INT_EQUALS((int) catalogue.count, PETS);
+    for (int index = 0; index < PETS; index++) {
+        const uint32_t found = perfect_hash_lookup(&catalogue.hash, index * 7);
+        TEST_ASSERT_INT_EQUALS((int) found, index);
+        TEST_ASSERT_INT_EQUALS(catalogue.ids[found], index * 7);
+        TEST_ASSERT_INT_EQUALS((int) catalogue.statuses[found], index % 3);
+        TEST_ASSERT_STR_EQUALS(catalogue.strings + catalogue.names[found], names[index]);
+    }
+    TEST_ASSERT(catalogue.ids[perfect_hash_lookup(&catalogue.hash, 1)] != 1);
+    pet_catalogue_file_unmap(&catalogue);
+    pet_catalogue_file_unmap(&corrupt);
+    TEST_ASSERT(remove(path) == 0);
+    TEST_PASS;
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <optional.h>
+#include <pet-columns.h>
+#include "test.h"
+
+/**
+ * Tests `pet_columns`.
+ */
+int main() {
+    // Given
+    static int ids[] = {0, 1};
+    static _Atomic uint8_t statuses[] = {0, 2};
+    static uint32_t names[] = {0, 6};
+    static char strings[] = "Rocky\0Garfield";
+    struct pet_columns columns = {
+        .count = 2,
+        .capacity = 2,
+        .ids = ids,
+        .statuses = statuses,
+        .names = names,
+        .strings = strings,
+        .strings_size = sizeof(strings),
+        .strings_capacity = sizeof(strings),
+        .borrowed = true
+    };
+    // When
+    const size_t snoopy = pet_columns_append(&columns, 10, "Snoopy", 1);
+    const size_t another_snoopy = pet_columns_append(&columns, 11, "Snoopy", 0);
+    const size_t another_rocky = pet_columns_append(&columns, 12, "Rocky", 0);
+    for (int id = 100; id < 200; id++) {
+        TEST_ASSERT(pet_columns_append(&columns, id, "Pet", 0) != SIZE_MAX);
+    }
+    // Then
+    TEST_ASSERT(!columns.borrowed);
+    TEST_ASSERT_INT_EQUALS((int) snoopy, 2);
+    TEST_ASSERT_INT_EQUALS(columns.ids[another_snoopy], 11);
+    TEST_ASSERT_INT_EQUALS((int) atomic_load(&columns.statuses[snoopy]), 1);
+    TEST_ASSERT_STR_EQUALS(pet_columns_name(&columns, 1), "Garfield");
+    TEST_ASSERT_STR_EQUALS(pet_columns_name(&columns, snoopy), "Snoopy");
+    TEST_ASSERT(pet_columns_name(&columns, another_snoopy) == pet_columns_name(&columns, snoopy));
+    TEST_ASSERT(pet_columns_name(&columns, another_rocky) == pet_columns_name(&columns, 0));
+    TEST_ASSERT_INT_EQUALS((int) columns.count, 105);
+    TEST_ASSERT(pet_columns_name(&columns, 104) == pet_columns_name(&columns, 5));
+    pet_columns_free(&columns);
+    TEST_PASS;
+}
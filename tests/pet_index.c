@@ -0,0 +1,59 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <pet-index.h>
+#include "test.h"
+
+#define PETS 1000
+
+/**
+ * Tests `pet_index_find` and `pet_index_range`.
+ */
+int main() {
+    // Given
+    static struct pet pets[PETS];
+    static Pet unsorted[PETS];
+    struct pet_index index;
+    for (int position = 0; position < PETS; position++) {
+        // Ids are multiples of 3, in scrambled order
+        pets[position].id = (position * 7919 % PETS) * 3;
+        unsorted[position] = &pets[position];
+    }
+    // When
+    const bool built = pet_index_build(&index, unsorted, PETS);
+    struct pet_range range = pet_index_range(&index, 100, 200);
+    struct pet_range past_the_end = pet_index_range(&index, 3 * PETS, 5000);
+    // Then
+    TEST_ASSERT(built);
+    for (int id = -1; id < 3 * PETS; id++) {
+        const OPTIONAL(Pet) found = pet_index_find(&index, id);
+        TEST_ASSERT_BOOL_EQUALS(OPTIONAL_IS_PRESENT(found), id >= 0 && id % 3 == 0);
+        if (OPTIONAL_IS_PRESENT(found)) {
+            TEST_ASSERT_INT_EQUALS(PET_ID(OPTIONAL_USE_VALUE(found)), id);
+        }
+    }
+    for (int id = 102; id < 200; id += 3) {
+        const OPTIONAL(Pet) next = pet_range_next(&range);
+        TEST_ASSERT(OPTIONAL_IS_PRESENT(next));
+        TEST_ASSERT_INT_EQUALS(PET_ID(OPTIONAL_USE_VALUE(next)), id);
+    }
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(pet_range_next(&range)));
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(pet_range_next(&range)));
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(pet_range_next(&past_the_end)));
+    pet_index_free(&index);
+    TEST_PASS;
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdint.h>
+#include <stdio.h>
+#include <optional.h>
+#include <pet-log.h>
+#include "test.h"
+
+#define WRITERS 4
+#define RECORDS 100
+
+static struct pet_log log_file;
+static int replayed[WRITERS * RECORDS];
+static int failures;
+
+// Appends records for a different range of pet ids for each writer
+static void *append_records(void *argument) {
+    const int writer = (int) (intptr_t) argument;
+    for (int index = 0; index < RECORDS; index++) {
+        if (!pet_log_append(&log_file, writer * RECORDS + index, 2)) {
+            failures++;
+        }
+    }
+    return NULL;
+}
+
+// Counts the replayed records of each pet
+static void count_record(const struct pet_log_record *record, void *context) {
+    (*(int *) context)++;
+    replayed[record->pet_id]++;
+}
+
+/**
+ * Tests that concurrent `pet_log_append` calls survive a torn tail.
+ */
+int main() {
+    // Given
+    char path[] = "/tmp/pet-log-XXXXXX";
+    const int descriptor = mkstemp(path);
+    TEST_ASSERT(descriptor >= 0);
+    (void) close(descriptor);
+    int first_count = 0;
+    int second_count = 0;
+    pthread_t writers[WRITERS];
+    TEST_ASSERT(pet_log_open(&log_file, path, 16, 100000, count_record, &first_count));
+    // When
+    for (int writer = 0; writer < WRITERS; writer++) {
+        TEST_ASSERT(pthread_create(&writers[writer], NULL, append_records, (void *) (intptr_t) writer) == 0);
+    }
+    for (int writer = 0; writer < WRITERS; writer++) {
+        TEST_ASSERT(pthread_join(writers[writer], NULL) == 0);
+    }
+    pet_log_close(&log_file);
+    FILE *file = fopen(path, "ab");
+    TEST_ASSERT(file != NULL);
+    TEST_ASSERT(fwrite("torn", 1, 4, file) == 4);
+    TEST_ASSERT(fclose(file) == 0);
+    TEST_ASSERT(pet_log_open(&log_file, path, 16, 100000, count_record, &second_count));
+    const bool appended = pet_log_append(&log_file, 0, 0);
+    pet_log_close(&log_file);
+    struct stat status;
+    TEST_ASSERT(stat(path, &status) == 0);
+    // Then
+    TEST_ASSERT_INT_EQUALS(failures, 0);
+    TEST_ASSERT_INT_EQUALS(first_count, 0);
+    TEST_ASSERT_INT_EQUALS(second_count, WRITERS * RECORDS);
+    for (int index = 0; index < WRITERS * RECORDS; index++) {
+        TEST_ASSERT_INT_EQUALS(replayed[index], 1);
+    }
+    TEST_ASSERT(appended);
+    TEST_ASSERT_INT_EQUALS((int) status.st_size, (WRITERS * RECORDS + 1) * 16);
+    TEST_ASSERT(remove(path) == 0);
+    TEST_PASS;
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <string.h>
+#include <optional.h>
+#include <pet-protocol.h>
+#include "test.h"
+
+/**
+ * Tests `pet_requests_execute` with a pipelined batch of requests.
+ */
+int main() {
+    // Given
+    const struct pet_request requests[] = {
+        {.operation = PET_REQUEST_FIND, .pet_id = 0},
+        {.operation = PET_REQUEST_BUY, .pet_id = 0},
+        {.operation = PET_REQUEST_BUY, .pet_id = 0},
+        {.operation = PET_REQUEST_FIND, .pet_id = 999},
+        {.operation = 0, .pet_id = 1}
+    };
+    char input[sizeof(requests)];
+    memcpy(input, requests, sizeof(requests));
+    struct pet_response responses[5];
+    size_t first_count;
+    size_t second_count;
+    // When
+    const size_t first = pet_requests_execute(input, sizeof(input) - 1, responses, 5, &first_count);
+    const size_t second = pet_requests_execute(input + first, sizeof(input) - first, responses + first_count, 5, &second_count);
+    // Then
+    TEST_ASSERT_INT_EQUALS((int) first, 4 * (int) sizeof(struct pet_request));
+    TEST_ASSERT_INT_EQUALS((int) first_count, 4);
+    TEST_ASSERT_INT_EQUALS((int) second, (int) sizeof(struct pet_request));
+    TEST_ASSERT_INT_EQUALS((int) second_count, 1);
+    TEST_ASSERT_INT_EQUALS(responses[0].present, 1);
+    TEST_ASSERT_INT_EQUALS(responses[0].pet_id, 0);
+    TEST_ASSERT_STR_EQUALS(responses[0].name, "Rocky");
+    TEST_ASSERT_INT_EQUALS(responses[0].status, AVAILABLE);
+    TEST_ASSERT_INT_EQUALS(responses[1].present, 1);
+    TEST_ASSERT_INT_EQUALS(responses[1].status, SOLD);
+    TEST_ASSERT_INT_EQUALS(responses[2].present, 0);
+    TEST_ASSERT_INT_EQUALS(responses[3].present, 0);
+    TEST_ASSERT_INT_EQUALS(responses[4].present, 0);
+    TEST_PASS;
+}
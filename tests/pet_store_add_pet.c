@@ -0,0 +1,43 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <optional.h>
+#include <pet-store.h>
+#include "test.h"
+
+/**
+ * Tests `add_pet`.
+ */
+int main() {
+    // Given
+    struct pet new_pet = {.id = 1000, .name = "Snoopy", .status = AVAILABLE};
+    struct pet duplicate = {.id = 0, .name = "Impostor", .status = AVAILABLE};
+    // When
+    const OPTIONAL(Pet) added = add_pet(&new_pet);
+    const OPTIONAL(Pet) not_added = add_pet(&duplicate);
+    const RESULT(Pet, pet_error) found = find_pet(1000);
+    const RESULT(Pet, pet_error) original = find_pet(0);
+    // Then
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(added));
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(not_added));
+    TEST_ASSERT(RESULT_IS_SUCCESS(found));
+    TEST_ASSERT_STR_EQUALS(PET_NAME(RESULT_USE_VALUE(found)), "Snoopy");
+    TEST_ASSERT(RESULT_IS_SUCCESS(original));
+    TEST_ASSERT_STR_EQUALS(PET_NAME(RESULT_USE_VALUE(original)), "Rocky");
+    TEST_ASSERT_INT_EQUALS(RESULT_USE_ERROR(find_pet(1001)), PET_NOT_FOUND);
+    TEST_PASS;
+}
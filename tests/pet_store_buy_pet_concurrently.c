@@ -0,0 +1,101 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <optional.h>
+#include <pet-store.h>
+#include <status-bitmap.h>
+#include "test.h"
+
+#define PETS 1000
+#define BUYERS 8
+
+static struct pet pets[PETS];
+static atomic_int sales[PETS];
+static int purchases[BUYERS];
+
+// Tries to buy every pet, starting at a different one for each buyer
+static void *buy_all_pets(void *argument) {
+    const int buyer = (int) (intptr_t) argument;
+    for (int index = 0; index < PETS; index++) {
+        const int pet = (index + buyer * PETS / BUYERS) % PETS;
+        const RESULT(Pet, pet_error) found = find_pet(1000 + pet);
+        const RESULT(Pet, pet_error) bought = RESULT_FLAT_MAP(found, buy_pet);
+        if (RESULT_IS_SUCCESS(bought)) {
+            atomic_fetch_add(&sales[pet], 1);
+            purchases[buyer]++;
+        }
+    }
+    return NULL;
+}
+
+// Builds the status bitmaps while the pets are being bought
+static void *find_available_pets(void *argument) {
+    (void) argument;
+    struct status_bitmap_iterator available = find_pets_by_status(PET_STATUS_MASK(AVAILABLE), 0);
+    return (void *) available.bitmap;
+}
+
+/**
+ * Tests that concurrent calls to `buy_pet` sell every pet exactly once, and
+ * that the status bitmaps built meanwhile end up seeing every sale.
+ */
+int main() {
+    // Given
+    pthread_t buyers[BUYERS];
+    pthread_t finder;
+    void *found = NULL;
+    for (int index = 0; index < PETS; index++) {
+        pets[index] = (struct pet) {.id = 1000 + index, .name = "Pet", .status = AVAILABLE};
+        TEST_ASSERT(OPTIONAL_IS_PRESENT(add_pet(&pets[index])));
+    }
+    // When
+    for (int buyer = 0; buyer < BUYERS; buyer++) {
+        TEST_ASSERT(pthread_create(&buyers[buyer], NULL, buy_all_pets, (void *) (intptr_t) buyer) == 0);
+        if (buyer == BUYERS / 2) {
+            TEST_ASSERT(pthread_create(&finder, NULL, find_available_pets, NULL) == 0);
+        }
+    }
+    for (int buyer = 0; buyer < BUYERS; buyer++) {
+        TEST_ASSERT(pthread_join(buyers[buyer], NULL) == 0);
+    }
+    TEST_ASSERT(pthread_join(finder, &found) == 0);
+    struct status_bitmap_iterator available = find_pets_by_status(PET_STATUS_MASK(AVAILABLE), 0);
+    struct status_bitmap_iterator sold = find_pets_by_status(PET_STATUS_MASK(SOLD), 0);
+    // Then
+    int total = 0;
+    for (int buyer = 0; buyer < BUYERS; buyer++) {
+        total += purchases[buyer];
+    }
+    for (int index = 0; index < PETS; index++) {
+        TEST_ASSERT_INT_EQUALS(atomic_load(&sales[index]), 1);
+        TEST_ASSERT(PET_STATUS(&pets[index]) == SOLD);
+    }
+    TEST_ASSERT_INT_EQUALS(total, PETS);
+    TEST_ASSERT(found != NULL);
+    for (OPTIONAL(Pet) pet = status_bitmap_next(&available); OPTIONAL_IS_PRESENT(pet); pet = status_bitmap_next(&available)) {
+        TEST_ASSERT(PET_ID(OPTIONAL_USE_VALUE(pet)) < 1000);
+    }
+    int sold_pets = 0;
+    for (OPTIONAL(Pet) pet = status_bitmap_next(&sold); OPTIONAL_IS_PRESENT(pet); pet = status_bitmap_next(&sold)) {
+        sold_pets += PET_ID(OPTIONAL_USE_VALUE(pet)) >= 1000;
+    }
+    TEST_ASSERT_INT_EQUALS(sold_pets, PETS);
+    TEST_PASS;
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <optional.h>
+#include <pet-store.h>
+#include "test.h"
+
+/**
+ * Tests the lookup cache of `find_pet`.
+ */
+int main() {
+    // Given
+    struct pet snoopy = {.id = 1000, .name = "Snoopy", .status = AVAILABLE};
+    struct pet odie = {.id = 2000, .name = "Odie", .status = AVAILABLE};
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(add_pet(&snoopy)));
+    const pet_cache_stats before = get_pet_cache_stats();
+    // When
+    const RESULT(Pet, pet_error) first = find_pet(1000);
+    const RESULT(Pet, pet_error) second = find_pet(1000);
+    const RESULT(Pet, pet_error) first_miss = find_pet(2000);
+    const RESULT(Pet, pet_error) second_miss = find_pet(2000);
+    const pet_cache_stats after_lookups = get_pet_cache_stats();
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(add_pet(&odie)));
+    const pet_cache_stats before_add = get_pet_cache_stats();
+    const RESULT(Pet, pet_error) added = find_pet(2000);
+    const pet_cache_stats after_add = get_pet_cache_stats();
+    // Then
+    TEST_ASSERT(RESULT_IS_SUCCESS(first));
+    TEST_ASSERT(RESULT_IS_SUCCESS(second));
+    TEST_ASSERT(RESULT_USE_VALUE(second) == &snoopy);
+    TEST_ASSERT(RESULT_IS_FAILURE(first_miss));
+    TEST_ASSERT(RESULT_IS_FAILURE(second_miss));
+    TEST_ASSERT(RESULT_IS_SUCCESS(added));
+    TEST_ASSERT(RESULT_USE_VALUE(added) == &odie);
+    TEST_ASSERT_INT_EQUALS((int) (after_lookups.hits - before.hits), 2);
+    TEST_ASSERT_INT_EQUALS((int) (after_lookups.misses - before.misses), 2);
+    TEST_ASSERT_INT_EQUALS((int) (after_add.hits - before_add.hits), 0);
+    TEST_ASSERT_INT_EQUALS((int) (after_add.misses - before_add.misses), 1);
+    TEST_PASS;
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <optional.h>
+#include <name-index.h>
+#include "test.h"
+
+/**
+ * Tests `find_pet_by_name`, `find_pets_by_name_ignoring_case` and
+ * `find_pets_by_name_prefix`.
+ */
+int main() {
+    // Given
+    struct pet snoopy = {.id = 1000, .name = "Snoopy", .status = AVAILABLE};
+    struct pet garfield = {.id = 2000, .name = "garfield", .status = AVAILABLE};
+    struct pet twin = {.id = 3000, .name = "Twin", .status = AVAILABLE};
+    struct pet other_twin = {.id = 3001, .name = "Twin", .status = AVAILABLE};
+    struct pet other_rocky = {.id = 4000, .name = "Rocky", .status = AVAILABLE};
+    // When
+    const OPTIONAL(Pet) rocky = find_pet_by_name("Rocky");
+    const OPTIONAL(Pet) before = find_pet_by_name("Snoopy");
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(add_pet(&snoopy)));
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(add_pet(&garfield)));
+    const OPTIONAL(Pet) after = find_pet_by_name("Snoopy");
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(add_pet(&twin)));
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(add_pet(&other_twin)));
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(add_pet(&other_rocky)));
+    const OPTIONAL(Pet) twins = find_pet_by_name("Twin");
+    const OPTIONAL(Pet) rockies = find_pet_by_name("Rocky");
+    struct pet_name_range garfields = find_pets_by_name_ignoring_case("GARFIELD");
+    struct pet_name_range ran = find_pets_by_name_prefix("Ran");
+    // Then
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(rocky));
+    TEST_ASSERT_INT_EQUALS(PET_ID(OPTIONAL_USE_VALUE(rocky)), 0);
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(before));
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(after));
+    TEST_ASSERT(OPTIONAL_USE_VALUE(after) == &snoopy);
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(twins));
+    TEST_ASSERT(OPTIONAL_USE_VALUE(twins) == &twin || OPTIONAL_USE_VALUE(twins) == &other_twin);
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(rockies));
+    TEST_ASSERT_INT_EQUALS(PET_ID(OPTIONAL_USE_VALUE(rockies)), 0);
+    const OPTIONAL(Pet) first = pet_name_range_next(&garfields);
+    const OPTIONAL(Pet) second = pet_name_range_next(&garfields);
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(first));
+    TEST_ASSERT_STR_EQUALS(PET_NAME(OPTIONAL_USE_VALUE(first)), "Garfield");
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(second));
+    TEST_ASSERT(OPTIONAL_USE_VALUE(second) == &garfield);
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(pet_name_range_next(&garfields)));
+    const OPTIONAL(Pet) rantanplan = pet_name_range_next(&ran);
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(rantanplan));
+    TEST_ASSERT_STR_EQUALS(PET_NAME(OPTIONAL_USE_VALUE(rantanplan)), "Rantanplan");
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(pet_name_range_next(&ran)));
+    TEST_PASS;
+}
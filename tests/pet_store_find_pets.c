@@ -0,0 +1,53 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <optional.h>
+#include <pet-store.h>
+#include "test.h"
+
+#define PETS 100
+
+/**
+ * Tests `find_pets`.
+ */
+int main() {
+    // Given
+    static struct pet added[PETS];
+    int ids[3 * PETS];
+    OPTIONAL(Pet) found[3 * PETS];
+    for (int index = 0; index < PETS; index++) {
+        added[index].id = 1000 + index;
+        TEST_ASSERT(OPTIONAL_IS_PRESENT(add_pet(&added[index])));
+    }
+    for (int index = 0; index < 3 * PETS; index++) {
+        ids[index] = index % 2 == 0 ? 1000 + index : index;
+    }
+    // When
+    find_pets(ids, 3 * PETS, found);
+    // Then
+    for (int index = 0; index < 3 * PETS; index++) {
+        const RESULT(Pet, pet_error) expected = find_pet(ids[index]);
+        TEST_ASSERT_BOOL_EQUALS(OPTIONAL_IS_PRESENT(found[index]), RESULT_IS_SUCCESS(expected));
+        if (RESULT_IS_SUCCESS(expected)) {
+            TEST_ASSERT(OPTIONAL_USE_VALUE(found[index]) == RESULT_USE_VALUE(expected));
+        }
+    }
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(found[1]));
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(found[PETS - 2]));
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(found[PETS]));
+    TEST_PASS;
+}
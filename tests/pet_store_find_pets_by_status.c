@@ -0,0 +1,58 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <optional.h>
+#include <status-bitmap.h>
+#include "test.h"
+
+/**
+ * Tests `find_pets_by_status`.
+ */
+int main() {
+    // Given
+    struct pet snoopy = {.id = 5, .name = "Snoopy", .status = AVAILABLE};
+    struct pet odie = {.id = 10, .name = "Odie", .status = PENDING};
+    struct pet impostor = {.id = 5, .name = "Impostor", .status = AVAILABLE};
+    // When
+    struct status_bitmap_iterator available = find_pets_by_status(PET_STATUS_MASK(AVAILABLE), 0);
+    const OPTIONAL(Pet) rocky = status_bitmap_next(&available);
+    const OPTIONAL(Pet) none = status_bitmap_next(&available);
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(add_pet(&snoopy)));
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(add_pet(&odie)));
+    TEST_ASSERT(RESULT_IS_SUCCESS(buy_pet(OPTIONAL_USE_VALUE(rocky))));
+    TEST_ASSERT(RESULT_IS_SUCCESS(buy_pet(&impostor)));
+    struct status_bitmap_iterator after = find_pets_by_status(PET_STATUS_MASK(AVAILABLE), 0);
+    struct status_bitmap_iterator unsold = find_pets_by_status(PET_STATUS_MASK(AVAILABLE) | PET_STATUS_MASK(PENDING), 0);
+    struct status_bitmap_iterator nothing = find_pets_by_status(0, PET_STATUS_MASK(AVAILABLE) | PET_STATUS_MASK(SOLD));
+    // Then
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(rocky));
+    TEST_ASSERT_STR_EQUALS(PET_NAME(OPTIONAL_USE_VALUE(rocky)), "Rocky");
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(none));
+    const OPTIONAL(Pet) only = status_bitmap_next(&after);
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(only));
+    TEST_ASSERT(OPTIONAL_USE_VALUE(only) == &snoopy);
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(status_bitmap_next(&after)));
+    const char *expected[] = {"Garfield", "Snoopy", "Odie"};
+    for (int index = 0; index < 3; index++) {
+        const OPTIONAL(Pet) next = status_bitmap_next(&unsold);
+        TEST_ASSERT(OPTIONAL_IS_PRESENT(next));
+        TEST_ASSERT_STR_EQUALS(PET_NAME(OPTIONAL_USE_VALUE(next)), expected[index]);
+    }
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(status_bitmap_next(&unsold)));
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(status_bitmap_next(&nothing)));
+    TEST_PASS;
+}
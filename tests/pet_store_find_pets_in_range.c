@@ -0,0 +1,51 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <optional.h>
+#include <pet-index.h>
+#include "test.h"
+
+/**
+ * Tests `find_pets_in_range`.
+ */
+int main() {
+    // Given
+    struct pet snoopy = {.id = 5, .name = "Snoopy", .status = AVAILABLE};
+    struct pet odie = {.id = 10, .name = "Odie", .status = AVAILABLE};
+    // When
+    struct pet_range before = find_pets_in_range(1, 8);
+    const OPTIONAL(Pet) first = pet_range_next(&before);
+    const OPTIONAL(Pet) second = pet_range_next(&before);
+    const OPTIONAL(Pet) third = pet_range_next(&before);
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(add_pet(&odie)));
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(add_pet(&snoopy)));
+    struct pet_range after = find_pets_in_range(1, 8);
+    // Then
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(first));
+    TEST_ASSERT_STR_EQUALS(PET_NAME(OPTIONAL_USE_VALUE(first)), "Garfield");
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(second));
+    TEST_ASSERT_STR_EQUALS(PET_NAME(OPTIONAL_USE_VALUE(second)), "Rantanplan");
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(third));
+    const char *expected[] = {"Garfield", "Rantanplan", "Snoopy"};
+    for (int index = 0; index < 3; index++) {
+        const OPTIONAL(Pet) next = pet_range_next(&after);
+        TEST_ASSERT(OPTIONAL_IS_PRESENT(next));
+        TEST_ASSERT_STR_EQUALS(PET_NAME(OPTIONAL_USE_VALUE(next)), expected[index]);
+    }
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(pet_range_next(&after)));
+    TEST_PASS;
+}
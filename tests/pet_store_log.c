@@ -0,0 +1,88 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <optional.h>
+#include <pet-log.h>
+#include <pet-store.h>
+#include <status-bitmap.h>
+#include "test.h"
+
+#define PETS 10
+
+static struct pet pets[PETS];
+
+static void ignore_record(const struct pet_log_record *record, void *context) {
+    (void) record;
+    (void) context;
+}
+
+/**
+ * Tests that `buy_pet` sales are logged and replayed by `open_pet_log`.
+ */
+int main() {
+    // Given
+    char path[] = "/tmp/pet-store-log-XXXXXX";
+    const int descriptor = mkstemp(path);
+    TEST_ASSERT(descriptor >= 0);
+    (void) close(descriptor);
+    for (int index = 0; index < PETS; index++) {
+        pets[index] = (struct pet) {.id = 1000 + index, .name = "Pet", .status = AVAILABLE};
+        TEST_ASSERT(OPTIONAL_IS_PRESENT(add_pet(&pets[index])));
+    }
+    TEST_ASSERT(open_pet_log(path, 8, 0));
+    // When
+    const RESULT(Pet, pet_error) first = buy_pet(&pets[0]);
+    const RESULT(Pet, pet_error) second = buy_pet(&pets[1]);
+    const RESULT(Pet, pet_error) again = buy_pet(&pets[0]);
+    close_pet_log();
+    // A record with a valid checksum but an unknown status
+    struct pet_log corrupt;
+    TEST_ASSERT(pet_log_open(&corrupt, path, 1, 0, ignore_record, NULL));
+    TEST_ASSERT(pet_log_append(&corrupt, 1003, SOLD + 1));
+    pet_log_close(&corrupt);
+    // Start over from the initial statuses, as if the store restarted
+    for (int index = 0; index < PETS; index++) {
+        pets[index].status = AVAILABLE;
+    }
+    const bool reopened = open_pet_log(path, 8, 0);
+    struct status_bitmap_iterator available = find_pets_by_status(PET_STATUS_MASK(AVAILABLE), 0);
+    int unsold = 0;
+    for (OPTIONAL(Pet) pet = status_bitmap_next(&available); OPTIONAL_IS_PRESENT(pet); pet = status_bitmap_next(&available)) {
+        unsold += PET_ID(OPTIONAL_USE_VALUE(pet)) >= 1000;
+    }
+    close_pet_log();
+    // Every append fails on a full device
+    const bool full = open_pet_log("/dev/full", 8, 0);
+    const RESULT(Pet, pet_error) unlogged = buy_pet(&pets[2]);
+    close_pet_log();
+    // Then
+    TEST_ASSERT(RESULT_IS_SUCCESS(first));
+    TEST_ASSERT(RESULT_IS_SUCCESS(second));
+    TEST_ASSERT_INT_EQUALS(RESULT_USE_ERROR(again), PET_ALREADY_SOLD);
+    TEST_ASSERT(reopened);
+    TEST_ASSERT(PET_STATUS(&pets[0]) == SOLD);
+    TEST_ASSERT(PET_STATUS(&pets[1]) == SOLD);
+    TEST_ASSERT(PET_STATUS(&pets[3]) == AVAILABLE);
+    TEST_ASSERT_INT_EQUALS(unsold, PETS - 2);
+    TEST_ASSERT(full);
+    TEST_ASSERT_INT_EQUALS(RESULT_USE_ERROR(unlogged), PET_NOT_AVAILABLE);
+    TEST_ASSERT(PET_STATUS(&pets[2]) == AVAILABLE);
+    TEST_ASSERT(remove(path) == 0);
+    TEST_PASS;
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <optional.h>
+#include <pet-catalogue-file.h>
+#include <pet-store.h>
+#include "test.h"
+
+/**
+ * Tests `open_pet_catalogue`.
+ */
+int main() {
+    // Given
+    char path[] = "/tmp/pet-catalogue-XXXXXX";
+    const int descriptor = mkstemp(path);
+    TEST_ASSERT(descriptor >= 0);
+    (void) close(descriptor);
+    const int ids[] = {100, 200, 300};
+    const uint8_t statuses[] = {AVAILABLE, AVAILABLE, SOLD};
+    const char *names[] = {"Snoopy", "Odie", "Garfield"};
+    TEST_ASSERT(pet_catalogue_file_write(path, ids, statuses, names, 3));
+    char corrupt_path[] = "/tmp/pet-catalogue-XXXXXX";
+    const int corrupt_descriptor = mkstemp(corrupt_path);
+    TEST_ASSERT(corrupt_descriptor >= 0);
+    (void) close(corrupt_descriptor);
+    const uint8_t unknown_statuses[] = {AVAILABLE, SOLD + 1, SOLD};
+    TEST_ASSERT(pet_catalogue_file_write(corrupt_path, ids, unknown_statuses, names, 3));
+    // When
+    const bool corrupt_opened = open_pet_catalogue(corrupt_path);
+    const bool opened = open_pet_catalogue(path);
+    const RESULT(Pet, pet_error) compiled = find_pet(0);
+    const RESULT(Pet, pet_error) odie = find_pet(200);
+    const RESULT(Pet, pet_error) bought = buy_pet(RESULT_USE_VALUE(odie));
+    const OPTIONAL(Pet) garfield = find_pet_by_name("Garfield");
+    const OPTIONAL(Pet) rocky = new_pet(400, "Rocky", AVAILABLE);
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(rocky));
+    const OPTIONAL(Pet) added = add_pet(OPTIONAL_USE_VALUE(rocky));
+    const bool reopened = open_pet_catalogue(path);
+    const OPTIONAL(Pet) rockies = find_pet_by_name("Rocky");
+    const RESULT(Pet, pet_error) sold = find_pet(200);
+    // Then
+    TEST_ASSERT(!corrupt_opened);
+    TEST_ASSERT(opened);
+    TEST_ASSERT(RESULT_IS_FAILURE(compiled));
+    TEST_ASSERT(RESULT_IS_SUCCESS(odie));
+    TEST_ASSERT_STR_EQUALS(PET_NAME(RESULT_USE_VALUE(odie)), "Odie");
+    TEST_ASSERT(RESULT_IS_SUCCESS(bought));
+    TEST_ASSERT(PET_STATUS(RESULT_USE_VALUE(odie)) == SOLD);
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(garfield));
+    TEST_ASSERT_INT_EQUALS(PET_ID(OPTIONAL_USE_VALUE(garfield)), 300);
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(added));
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(rockies));
+    TEST_ASSERT_INT_EQUALS(PET_ID(OPTIONAL_USE_VALUE(rockies)), 400);
+    TEST_ASSERT(PET_STATUS(RESULT_USE_VALUE(sold)) == SOLD);
+    TEST_ASSERT(!reopened);
+    TEST_ASSERT(remove(path) == 0);
+    TEST_ASSERT(remove(corrupt_path) == 0);
+    TEST_PASS;
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <math.h>
+#include <optional.h>
+#include <pet-store.h>
+#include "test.h"
+
+#define PETS 5000
+
+/**
+ * Tests `set_pet_filter`.
+ */
+int main() {
+    // Given
+    static struct pet added[PETS];
+    const double rates[] = {0.01, 0.5, 0.01};
+    const size_t sizes[] = {1024 * 1024, 64, 0};
+    // When
+    for (int index = 0; index < PETS; index++) {
+        added[index].id = 1000 + index;
+        if (index % 1000 == 0) {
+            const int config = index / 1000 % 3;
+            TEST_ASSERT(set_pet_filter(rates[config], sizes[config]));
+        }
+        TEST_ASSERT(OPTIONAL_IS_PRESENT(add_pet(&added[index])));
+    }
+    const bool zero_rate = set_pet_filter(0.0, 1024);
+    const bool negative_rate = set_pet_filter(-0.1, 1024);
+    const bool certain_rate = set_pet_filter(1.0, 1024);
+    const bool not_a_rate = set_pet_filter(NAN, 1024);
+    // Then
+    TEST_ASSERT(!zero_rate);
+    TEST_ASSERT(!negative_rate);
+    TEST_ASSERT(!certain_rate);
+    TEST_ASSERT(!not_a_rate);
+    for (int config = 0; config < 3; config++) {
+        TEST_ASSERT(set_pet_filter(rates[config], sizes[config]));
+        for (int index = 0; index < PETS; index++) {
+            const RESULT(Pet, pet_error) hit = find_pet(1000 + index);
+            TEST_ASSERT(RESULT_IS_SUCCESS(hit));
+            TEST_ASSERT_INT_EQUALS(PET_ID(RESULT_USE_VALUE(hit)), 1000 + index);
+            TEST_ASSERT(RESULT_IS_FAILURE(find_pet(-1000 - index)));
+        }
+    }
+    TEST_PASS;
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <optional.h>
+#include <pet-catalogue-file.h>
+#include <pet-store.h>
+#include "test.h"
+
+#define PETS 1000
+#define WORKERS 4
+
+static int ids[PETS];
+static uint8_t statuses[PETS];
+static const char *names[PETS];
+
+// Tries to buy every pet, starting at a different one for each worker;
+// the first worker is killed halfway through
+static int buy_all_pets(const char *name, int worker, atomic_int *sales) {
+    if (!open_shared_pet_catalogue(name)) {
+        return EXIT_FAILURE;
+    }
+    for (int index = 0; index < PETS; index++) {
+        if (worker == 0 && index == PETS / 2) {
+            (void) raise(SIGKILL);
+        }
+        const int pet = (index + worker * PETS / WORKERS) % PETS;
+        const RESULT(Pet, pet_error) found = find_pet(1000 + pet);
+        const RESULT(Pet, pet_error) bought = RESULT_FLAT_MAP(found, buy_pet);
+        if (RESULT_IS_SUCCESS(bought)) {
+            atomic_fetch_add(&sales[pet], 1);
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * Tests that worker processes sharing a catalogue sell every pet once.
+ */
+int main() {
+    // Given
+    char path[] = "/tmp/pet-catalogue-XXXXXX";
+    const int descriptor = mkstemp(path);
+    TEST_ASSERT(descriptor >= 0);
+    (void) close(descriptor);
+    char name[64];
+    (void) snprintf(name, sizeof(name), "/pet-store-test-%d", (int) getpid());
+    for (int index = 0; index < PETS; index++) {
+        ids[index] = 1000 + index;
+        statuses[index] = AVAILABLE;
+        names[index] = "Pet";
+    }
+    TEST_ASSERT(pet_catalogue_file_write(path, ids, statuses, names, PETS));
+    TEST_ASSERT(open_pet_catalogue(path));
+    atomic_int *sales = mmap(NULL, PETS * sizeof(atomic_int), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    TEST_ASSERT(sales != MAP_FAILED);
+    (void) shm_unlink(name);
+    // The first process to open the catalogue can't grow it and gets killed
+    const pid_t creator = fork();
+    TEST_ASSERT(creator >= 0);
+    if (creator == 0) {
+        const struct rlimit limit = {.rlim_cur = 1, .rlim_max = 1};
+        _exit(setrlimit(RLIMIT_FSIZE, &limit) == 0 && open_shared_pet_catalogue(name) ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+    int creator_exit;
+    TEST_ASSERT(waitpid(creator, &creator_exit, 0) == creator);
+    char leftover[96];
+    (void) snprintf(leftover, sizeof(leftover), "%s.%d.0", name, (int) creator);
+    const bool crashed = WIFSIGNALED(creator_exit) && shm_unlink(leftover) == 0;
+    const bool shared = open_shared_pet_catalogue(name);
+    // When
+    pid_t workers[WORKERS];
+    for (int worker = 0; worker < WORKERS; worker++) {
+        workers[worker] = fork();
+        TEST_ASSERT(workers[worker] >= 0);
+        if (workers[worker] == 0) {
+            _exit(buy_all_pets(name, worker, sales));
+        }
+    }
+    int exits[WORKERS];
+    for (int worker = 0; worker < WORKERS; worker++) {
+        TEST_ASSERT(waitpid(workers[worker], &exits[worker], 0) == workers[worker]);
+    }
+    const OPTIONAL(Pet) created = new_pet(5000, "Rocky", AVAILABLE);
+    // Then
+    TEST_ASSERT(crashed);
+    TEST_ASSERT(shared);
+    TEST_ASSERT(WIFSIGNALED(exits[0]));
+    for (int worker = 1; worker < WORKERS; worker++) {
+        TEST_ASSERT(WIFEXITED(exits[worker]) && WEXITSTATUS(exits[worker]) == EXIT_SUCCESS);
+    }
+    for (int index = 0; index < PETS; index++) {
+        const RESULT(Pet, pet_error) pet = find_pet(1000 + index);
+        TEST_ASSERT(RESULT_IS_SUCCESS(pet));
+        TEST_ASSERT(PET_STATUS(RESULT_USE_VALUE(pet)) == SOLD);
+        TEST_ASSERT_INT_EQUALS(atomic_load(&sales[index]), 1);
+    }
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(created));
+    TEST_ASSERT(shm_unlink(name) == 0);
+    TEST_ASSERT(remove(path) == 0);
+    TEST_PASS;
+}
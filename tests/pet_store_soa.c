@@ -0,0 +1,62 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <optional.h>
+#include <status-bitmap.h>
+#include "test.h"
+
+/**
+ * Tests the pet store in struct-of-arrays mode.
+ */
+int main() {
+    // Given
+    const OPTIONAL(Pet) snoopy = new_pet(1000, "Snoopy", AVAILABLE);
+    const OPTIONAL(Pet) odie = new_pet(2000, "Odie", PENDING);
+    const OPTIONAL(Pet) impostor = new_pet(0, "Rocky", AVAILABLE);
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(snoopy));
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(odie));
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(impostor));
+    // When
+    const RESULT(Pet, pet_error) rocky = find_pet(0);
+    const OPTIONAL(Pet) added = add_pet(OPTIONAL_USE_VALUE(snoopy));
+    const OPTIONAL(Pet) duplicate = add_pet(OPTIONAL_USE_VALUE(impostor));
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(add_pet(OPTIONAL_USE_VALUE(odie))));
+    const RESULT(Pet, pet_error) found = find_pet(1000);
+    const RESULT(Pet, pet_error) bought = buy_pet(RESULT_USE_VALUE(found));
+    const RESULT(Pet, pet_error) bought_again = buy_pet(RESULT_USE_VALUE(found));
+    const RESULT(Pet, pet_error) pending = buy_pet(OPTIONAL_USE_VALUE(odie));
+    struct status_bitmap_iterator available = find_pets_by_status(PET_STATUS_MASK(AVAILABLE), 0);
+    // Then
+    TEST_ASSERT(RESULT_IS_SUCCESS(rocky));
+    TEST_ASSERT_INT_EQUALS(PET_ID(RESULT_USE_VALUE(rocky)), 0);
+    TEST_ASSERT_STR_EQUALS(PET_NAME(RESULT_USE_VALUE(rocky)), "Rocky");
+    TEST_ASSERT(PET_NAME(OPTIONAL_USE_VALUE(impostor)) == PET_NAME(RESULT_USE_VALUE(rocky)));
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(added));
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(duplicate));
+    TEST_ASSERT(RESULT_IS_SUCCESS(found));
+    TEST_ASSERT(RESULT_USE_VALUE(found) == OPTIONAL_USE_VALUE(snoopy));
+    TEST_ASSERT_STR_EQUALS(PET_NAME(RESULT_USE_VALUE(found)), "Snoopy");
+    TEST_ASSERT(RESULT_IS_SUCCESS(bought));
+    TEST_ASSERT_INT_EQUALS(RESULT_USE_ERROR(bought_again), PET_ALREADY_SOLD);
+    TEST_ASSERT_INT_EQUALS(RESULT_USE_ERROR(pending), PET_NOT_AVAILABLE);
+    TEST_ASSERT(PET_STATUS(RESULT_USE_VALUE(found)) == SOLD);
+    const OPTIONAL(Pet) first = status_bitmap_next(&available);
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(first));
+    TEST_ASSERT_STR_EQUALS(PET_NAME(OPTIONAL_USE_VALUE(first)), "Rocky");
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(status_bitmap_next(&available)));
+    TEST_PASS;
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <optional.h>
+#include <result.h>
+#include "test.h"
+
+typedef enum parse_error {PARSED, NO_DIGITS, TOO_LONG} parse_error;
+
+typedef char *string;
+
+OPTIONAL_STRUCT(int);
+OPTIONAL_STRUCT(string);
+RESULT_STRUCT(int, parse_error);
+RESULT_STRUCT(string, parse_error);
+
+static int last_value = 0;
+static parse_error last_error = PARSED;
+
+static int twice(int value) {
+    return value * 2;
+}
+
+static RESULT(int, parse_error) below_ten(int value) {
+    if (value >= 10) {
+        return (RESULT(int, parse_error)) RESULT_FAILURE(TOO_LONG);
+    }
+    return (RESULT(int, parse_error)) RESULT_SUCCESS(value);
+}
+
+static void set_last_value(int value) {
+    last_value = value;
+}
+
+static void set_last_error(parse_error error) {
+    last_error = error;
+}
+
+/**
+ * Tests `RESULT` macros and conversions from and to Optionals.
+ */
+int main() {
+    // Given
+    RESULT(int, parse_error) success = RESULT_SUCCESS(6);
+    RESULT(int, parse_error) failure = RESULT_FAILURE(NO_DIGITS);
+    OPTIONAL(int) present = OPTIONAL_PRESENT(7);
+    OPTIONAL(int) empty = OPTIONAL_EMPTY;
+    // When
+    RESULT(int, parse_error) mapped = RESULT_MAP(success, twice, RESULT(int, parse_error));
+    const RESULT(int, parse_error) mapped_failure = RESULT_MAP(failure, twice, RESULT(int, parse_error));
+    const RESULT(int, parse_error) flat_mapped = RESULT_FLAT_MAP(success, below_ten);
+    const RESULT(int, parse_error) too_long = RESULT_FLAT_MAP(mapped, below_ten);
+    const RESULT(int, parse_error) flat_mapped_failure = RESULT_FLAT_MAP(failure, below_ten);
+    const OPTIONAL(int) from_success = RESULT_TO_OPTIONAL(success, OPTIONAL(int));
+    const OPTIONAL(int) from_failure = RESULT_TO_OPTIONAL(failure, OPTIONAL(int));
+    const RESULT(int, parse_error) from_present = RESULT_FROM_OPTIONAL(present, NO_DIGITS, RESULT(int, parse_error));
+    const RESULT(int, parse_error) from_empty = RESULT_FROM_OPTIONAL(empty, NO_DIGITS, RESULT(int, parse_error));
+    RESULT_IF_SUCCESS_OR_ELSE(success, set_last_value, set_last_error);
+    RESULT_IF_SUCCESS_OR_ELSE(failure, set_last_value, set_last_error);
+    // Then
+    TEST_ASSERT(RESULT_IS_SUCCESS(success));
+    TEST_ASSERT(RESULT_IS_FAILURE(failure));
+    TEST_ASSERT_INT_EQUALS(RESULT_USE_ERROR(success), PARSED);
+    TEST_ASSERT_INT_EQUALS(RESULT_USE_ERROR(failure), NO_DIGITS);
+    TEST_ASSERT_INT_EQUALS(RESULT_OR_ELSE(success, -1), 6);
+    TEST_ASSERT_INT_EQUALS(RESULT_OR_ELSE(failure, -1), -1);
+    TEST_ASSERT_INT_EQUALS(RESULT_USE_VALUE(mapped), 12);
+    TEST_ASSERT_INT_EQUALS(RESULT_USE_ERROR(mapped_failure), NO_DIGITS);
+    TEST_ASSERT_INT_EQUALS(RESULT_USE_VALUE(flat_mapped), 6);
+    TEST_ASSERT_INT_EQUALS(RESULT_USE_ERROR(too_long), TOO_LONG);
+    TEST_ASSERT_INT_EQUALS(RESULT_USE_ERROR(flat_mapped_failure), NO_DIGITS);
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(from_success));
+    TEST_ASSERT_INT_EQUALS(OPTIONAL_USE_VALUE(from_success), 6);
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(from_failure));
+    TEST_ASSERT_INT_EQUALS(RESULT_USE_VALUE(from_present), 7);
+    TEST_ASSERT_INT_EQUALS(RESULT_USE_ERROR(from_empty), NO_DIGITS);
+    TEST_ASSERT_INT_EQUALS(last_value, 6);
+    TEST_ASSERT_INT_EQUALS(last_error, NO_DIGITS);
+    TEST_ASSERT(sizeof(RESULT(int, parse_error)) == sizeof(OPTIONAL(int)));
+    TEST_ASSERT(sizeof(RESULT(string, parse_error)) == sizeof(OPTIONAL(string)));
+    TEST_PASS;
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <optional.h>
+#include <sharded-pet-store.h>
+#include "test.h"
+
+#define PETS 2000
+#define READERS 4
+
+static struct sharded_pet_store store;
+static struct pet pets[PETS];
+static atomic_int added;
+static atomic_int errors;
+
+// Looks up the pets added so far while the writer keeps adding more
+static void *read_pets(void *argument) {
+    (void) argument;
+    struct epoch_reader *reader = sharded_pet_store_register(&store);
+    if (reader == NULL) {
+        atomic_fetch_add(&errors, 1);
+        return NULL;
+    }
+    for (int round = 0; atomic_load(&added) < PETS || round == 0; round++) {
+        const int count = atomic_load(&added);
+        for (int id = 0; id < count; id++) {
+            const OPTIONAL(Pet) found = sharded_pet_store_find(&store, reader, id);
+            if (OPTIONAL_IS_EMPTY(found) || OPTIONAL_USE_VALUE(found) != &pets[id]) {
+                atomic_fetch_add(&errors, 1);
+            }
+        }
+        if (OPTIONAL_IS_PRESENT(sharded_pet_store_find(&store, reader, PETS))) {
+            atomic_fetch_add(&errors, 1);
+        }
+    }
+    epoch_unregister(reader);
+    return NULL;
+}
+
+/**
+ * Tests `sharded_pet_store` with concurrent readers and a writer.
+ */
+int main() {
+    // Given
+    pthread_t readers[READERS];
+    struct pet duplicate = {.id = 0, .name = "Impostor", .status = AVAILABLE};
+    TEST_ASSERT(sharded_pet_store_init(&store));
+    // When
+    for (int index = 0; index < READERS; index++) {
+        TEST_ASSERT(pthread_create(&readers[index], NULL, read_pets, NULL) == 0);
+    }
+    for (int id = 0; id < PETS; id++) {
+        pets[id] = (struct pet) {.id = id, .name = "Pet", .status = AVAILABLE};
+        TEST_ASSERT(OPTIONAL_IS_PRESENT(sharded_pet_store_add(&store, &pets[id])));
+        atomic_store(&added, id + 1);
+    }
+    for (int index = 0; index < READERS; index++) {
+        TEST_ASSERT(pthread_join(readers[index], NULL) == 0);
+    }
+    const OPTIONAL(Pet) rejected = sharded_pet_store_add(&store, &duplicate);
+    // Then
+    TEST_ASSERT_INT_EQUALS(atomic_load(&errors), 0);
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(rejected));
+    sharded_pet_store_free(&store);
+    TEST_PASS;
+}
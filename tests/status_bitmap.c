@@ -0,0 +1,66 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <optional.h>
+#include <status-bitmap.h>
+#include "test.h"
+
+#define PETS 200
+
+/**
+ * Tests `status_bitmap`.
+ */
+int main() {
+    // Given
+    struct status_bitmap bitmap = {0};
+    struct pet pets[PETS];
+    for (int index = 0; index < PETS; index++) {
+        pets[index] = (struct pet) {.id = index, .name = "Pet", .status = index % 3};
+        TEST_ASSERT(status_bitmap_append(&bitmap, &pets[index]) == (size_t) index);
+    }
+    // When
+    status_bitmap_move(&bitmap, 63, AVAILABLE, SOLD);
+    status_bitmap_move(&bitmap, 64, PENDING, SOLD);
+    status_bitmap_set(&bitmap, 66, SOLD);
+    struct status_bitmap_iterator available = status_bitmap_query(&bitmap, PET_STATUS_MASK(AVAILABLE), 0);
+    struct status_bitmap_iterator unsold = status_bitmap_query(&bitmap, PET_STATUS_MASK(AVAILABLE) | PET_STATUS_MASK(PENDING), 0);
+    struct status_bitmap_iterator both = status_bitmap_query(&bitmap, 0, PET_STATUS_MASK(AVAILABLE) | PET_STATUS_MASK(SOLD));
+    struct status_bitmap_iterator all = status_bitmap_query(&bitmap, 0, 0);
+    // Then
+    int count = 0;
+    for (OPTIONAL(Pet) pet = status_bitmap_next(&available); OPTIONAL_IS_PRESENT(pet); pet = status_bitmap_next(&available)) {
+        TEST_ASSERT(PET_STATUS(OPTIONAL_USE_VALUE(pet)) == AVAILABLE);
+        TEST_ASSERT(PET_ID(OPTIONAL_USE_VALUE(pet)) != 63);
+        TEST_ASSERT(PET_ID(OPTIONAL_USE_VALUE(pet)) != 66);
+        count++;
+    }
+    TEST_ASSERT_INT_EQUALS(count, 65);
+    int previous = -1;
+    for (OPTIONAL(Pet) pet = status_bitmap_next(&unsold); OPTIONAL_IS_PRESENT(pet); pet = status_bitmap_next(&unsold)) {
+        TEST_ASSERT(PET_STATUS(OPTIONAL_USE_VALUE(pet)) != SOLD);
+        TEST_ASSERT(PET_ID(OPTIONAL_USE_VALUE(pet)) > previous);
+        previous = PET_ID(OPTIONAL_USE_VALUE(pet));
+    }
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(status_bitmap_next(&both)));
+    count = 0;
+    while (OPTIONAL_IS_PRESENT(status_bitmap_next(&all))) {
+        count++;
+    }
+    TEST_ASSERT_INT_EQUALS(count, PETS);
+    status_bitmap_free(&bitmap);
+    TEST_PASS;
+}
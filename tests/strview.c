@@ -0,0 +1,79 @@
+/*
+ * Copyright 2025 Guillermo Calvo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <optional.h>
+#include <optional-parse.h>
+#include <strview.h>
+#include "test.h"
+
+#define VIEW(text) strview_of(text)
+
+/**
+ * Tests `strview` searches, splitting and key-value parsing.
+ */
+int main() {
+    // Given
+    const char line[] = "name = Snoopy ;; age=7;  =orphan;status:SOLD";
+    struct strview_splitter splitter = strview_split(VIEW(line), ';');
+    strview tokens[8];
+    int count = 0;
+    // When
+    for (OPTIONAL(strview) token = strview_split_next(&splitter); OPTIONAL_IS_PRESENT(token); token = strview_split_next(&splitter)) {
+        tokens[count++] = OPTIONAL_USE_VALUE(token);
+    }
+    const OPTIONAL(strview) exhausted = strview_split_next(&splitter);
+    const OPTIONAL(strview_key_value) name = strview_parse_key_value(tokens[0], '=');
+    const OPTIONAL(strview_key_value) nothing = strview_parse_key_value(tokens[1], '=');
+    const OPTIONAL(strview_key_value) age = strview_parse_key_value(tokens[2], '=');
+    const strview years = OPTIONAL_USE_VALUE(age).value;
+    const OPTIONAL(int) parsed_years = optional_parse_int(years.data, years.length);
+    const OPTIONAL(strview_key_value) orphan = strview_parse_key_value(tokens[3], '=');
+    const OPTIONAL(strview) colon = strview_find_char(tokens[4], ':');
+    const OPTIONAL(strview) missing = strview_find_char(VIEW(line), '#');
+    const OPTIONAL(strview) substr = strview_find_substr(VIEW(line), VIEW("Snoopy"));
+    const OPTIONAL(strview) repeated = strview_find_substr(VIEW("aaab"), VIEW("aab"));
+    const OPTIONAL(strview) longer = strview_find_substr(VIEW("ab"), VIEW("abc"));
+    struct strview_splitter empty_splitter = strview_split(VIEW(""), ',');
+    const OPTIONAL(strview) empty_token = strview_split_next(&empty_splitter);
+    const OPTIONAL(strview) empty_exhausted = strview_split_next(&empty_splitter);
+    // Then
+    TEST_ASSERT_INT_EQUALS(count, 5);
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(exhausted));
+    TEST_ASSERT(tokens[0].data == line);
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(name));
+    TEST_ASSERT(strview_equals(OPTIONAL_USE_VALUE(name).key, VIEW("name")));
+    TEST_ASSERT(strview_equals(OPTIONAL_USE_VALUE(name).value, VIEW("Snoopy")));
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(nothing));
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(age));
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(parsed_years));
+    TEST_ASSERT_INT_EQUALS(OPTIONAL_USE_VALUE(parsed_years), 7);
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(orphan));
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(colon));
+    TEST_ASSERT(strview_equals(OPTIONAL_USE_VALUE(colon), VIEW(":SOLD")));
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(missing));
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(substr));
+    TEST_ASSERT(OPTIONAL_USE_VALUE(substr).data == line + 7);
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(repeated));
+    TEST_ASSERT(strview_equals(OPTIONAL_USE_VALUE(repeated), VIEW("aab")));
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(longer));
+    TEST_ASSERT(OPTIONAL_IS_PRESENT(empty_token));
+    TEST_ASSERT_INT_EQUALS((int) OPTIONAL_USE_VALUE(empty_token).length, 0);
+    TEST_ASSERT(OPTIONAL_IS_EMPTY(empty_exhausted));
+    TEST_ASSERT(strview_equals(strview_trim(VIEW(" \t x y \n")), VIEW("x y")));
+    TEST_ASSERT_INT_EQUALS((int) strview_trim(VIEW("   ")).length, 0);
+    TEST_PASS;
+}